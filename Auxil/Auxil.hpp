@@ -1,12 +1,16 @@
 #ifndef AUXIL_HPP
 #define AUXIL_HPP
 
+#include "batch.hpp"
 #include "containers.hpp"
 #include "exception.hpp"
 #include "globals.hpp"
 #include "iterator.hpp"
+#include "log.hpp"
 #include "math.hpp"
+#include "memory.hpp"
 #include "misc.hpp"
+#include "parallel.hpp"
 #include "print.hpp"
 #include "random.hpp"
 #include "str.hpp"
@@ -0,0 +1,605 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+#include <array>
+
+#include "containers.hpp"
+#include "math.hpp"
+#include "parallel.hpp"
+#include "threading.hpp"
+
+namespace Auxil {
+    using namespace Primitives;
+
+    //describes how an element type is split into component arrays, the order is the order of the struct's members
+    template<typename E>
+    struct BatchTraits;
+
+    template<std::floating_point T>
+    struct BatchTraits<v2<T>> {
+        using value_type = T;
+        static constexpr std::array members{&v2<T>::x, &v2<T>::y};
+        static constexpr usize x = 0, y = 1;
+    };
+
+    template<std::floating_point T>
+    struct BatchTraits<v3<T>> {
+        using value_type = T;
+        static constexpr std::array members{&v3<T>::x, &v3<T>::y, &v3<T>::z};
+        static constexpr usize x = 0, y = 1, z = 2;
+    };
+
+    template<std::floating_point T>
+    struct BatchTraits<Quaternion<T>> {
+        using value_type = T;
+        static constexpr std::array members{&Quaternion<T>::w, &Quaternion<T>::x, &Quaternion<T>::y, &Quaternion<T>::z};
+        static constexpr usize w = 0, x = 1, y = 2, z = 3;
+    };
+
+    /*
+     * A structure of arrays, every component of the elements is stored in its own Array so that the batch functions
+     * below can load several elements worth of one component into a single vector register
+     * The component arrays are ordinary Arrays, so they can be passed to anything else that takes one
+     */
+    template<typename E>
+    class Batch {
+    public:
+        using traits = BatchTraits<E>;
+        using value_type = typename traits::value_type;
+        using element_type = E;
+        static constexpr usize components = traits::members.size();
+
+    private:
+        std::array<Array<value_type>, components> _components;
+        usize _size{0};
+
+    public:
+        Batch() = default;
+
+        explicit Batch(const usize size) : _size(size) {
+            for (auto& c: _components) c = Array<value_type>(size);
+        }
+
+        //splits an Array (or any other Iterable) of elements into their components
+        template<Iterable I>
+        requires std::convertible_to<iterable_value_t<I>, E>
+        explicit Batch(const I& elements) : Batch(static_cast<usize>(elements.size())) {
+            usize i = 0;
+            for (const E& e: elements) set(i++, e);
+        }
+
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return _size;
+        }
+
+        [[nodiscard]] FORCE_INLINE bool empty() const {
+            return _size == 0;
+        }
+
+        //discards the current elements if the size changes
+        void resize(const usize size) {
+            if (size == _size) return;
+            *this = Batch(size);
+        }
+
+        template<usize C>
+        FORCE_INLINE Array<value_type>& component() {
+            return _components[C];
+        }
+
+        template<usize C>
+        FORCE_INLINE const Array<value_type>& component() const {
+            return _components[C];
+        }
+
+        FORCE_INLINE Array<value_type>& component(const usize c) {
+            return _components[c];
+        }
+
+        FORCE_INLINE const Array<value_type>& component(const usize c) const {
+            return _components[c];
+        }
+
+        FORCE_INLINE Array<value_type>& x() { return component<traits::x>(); }
+        FORCE_INLINE Array<value_type>& y() { return component<traits::y>(); }
+        FORCE_INLINE Array<value_type>& z() requires requires { traits::z; } { return component<traits::z>(); }
+        FORCE_INLINE Array<value_type>& w() requires requires { traits::w; } { return component<traits::w>(); }
+
+        FORCE_INLINE const Array<value_type>& x() const { return component<traits::x>(); }
+        FORCE_INLINE const Array<value_type>& y() const { return component<traits::y>(); }
+        FORCE_INLINE const Array<value_type>& z() const requires requires { traits::z; } { return component<traits::z>(); }
+        FORCE_INLINE const Array<value_type>& w() const requires requires { traits::w; } { return component<traits::w>(); }
+
+        [[nodiscard]] E get(const usize ind) const {
+            if (ind >= _size) throw Exception("{} out of range of a batch with {} elements", ind, _size);
+            E res{};
+            for (usize c = 0; c < components; c++) res.*traits::members[c] = _components[c].data()[ind];
+            return res;
+        }
+
+        void set(const usize ind, const E& value) {
+            if (ind >= _size) throw Exception("{} out of range of a batch with {} elements", ind, _size);
+            for (usize c = 0; c < components; c++) _components[c].data()[ind] = value.*traits::members[c];
+        }
+
+        //joins the components back into an Array of elements
+        [[nodiscard]] Array<E> to_array() const {
+            Array<E> res(_size);
+            for (usize i = 0; i < _size; i++) res[i] = get(i);
+            return res;
+        }
+    };
+
+    template<std::floating_point T>
+    using v2_batch = Batch<v2<T>>;
+
+    template<std::floating_point T>
+    using v3_batch = Batch<v3<T>>;
+
+    template<std::floating_point T>
+    using quat_batch = Batch<Quaternion<T>>;
+
+    namespace BatchDetail {
+        //below this many elements a batch isn't worth splitting over an Executor
+        constexpr usize parallel_threshold = 16384;
+
+        //V is either T for the scalar tail or Simd::Vec<T> for the main loop, so every kernel is written once
+        template<typename V, typename T>
+        FORCE_INLINE V load(const T* p) {
+            if constexpr (std::is_same_v<V, T>) return *p;
+            else return Simd::load(p);
+        }
+
+        template<typename V, typename T>
+        FORCE_INLINE void store(T* p, const V& v) {
+            if constexpr (std::is_same_v<V, T>) *p = v;
+            else Simd::store(p, v);
+        }
+
+        template<typename T, typename V>
+        FORCE_INLINE V sqrt(const V& v) {
+            if constexpr (std::is_same_v<V, T>) return std::sqrt(v);
+            else return Simd::sqrt<T>(v);
+        }
+
+        //scales v by 1/sqrt(length2) in the lanes where length2 is above epsilon, the other lanes are unchanged
+        template<typename T, typename V>
+        FORCE_INLINE V inverse_length(const V& length2) {
+            const V inv = 1 / sqrt<T>(length2);
+            if constexpr (std::is_same_v<V, T>) return length2 > epsilon<T> ? inv : T(1);
+            else return length2 > epsilon<T> ? inv : Simd::broadcast<T>(1);
+        }
+
+        //calls kernel.template operator()<Vec<T>>(i) for every full vector of elements in [0, n) and
+        //kernel.template operator()<T>(i) for the rest, on the Executor for large batches
+        template<typename T, typename K>
+        void run(Executor* ex, const usize n, K&& kernel) {
+            constexpr usize w = Simd::lanes<T>;
+            auto range = [&](const usize b, const usize e) {
+                usize i = b;
+                for (; i + w <= e; i += w) kernel.template operator()<Simd::Vec<T>>(i);
+                for (; i < e; i++) kernel.template operator()<T>(i);
+            };
+
+            if (ex == nullptr || ex->size() == 0 || n < parallel_threshold) {
+                range(0, n);
+                return;
+            }
+
+            usize grain = std::max(resolve_grain(*ex, n, 0), parallel_threshold / 4);
+            grain = (grain + w - 1) / w * w;
+            parallel_for_chunks(*ex, n, grain, [&](usize, const usize b, const usize e) {
+                range(b, e);
+            });
+        }
+
+        inline void require_same_size(const usize left, const usize right) {
+            if (left != right) {
+                throw Exception("Cannot combine batches of different sizes ({} and {} elements)", left, right);
+            }
+        }
+
+        template<typename E>
+        void add(Executor* ex, const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+            using T = typename Batch<E>::value_type;
+            require_same_size(a.size(), b.size());
+            out.resize(a.size());
+
+            for (usize c = 0; c < Batch<E>::components; c++) {
+                const T* pa = a.component(c).data();
+                const T* pb = b.component(c).data();
+                T* po = out.component(c).data();
+                run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                    store<V>(po + i, load<V>(pa + i) + load<V>(pb + i));
+                });
+            }
+        }
+
+        template<typename E>
+        void sub(Executor* ex, const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+            using T = typename Batch<E>::value_type;
+            require_same_size(a.size(), b.size());
+            out.resize(a.size());
+
+            for (usize c = 0; c < Batch<E>::components; c++) {
+                const T* pa = a.component(c).data();
+                const T* pb = b.component(c).data();
+                T* po = out.component(c).data();
+                run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                    store<V>(po + i, load<V>(pa + i) - load<V>(pb + i));
+                });
+            }
+        }
+
+        template<typename E>
+        void scale(Executor* ex, const Batch<E>& a, const typename Batch<E>::value_type s, Batch<E>& out) {
+            using T = typename Batch<E>::value_type;
+            out.resize(a.size());
+
+            for (usize c = 0; c < Batch<E>::components; c++) {
+                const T* pa = a.component(c).data();
+                T* po = out.component(c).data();
+                run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                    store<V>(po + i, load<V>(pa + i) * s);
+                });
+            }
+        }
+
+        template<typename E>
+        void lerp(Executor* ex, const Batch<E>& a, const Batch<E>& b, const typename Batch<E>::value_type t,
+                  Batch<E>& out) {
+            using T = typename Batch<E>::value_type;
+            require_same_size(a.size(), b.size());
+            out.resize(a.size());
+
+            for (usize c = 0; c < Batch<E>::components; c++) {
+                const T* pa = a.component(c).data();
+                const T* pb = b.component(c).data();
+                T* po = out.component(c).data();
+                run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                    const V va = load<V>(pa + i);
+                    store<V>(po + i, va + (load<V>(pb + i) - va) * t);
+                });
+            }
+        }
+
+        template<typename E>
+        void dot(Executor* ex, const Batch<E>& a, const Batch<E>& b, Array<typename Batch<E>::value_type>& out) {
+            using T = typename Batch<E>::value_type;
+            constexpr usize N = Batch<E>::components;
+            require_same_size(a.size(), b.size());
+            if (out.size() != a.size()) out = Array<T>(a.size());
+
+            T* po = out.data();
+            run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                V acc = load<V>(a.component(0).data() + i) * load<V>(b.component(0).data() + i);
+                for (usize c = 1; c < N; c++) {
+                    acc += load<V>(a.component(c).data() + i) * load<V>(b.component(c).data() + i);
+                }
+                store<V>(po + i, acc);
+            });
+        }
+
+        template<typename E>
+        void normalize(Executor* ex, Batch<E>& a) {
+            using T = typename Batch<E>::value_type;
+            constexpr usize N = Batch<E>::components;
+
+            std::array<T*, N> p;
+            for (usize c = 0; c < N; c++) p[c] = a.component(c).data();
+            run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                V v[N];
+                V length2 = V{};
+                for (usize c = 0; c < N; c++) {
+                    v[c] = load<V>(p[c] + i);
+                    length2 += v[c] * v[c];
+                }
+                const V inv = inverse_length<T>(length2);
+                for (usize c = 0; c < N; c++) store<V>(p[c] + i, v[c] * inv);
+            });
+        }
+
+        template<std::floating_point T>
+        void cross(Executor* ex, const v3_batch<T>& a, const v3_batch<T>& b, v3_batch<T>& out) {
+            require_same_size(a.size(), b.size());
+            out.resize(a.size());
+
+            const T *ax = a.x().data(), *ay = a.y().data(), *az = a.z().data();
+            const T *bx = b.x().data(), *by = b.y().data(), *bz = b.z().data();
+            T *ox = out.x().data(), *oy = out.y().data(), *oz = out.z().data();
+            run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                const V x1 = load<V>(ax + i), y1 = load<V>(ay + i), z1 = load<V>(az + i);
+                const V x2 = load<V>(bx + i), y2 = load<V>(by + i), z2 = load<V>(bz + i);
+                store<V>(ox + i, y1*z2 - z1*y2);
+                store<V>(oy + i, z1*x2 - x1*z2);
+                store<V>(oz + i, x1*y2 - y1*x2);
+            });
+        }
+
+        //v' = q v q*, expanded to v + w*t + cross(q.xyz, t) with t = 2*cross(q.xyz, v), so it's two cross products
+        //instead of two quaternion products
+        template<typename V>
+        FORCE_INLINE void rotate(V& x, V& y, V& z, const V& qw, const V& qx, const V& qy, const V& qz) {
+            const V tx = 2*(qy*z - qz*y);
+            const V ty = 2*(qz*x - qx*z);
+            const V tz = 2*(qx*y - qy*x);
+            x += qw*tx + (qy*tz - qz*ty);
+            y += qw*ty + (qz*tx - qx*tz);
+            z += qw*tz + (qx*ty - qy*tx);
+        }
+
+        template<std::floating_point T>
+        void rotate(Executor* ex, v3_batch<T>& v, const quat_batch<T>& q) {
+            require_same_size(v.size(), q.size());
+
+            T *px = v.x().data(), *py = v.y().data(), *pz = v.z().data();
+            const T *qw = q.w().data(), *qx = q.x().data(), *qy = q.y().data(), *qz = q.z().data();
+            run<T>(ex, v.size(), [&]<typename V>(const usize i) {
+                V x = load<V>(px + i), y = load<V>(py + i), z = load<V>(pz + i);
+                rotate<V>(x, y, z, load<V>(qw + i), load<V>(qx + i), load<V>(qy + i), load<V>(qz + i));
+                store<V>(px + i, x);
+                store<V>(py + i, y);
+                store<V>(pz + i, z);
+            });
+        }
+
+        template<std::floating_point T>
+        void rotate(Executor* ex, v3_batch<T>& v, const Quaternion<T>& q) {
+            T *px = v.x().data(), *py = v.y().data(), *pz = v.z().data();
+            run<T>(ex, v.size(), [&]<typename V>(const usize i) {
+                V x = load<V>(px + i), y = load<V>(py + i), z = load<V>(pz + i);
+                rotate<V>(x, y, z, V{} + q.w, V{} + q.x, V{} + q.y, V{} + q.z);
+                store<V>(px + i, x);
+                store<V>(py + i, y);
+                store<V>(pz + i, z);
+            });
+        }
+
+        template<std::floating_point T>
+        void sincos(Executor* ex, const Array<T>& angles, Array<T>& sin, Array<T>& cos) {
+            const usize n = angles.size();
+            if (sin.size() != n) sin = Array<T>(n);
+            if (cos.size() != n) cos = Array<T>(n);
+
+            const T* pa = angles.data();
+            T *ps = sin.data(), *pc = cos.data();
+            run<T>(ex, n, [&]<typename V>(const usize i) {
+#ifdef AUXIL_FAST_TRIG
+                V s, c;
+                TrigDetail::sincos_kernel<T>(load<V>(pa + i), s, c);
+                store<V>(ps + i, s);
+                store<V>(pc + i, c);
+#else
+                constexpr usize w = std::is_same_v<V, T> ? 1 : Simd::lanes<T>;
+                for (usize l = 0; l < w; l++) {
+                    ps[i + l] = std::sin(pa[i + l]);
+                    pc[i + l] = std::cos(pa[i + l]);
+                }
+#endif
+            });
+        }
+
+        template<std::floating_point T>
+        void rotate(Executor* ex, v2_batch<T>& v, const Array<T>& angles) {
+            require_same_size(v.size(), angles.size());
+
+            T *px = v.x().data(), *py = v.y().data();
+            const T* pa = angles.data();
+            run<T>(ex, v.size(), [&]<typename V>(const usize i) {
+                V s, c;
+#ifdef AUXIL_FAST_TRIG
+                TrigDetail::sincos_kernel<T>(load<V>(pa + i), s, c);
+#else
+                if constexpr (std::is_same_v<V, T>) {
+                    s = std::sin(pa[i]);
+                    c = std::cos(pa[i]);
+                } else {
+                    for (usize l = 0; l < Simd::lanes<T>; l++) {
+                        s[l] = std::sin(pa[i + l]);
+                        c[l] = std::cos(pa[i + l]);
+                    }
+                }
+#endif
+                const V x = load<V>(px + i), y = load<V>(py + i);
+                store<V>(px + i, x*c - y*s);
+                store<V>(py + i, x*s + y*c);
+            });
+        }
+
+        //the same result as Quaternion::slerp for every element, the acos/sin/cos run once per lane and everything
+        //else runs on whole vectors, the lanes close enough for a lerp take that path like the scalar version does
+        template<std::floating_point T>
+        void slerp(Executor* ex, const quat_batch<T>& a, const quat_batch<T>& b, const T t, quat_batch<T>& out) {
+            constexpr T dot_threshold = T(0.9995);
+            require_same_size(a.size(), b.size());
+            out.resize(a.size());
+
+            std::array<const T*, 4> pa, pb;
+            std::array<T*, 4> po;
+            for (usize c = 0; c < 4; c++) {
+                pa[c] = a.component(c).data();
+                pb[c] = b.component(c).data();
+                po[c] = out.component(c).data();
+            }
+
+            run<T>(ex, a.size(), [&]<typename V>(const usize i) {
+                V va[4], vb[4];
+                V d = V{};
+                for (usize c = 0; c < 4; c++) {
+                    va[c] = load<V>(pa[c] + i);
+                    vb[c] = load<V>(pb[c] + i);
+                    d += va[c] * vb[c];
+                }
+
+                V sin_theta, cos_theta, near;
+                if constexpr (std::is_same_v<V, T>) {
+                    const T theta = std::acos(std::clamp(d, T(-1), T(1))) * t;
+                    sin_theta = std::sin(theta);
+                    cos_theta = std::cos(theta);
+                    near = std::abs(d) > dot_threshold;
+                } else {
+                    for (usize l = 0; l < Simd::lanes<T>; l++) {
+                        const T theta = std::acos(std::clamp(d[l], T(-1), T(1))) * t;
+                        sin_theta[l] = std::sin(theta);
+                        cos_theta[l] = std::cos(theta);
+                        near[l] = std::abs(d[l]) > dot_threshold;
+                    }
+                }
+
+                V lerped[4], relative[4];
+                V lerped_length2 = V{}, relative_length2 = V{};
+                for (usize c = 0; c < 4; c++) {
+                    lerped[c] = va[c] + (vb[c] - va[c]) * t;
+                    relative[c] = vb[c] - va[c] * d;
+                    lerped_length2 += lerped[c] * lerped[c];
+                    relative_length2 += relative[c] * relative[c];
+                }
+
+                const V lerped_inv = inverse_length<T>(lerped_length2);
+                const V relative_inv = inverse_length<T>(relative_length2);
+                for (usize c = 0; c < 4; c++) {
+                    const V slerped = va[c] * cos_theta + relative[c] * relative_inv * sin_theta;
+                    store<V>(po[c] + i, near != 0 ? lerped[c] * lerped_inv : slerped);
+                }
+            });
+        }
+    }
+
+    //out = a + b, out is resized to match, it may be a or b
+    template<typename E>
+    void add(const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+        BatchDetail::add(nullptr, a, b, out);
+    }
+
+    template<typename E>
+    void add(Executor& ex, const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+        BatchDetail::add(&ex, a, b, out);
+    }
+
+    //out = a - b
+    template<typename E>
+    void sub(const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+        BatchDetail::sub(nullptr, a, b, out);
+    }
+
+    template<typename E>
+    void sub(Executor& ex, const Batch<E>& a, const Batch<E>& b, Batch<E>& out) {
+        BatchDetail::sub(&ex, a, b, out);
+    }
+
+    //out = a * s
+    template<typename E>
+    void scale(const Batch<E>& a, const std::type_identity_t<typename Batch<E>::value_type> s, Batch<E>& out) {
+        BatchDetail::scale(nullptr, a, s, out);
+    }
+
+    template<typename E>
+    void scale(Executor& ex, const Batch<E>& a, const std::type_identity_t<typename Batch<E>::value_type> s,
+               Batch<E>& out) {
+        BatchDetail::scale(&ex, a, s, out);
+    }
+
+    //out = a + (b - a) * t
+    template<typename E>
+    void lerp(const Batch<E>& a, const Batch<E>& b, const std::type_identity_t<typename Batch<E>::value_type> t,
+              Batch<E>& out) {
+        BatchDetail::lerp(nullptr, a, b, t, out);
+    }
+
+    template<typename E>
+    void lerp(Executor& ex, const Batch<E>& a, const Batch<E>& b,
+              const std::type_identity_t<typename Batch<E>::value_type> t, Batch<E>& out) {
+        BatchDetail::lerp(&ex, a, b, t, out);
+    }
+
+    //out[i] = a[i].dot(b[i]), out is resized to match
+    template<typename E>
+    void dot(const Batch<E>& a, const Batch<E>& b, Array<typename Batch<E>::value_type>& out) {
+        BatchDetail::dot(nullptr, a, b, out);
+    }
+
+    template<typename E>
+    void dot(Executor& ex, const Batch<E>& a, const Batch<E>& b, Array<typename Batch<E>::value_type>& out) {
+        BatchDetail::dot(&ex, a, b, out);
+    }
+
+    //normalizes every element in place, elements with a squared length under epsilon are left as they are
+    template<typename E>
+    void normalize(Batch<E>& a) {
+        BatchDetail::normalize(nullptr, a);
+    }
+
+    template<typename E>
+    void normalize(Executor& ex, Batch<E>& a) {
+        BatchDetail::normalize(&ex, a);
+    }
+
+    //out = a x b, out may be a or b
+    template<std::floating_point T>
+    void cross(const v3_batch<T>& a, const v3_batch<T>& b, v3_batch<T>& out) {
+        BatchDetail::cross(nullptr, a, b, out);
+    }
+
+    template<std::floating_point T>
+    void cross(Executor& ex, const v3_batch<T>& a, const v3_batch<T>& b, v3_batch<T>& out) {
+        BatchDetail::cross(&ex, a, b, out);
+    }
+
+    //rotates every vector by the (unit) quaternion with the same index, the same as v3::rotate(q)
+    template<std::floating_point T>
+    void rotate(v3_batch<T>& v, const quat_batch<T>& q) {
+        BatchDetail::rotate(nullptr, v, q);
+    }
+
+    template<std::floating_point T>
+    void rotate(Executor& ex, v3_batch<T>& v, const quat_batch<T>& q) {
+        BatchDetail::rotate(&ex, v, q);
+    }
+
+    //rotates every vector by the same (unit) quaternion
+    template<std::floating_point T>
+    void rotate(v3_batch<T>& v, const std::type_identity_t<Quaternion<T>>& q) {
+        BatchDetail::rotate(nullptr, v, q);
+    }
+
+    template<std::floating_point T>
+    void rotate(Executor& ex, v3_batch<T>& v, const std::type_identity_t<Quaternion<T>>& q) {
+        BatchDetail::rotate(&ex, v, q);
+    }
+
+    //sin[i] and cos[i] of every angle (in radians), with the vectorized fast_sincos kernel when AUXIL_FAST_TRIG is
+    //defined and std::sin/std::cos otherwise, sin and cos are resized to match
+    template<std::floating_point T>
+    void sincos(const Array<T>& angles, Array<T>& sin, Array<T>& cos) {
+        BatchDetail::sincos(nullptr, angles, sin, cos);
+    }
+
+    template<std::floating_point T>
+    void sincos(Executor& ex, const Array<T>& angles, Array<T>& sin, Array<T>& cos) {
+        BatchDetail::sincos(&ex, angles, sin, cos);
+    }
+
+    //rotates every vector around the origin by the angle (in radians) with the same index, the same as v2::rotate
+    template<std::floating_point T>
+    void rotate(v2_batch<T>& v, const Array<T>& angles) {
+        BatchDetail::rotate(nullptr, v, angles);
+    }
+
+    template<std::floating_point T>
+    void rotate(Executor& ex, v2_batch<T>& v, const Array<T>& angles) {
+        BatchDetail::rotate(&ex, v, angles);
+    }
+
+    //out[i] = Quaternion::slerp(a[i], b[i], t), the quaternions should be unit quaternions
+    template<std::floating_point T>
+    void slerp(const quat_batch<T>& a, const quat_batch<T>& b, const std::type_identity_t<T> t, quat_batch<T>& out) {
+        BatchDetail::slerp(nullptr, a, b, t, out);
+    }
+
+    template<std::floating_point T>
+    void slerp(Executor& ex, const quat_batch<T>& a, const quat_batch<T>& b, const std::type_identity_t<T> t,
+               quat_batch<T>& out) {
+        BatchDetail::slerp(&ex, a, b, t, out);
+    }
+}
+
+#endif //BATCH_HPP
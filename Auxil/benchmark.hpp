@@ -0,0 +1,850 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "misc.hpp"
+#include "containers.hpp"
+#include "log.hpp"
+#include "parallel.hpp"
+#include "print.hpp"
+#include "random.hpp"
+#include "str.hpp"
+#include "threading.hpp"
+//the serializer and loopback benchmarks need boost.asio, like networking.hpp itself they are opt in
+#if defined(AUXIL_BENCHMARK_NETWORKING)
+#include "networking.hpp"
+#endif
+
+namespace Auxil {
+    using namespace Primitives;
+
+    struct BenchmarkResult {
+        std::string name;
+        //how many items a single repetition processes (tasks, elements, bytes, ...)
+        u64 items{0};
+        u32 repetitions{0};
+        f64 best_seconds{0};
+        f64 mean_seconds{0};
+
+        [[nodiscard]] f64 items_per_second() const {
+            return best_seconds > 0 ? static_cast<f64>(items) / best_seconds : 0;
+        }
+
+        [[nodiscard]] f64 ns_per_item() const {
+            return items > 0 ? best_seconds * 1e9 / static_cast<f64>(items) : 0;
+        }
+    };
+
+    //stops the optimizer from throwing away a result that is never used
+    template<typename T>
+    FORCE_INLINE void do_not_optimize(const T& value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    //a small harness for timing a piece of code, each benchmark is run once to warm up and then
+    //timed over several repetitions, the best repetition is the headline number
+    class Benchmark {
+        std::vector<BenchmarkResult> _results;
+        u32 _repetitions;
+
+    public:
+        explicit Benchmark(const u32 repetitions = 5) : _repetitions(std::max<u32>(1, repetitions)) {}
+
+        template<typename F>
+        requires Invocable<F>
+        const BenchmarkResult& run(const std::string& name, const u64 items, F&& func) {
+            using clock = std::chrono::steady_clock;
+            func();
+
+            BenchmarkResult res{name, items, _repetitions, std::numeric_limits<f64>::max(), 0};
+            for (u32 i = 0; i < _repetitions; i++) {
+                const auto start = clock::now();
+                func();
+                const f64 elapsed = std::chrono::duration<f64>(clock::now() - start).count();
+
+                res.best_seconds = std::min(res.best_seconds, elapsed);
+                res.mean_seconds += elapsed;
+            }
+            res.mean_seconds /= _repetitions;
+
+            _results.push_back(std::move(res));
+            return _results.back();
+        }
+
+        [[nodiscard]] const std::vector<BenchmarkResult>& results() const {
+            return _results;
+        }
+
+        void clear() {
+            _results.clear();
+        }
+
+        //prints a human-readable table of the results
+        void report(std::ostream& os = std::cout) const {
+            usize width = 4;
+            for (auto& r: _results) width = std::max(width, r.name.size());
+
+            os << std::left << std::setw(static_cast<int>(width)) << "name"
+               << std::right << std::setw(16) << "items/s"
+               << std::setw(14) << "ns/item"
+               << std::setw(14) << "best (ms)"
+               << std::setw(14) << "mean (ms)" << "\n";
+
+            for (auto& r: _results) {
+                println(os, "{:<{}}{:>16.4g}{:>14.3f}{:>14.3f}{:>14.3f}", r.name, width,
+                    r.items_per_second(), r.ns_per_item(), r.best_seconds*1e3, r.mean_seconds*1e3);
+            }
+        }
+
+        //the results as {"benchmarks": [{...}, ...]}, one object per result with every field of BenchmarkResult
+        //and the two derived rates, for tools that track results between runs
+        void write_json(std::ostream& os) const {
+            os << "{\"benchmarks\": [";
+            for (usize i = 0; i < _results.size(); i++) {
+                const auto& r = _results[i];
+                os << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"";
+                for (const char c: r.name) {
+                    if (c == '"' || c == '\\') os << '\\' << c;
+                    else if (static_cast<unsigned char>(c) < 0x20) print(os, "\\u{:04x}", static_cast<int>(c));
+                    else os << c;
+                }
+                print(os, "\", \"items\": {}, \"repetitions\": {}, \"best_seconds\": {}, \"mean_seconds\": {}, "
+                          "\"items_per_second\": {}, \"ns_per_item\": {}}}",
+                    r.items, r.repetitions, r.best_seconds, r.mean_seconds, r.items_per_second(), r.ns_per_item());
+            }
+            os << "\n]}\n";
+        }
+
+        //the results as csv with a header row, names are quoted
+        void write_csv(std::ostream& os) const {
+            os << "name,items,repetitions,best_seconds,mean_seconds,items_per_second,ns_per_item\n";
+            for (const auto& r: _results) {
+                os << '"';
+                for (const char c: r.name) {
+                    if (c == '"') os << '"';
+                    os << c;
+                }
+                println(os, "\",{},{},{},{},{},{}", r.items, r.repetitions, r.best_seconds, r.mean_seconds,
+                    r.items_per_second(), r.ns_per_item());
+            }
+        }
+    };
+
+    namespace Benchmarks {
+        //compares execute_task (future + shared state per task) against post (no allocation for small tasks)
+        inline void executor_submission(Benchmark& bench, const u64 tasks = 1'000'000,
+                                        const u32 threads = std::thread::hardware_concurrency()) {
+            for (const auto mode: {ExecutorMode::Shared, ExecutorMode::WorkStealing}) {
+                Executor ex(threads, mode);
+                const std::string prefix = mode == ExecutorMode::Shared ? "executor/shared/" : "executor/stealing/";
+                std::atomic_uint64_t counter{0};
+
+                bench.run(prefix + "execute_task", tasks, [&] {
+                    for (u64 i = 0; i < tasks; i++) {
+                        ex.execute_task([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                    ex.wait();
+                });
+
+                bench.run(prefix + "post", tasks, [&] {
+                    for (u64 i = 0; i < tasks; i++) {
+                        ex.post([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                    ex.wait();
+                });
+
+                //tasks spawned from inside a worker stay on that worker's queue in work-stealing mode
+                bench.run(prefix + "post (nested)", tasks, [&] {
+                    const u64 per_worker = tasks / std::max<u32>(1, ex.size());
+                    for (u32 w = 0; w < ex.size(); w++) {
+                        ex.post([&ex, &counter, per_worker] {
+                            for (u64 i = 0; i < per_worker; i++) {
+                                ex.post([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+                            }
+                        });
+                    }
+                    ex.wait();
+                });
+
+                do_not_optimize(counter);
+            }
+        }
+
+        //the operations strings do constantly with short keys, run for any string type with a
+        //std::string like interface
+        template<typename S>
+        void string_operations(Benchmark& bench, const std::string& prefix, const u64 n) {
+            const char* words[] = {"id", "name", "position", "velocity", "health_points", "a much longer key that won't fit inline"};
+            std::vector<S> keys;
+            for (auto* w: words) keys.emplace_back(w);
+
+            bench.run(prefix + "construct (short)", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    S s(words[i % 5]);
+                    do_not_optimize(s);
+                }
+            });
+
+            bench.run(prefix + "copy (short)", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    S s = keys[i % 5];
+                    do_not_optimize(s);
+                }
+            });
+
+            bench.run(prefix + "copy (long)", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    S s = keys[5];
+                    do_not_optimize(s);
+                }
+            });
+
+            bench.run(prefix + "substr", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    auto s = keys[5].substr(i % 8, 10);
+                    do_not_optimize(s);
+                }
+            });
+
+            bench.run(prefix + "append chars", n, [&] {
+                S s;
+                for (u64 i = 0; i < n; i++) {
+                    if (s.size() == 12) s = S();
+                    s.push_back('a');
+                }
+                do_not_optimize(s);
+            });
+        }
+
+        //the triple loop Grid::dot used to be, kept as the reference to compare the kernel against
+        template<typename T>
+        Grid<T> naive_dot(const Grid<T>& left, const Grid<T>& right) {
+            auto result = Grid<T>::make(left.rows(), right.columns());
+            for (usize i = 0; i < left.rows(); i++) {
+                for (usize j = 0; j < right.columns(); j++) {
+                    T sum = 0;
+                    for (usize k = 0; k < left.columns(); k++) {
+                        sum += left[i][k] * right[k][j];
+                    }
+                    result[i][j] = sum;
+                }
+            }
+            return result;
+        }
+
+        //square n x n products, items are multiply-adds
+        inline void matrix(Benchmark& bench, const usize n = 512,
+                           const u32 threads = std::thread::hardware_concurrency()) {
+            Random rng;
+            auto a = Grid<f32>::make(n, n), b = Grid<f32>::make(n, n);
+            for (auto& v: a) v = rng.random<f32>(-1, 1);
+            for (auto& v: b) v = rng.random<f32>(-1, 1);
+            const u64 fmas = static_cast<u64>(n) * n * n;
+            const std::string dims = std::to_string(n) + "x" + std::to_string(n);
+
+            bench.run("matrix/naive " + dims, fmas, [&] { do_not_optimize(naive_dot(a, b)); });
+            bench.run("matrix/dot " + dims, fmas, [&] { do_not_optimize(a.dot(b)); });
+
+            Executor ex(threads);
+            bench.run("matrix/parallel_dot " + dims, fmas, [&] { do_not_optimize(parallel_dot(ex, a, b)); });
+        }
+
+        //single draws through each engine, and bulk fills of an array, reported per value
+        inline void random(Benchmark& bench, const u64 n = 10'000'000,
+                           const u32 threads = std::thread::hardware_concurrency()) {
+            auto draws = [&]<typename R>(const std::string& name, R& rng) {
+                bench.run(name + "/random<u32>(0, 99)", n, [&] {
+                    for (u64 i = 0; i < n; i++) do_not_optimize(rng.template random<u32>(0, 99));
+                });
+                bench.run(name + "/random<f32>(-1, 1)", n, [&] {
+                    for (u64 i = 0; i < n; i++) do_not_optimize(rng.template random<f32>(-1, 1));
+                });
+            };
+
+            BasicRandom<std::mt19937_64> mt;
+            Random xoshiro;
+            BasicRandom<Pcg32> pcg;
+            draws("random/mt19937_64", mt);
+            draws("random/xoshiro256", xoshiro);
+            draws("random/pcg32", pcg);
+
+            bench.run("std::mt19937_64/uniform_int_distribution", n, [&] {
+                std::mt19937_64 engine(std::random_device{}());
+                for (u64 i = 0; i < n; i++) do_not_optimize(std::uniform_int_distribution<u32>(0, 99)(engine));
+            });
+
+            Array<f32> values(n);
+            bench.run("random/fill f32 (xoshiro256)", n, [&] { xoshiro.fill(values, -1.f, 1.f); });
+            BasicRandom<Xoshiro256x4> lanes;
+            bench.run("random/fill f32 (xoshiro256x4)", n, [&] { lanes.fill(values, -1.f, 1.f); });
+            Array<u32> indices(n);
+            bench.run("random/fill u32 (xoshiro256x4)", n, [&] { lanes.fill(indices, 0u, 999u); });
+
+            bench.run("random/construct (mt19937_64 from random_device)", 1000, [&] {
+                for (u32 i = 0; i < 1000; i++) do_not_optimize(std::mt19937_64(std::random_device{}()));
+            });
+            bench.run("random/construct (Random)", 1000, [&] {
+                for (u32 i = 0; i < 1000; i++) do_not_optimize(Random());
+            });
+
+            //a value drawn for every index of a parallel loop
+            Executor ex(threads);
+            std::mutex mtx;
+            bench.run("random/parallel_for (shared Random + mutex)", n, [&] {
+                parallel_for(ex, u64{0}, n, [&](const u64 i) {
+                    std::lock_guard lock(mtx);
+                    values[i] = xoshiro.random<f32>(-1, 1);
+                });
+            });
+            bench.run("random/parallel_for (RandomStreams)", n, [&] {
+                parallel_for(ex, u64{0}, n, RandomStreams(1), [&](const u64 i, StreamRandom& rng) {
+                    values[i] = rng.random<f32>(-1, 1);
+                });
+            });
+            bench.run("random/parallel_fill f32", n, [&] { parallel_fill(ex, values, RandomStreams(1), -1.f, 1.f); });
+        }
+
+        //appending to a growing vector, and building lots of short vectors that fit Vector's inline storage
+        inline void vectors(Benchmark& bench, const u64 n = 10'000'000) {
+            bench.run("std::vector/push_back", n, [&] {
+                std::vector<u32> v;
+                for (u64 i = 0; i < n; i++) v.push_back(static_cast<u32>(i));
+                do_not_optimize(v);
+            });
+
+            bench.run("Vector/push_back", n, [&] {
+                Vector<u32> v;
+                for (u64 i = 0; i < n; i++) v.push_back(static_cast<u32>(i));
+                do_not_optimize(v);
+            });
+
+            bench.run("std::vector/10 elements", n, [&] {
+                for (u64 i = 0; i < n / 10; i++) {
+                    std::vector<u32> v;
+                    for (u32 j = 0; j < 10; j++) v.push_back(j);
+                    do_not_optimize(v);
+                }
+            });
+
+            bench.run("Vector<u32, 16>/10 elements", n, [&] {
+                for (u64 i = 0; i < n / 10; i++) {
+                    Vector<u32, 16> v;
+                    for (u32 j = 0; j < 10; j++) v.push_back(j);
+                    do_not_optimize(v);
+                }
+            });
+        }
+
+        //checked element access, and what a failed check costs, with and without turning the stacktrace into text
+        inline void bounds_checks(Benchmark& bench, const u64 n = 10'000'000) {
+            Array<u32> values(4096);
+            for (usize i = 0; i < values.size(); i++) values[i] = static_cast<u32>(i);
+
+            bench.run("array/data() (unchecked)", n, [&] {
+                u64 sum = 0;
+                for (u64 i = 0; i < n; i++) sum += values.data()[i & 4095];
+                do_not_optimize(sum);
+            });
+            bench.run("array/at", n, [&] {
+                u64 sum = 0;
+                for (u64 i = 0; i < n; i++) sum += values.at(i & 4095);
+                do_not_optimize(sum);
+            });
+            bench.run("array/try_at", n, [&] {
+                u64 sum = 0;
+                for (u64 i = 0; i < n; i++) {
+                    if (auto v = values.try_at(i & 4095)) sum += v->get();
+                }
+                do_not_optimize(sum);
+            });
+
+            const u64 throws = std::max<u64>(n / 1000, 1);
+            std::vector<u32> std_values(4096);
+            bench.run("std::vector/at (throw + catch)", throws, [&] {
+                for (u64 i = 0; i < throws; i++) {
+                    try {
+                        do_not_optimize(std_values.at(4096 + i));
+                    } catch (const std::out_of_range& e) {
+                        do_not_optimize(e.what());
+                    }
+                }
+            });
+            //only a throwing at() can be measured this way, with the other AUXIL_BOUNDS_CHECK levels it asserts or
+            //reads past the end
+#if AUXIL_BOUNDS_CHECK >= 2
+            bench.run("array/at (throw + catch)", throws, [&] {
+                for (u64 i = 0; i < throws; i++) {
+                    try {
+                        do_not_optimize(values.at(4096 + i));
+                    } catch (const Exception& e) {
+                        do_not_optimize(e.message().size());
+                    }
+                }
+            });
+            bench.run("array/at (throw + catch + what())", throws / 10, [&] {
+                for (u64 i = 0; i < throws / 10; i++) {
+                    try {
+                        do_not_optimize(values.at(4096 + i));
+                    } catch (const Exception& e) {
+                        do_not_optimize(e.what());
+                    }
+                }
+            });
+#endif
+        }
+
+        //formatted lines sent to /dev/null, by println through a stream and through a Logger, from one thread and
+        //from the workers of an executor
+        inline void logging(Benchmark& bench, const u64 n = 1'000'000,
+                            const u32 threads = std::thread::hardware_concurrency()) {
+            std::ofstream null_stream("/dev/null");
+            Logger log("/dev/null");
+
+            bench.run("print/println (ofstream)", n, [&] {
+                for (u64 i = 0; i < n; i++) println(null_stream, "line {} of {}: {}", i, n, 0.5);
+                null_stream.flush();
+            });
+            bench.run("log/println", n, [&] {
+                for (u64 i = 0; i < n; i++) log.println("line {} of {}: {}", i, n, 0.5);
+                log.flush();
+            });
+
+            Executor ex(threads);
+            std::mutex mtx;
+            bench.run("print/println (ofstream + mutex, parallel_for)", n, [&] {
+                parallel_for(ex, u64{0}, n, [&](const u64 i) {
+                    std::lock_guard lock(mtx);
+                    println(null_stream, "line {} of {}: {}", i, n, 0.5);
+                });
+                null_stream.flush();
+            });
+            bench.run("log/println (parallel_for)", n, [&] {
+                parallel_for(ex, u64{0}, n, [&](const u64 i) { log.println("line {} of {}: {}", i, n, 0.5); });
+                log.flush();
+            });
+        }
+
+        //traversal of lists built by pushing to random ends, so that list order and memory order don't match
+        inline void linked_lists(Benchmark& bench, const u64 n = 1'000'000) {
+            Random rng;
+            LinkedList<u64> list;
+            CompactLinkedList<u64> compact;
+            for (u64 i = 0; i < n; i++) {
+                if (rng.random<u32>(0, 1)) {
+                    list.push_back(i);
+                    compact.push_back(i);
+                } else {
+                    list.push_front(i);
+                    compact.push_front(i);
+                }
+            }
+
+            //churn the compact list so that its free list hands out scattered slots
+            compact.to_front();
+            for (u64 i = 0; i < n; i++) {
+                compact.advance(rng.random<u32>(0, 16));
+                if (!compact.valid()) compact.to_front();
+                compact.push_ahead(compact.pop_advance());
+            }
+
+            auto traverse = [](auto& l) {
+                u64 sum = 0;
+                for (auto v: l) sum += v;
+                do_not_optimize(sum);
+            };
+
+            //moves the cursor a few nodes at a time, inserts a node after the one it lands on and removes that one,
+            //starting over from the front at the end, the cursor stays on a node because it can't come back from
+            //running off the end of a LinkedList
+            auto churn = [&rng, n](auto& l) {
+                l.to_front();
+                for (u64 i = 0; i < n; i++) {
+                    if (!l.has_next()) l.to_front();
+                    for (u32 step = rng.random<u32>(0, 16); step > 0 && l.has_next(); step--) l.advance();
+                    l.push_ahead(i);
+                    l.pop_advance();
+                }
+            };
+
+            bench.run("linked_list/traverse", n, [&] { traverse(list); });
+            bench.run("linked_list/random insert + erase", n, [&] { churn(list); });
+            bench.run("compact_linked_list/random insert + erase", n, [&] { churn(compact); });
+            bench.run("compact_linked_list/traverse (fragmented)", n, [&] { traverse(compact); });
+            compact.compact();
+            bench.run("compact_linked_list/traverse (compacted)", n, [&] { traverse(compact); });
+            bench.run("compact_linked_list/compact", n, [&] { compact.compact(); });
+        }
+
+        //lots of short-lived scratch arrays and strings, from the default resource and from a frame arena
+        inline void arena(Benchmark& bench, const u64 n = 1'000'000) {
+            FrameArena frame;
+            const char* text = "a scratch string that is too long to be stored inline";
+
+            auto scratch = [&](std::pmr::memory_resource* resource) {
+                for (u64 i = 0; i < n; i++) {
+                    Array<f32> values(32, resource);
+                    str s(text, str::allocator_type(resource));
+                    do_not_optimize(values);
+                    do_not_optimize(s);
+                    //a frame's worth of allocations
+                    if (i % 4096 == 4095) frame.reset();
+                }
+                frame.reset();
+            };
+
+            bench.run("memory/default resource", n, [&] { scratch(std::pmr::get_default_resource()); });
+            bench.run("memory/frame arena", n, [&] { scratch(&frame); });
+        }
+
+        inline void strings(Benchmark& bench, const u64 n = 1'000'000) {
+            string_operations<str>(bench, "str/", n);
+            string_operations<std::string>(bench, "std::string/", n);
+
+            const str line = "alpha,beta,gamma,delta,epsilon,zeta,eta,theta";
+            bench.run("str/split", n / 10, [&] {
+                for (u64 i = 0; i < n / 10; i++) {
+                    auto parts = line.split(",");
+                    do_not_optimize(parts);
+                }
+            });
+            bench.run("str/split_view", n / 10, [&] {
+                for (u64 i = 0; i < n / 10; i++) {
+                    for (auto part: line.split_view(",")) do_not_optimize(part);
+                }
+            });
+
+            //searches through 64kb of text for needles near its end, reported per character scanned
+            std::string text_std;
+            for (usize i = 0; text_std.size() < 64*1024; i++) {
+                text_std += "the quick brown fox jumps over the lazy dog ";
+                text_std += std::to_string(i);
+                text_std += ' ';
+            }
+            const std::string short_needle = "lazy dog 1200", long_needle = "the quick brown fox jumps over the lazy dog 1200";
+            const str text = text_std.c_str();
+            const str::searcher long_searcher(str(long_needle.c_str()));
+            const u64 reps = std::max<u64>(n / 10000, 1);
+            const u64 scanned = reps * text.index(str(short_needle.c_str()));
+
+            bench.run("str/find (short needle)", scanned, [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text.index(str(short_needle.c_str())));
+            });
+            bench.run("std::string/find (short needle)", scanned, [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text_std.find(short_needle));
+            });
+            bench.run("str/find (long needle)", scanned, [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text.index(str(long_needle.c_str())));
+            });
+            bench.run("str/find (long needle, searcher)", scanned, [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text.index(long_searcher));
+            });
+            bench.run("std::string/find (long needle)", scanned, [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text_std.find(long_needle));
+            });
+            bench.run("str/count", reps * text.size(), [&] {
+                for (u64 i = 0; i < reps; i++) do_not_optimize(text.count("fox"));
+            });
+
+            //identifiers normalised and compared case-insensitively, reported per identifier
+            const str ids[] = {"Content-Type", "X-Request-Identifier", "ACCEPT_ENCODING", "user_agent_string_value"};
+            const str ids_upper[] = {"CONTENT-TYPE", "X-REQUEST-IDENTIFIER", "ACCEPT_ENCODING", "USER_AGENT_STRING_VALUE"};
+            bench.run("str/lower", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    str s = ids[i % 4];
+                    do_not_optimize(s.lower());
+                }
+            });
+            bench.run("str/compare_ignore_case", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(ids[i % 4].compare_ignore_case(ids_upper[i % 4]));
+            });
+            bench.run("str/hash_ignore_case", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(ids[i % 4].hash_ignore_case());
+            });
+            bench.run("str/trim", n, [&] {
+                for (u64 i = 0; i < n; i++) {
+                    str s = "   padded field value   ";
+                    do_not_optimize(s.trim());
+                }
+            });
+
+            //a line of comma separated integers, parsed a token at a time and in bulk, reported per number
+            str numbers;
+            for (u64 i = 0; i < 10000; i++) numbers.append_number(i * 7919 % 1000003).append(',');
+            const u64 passes = std::max<u64>(n / 10000, 1);
+            bench.run("str/ston (split)", passes * 10000, [&] {
+                for (u64 i = 0; i < passes; i++) {
+                    for (auto part: numbers.split_view(",")) do_not_optimize(ston<i32>(part));
+                }
+            });
+            bench.run("str/parse_numbers", passes * 10000, [&] {
+                Vector<i32> values;
+                for (u64 i = 0; i < passes; i++) {
+                    values.clear();
+                    do_not_optimize(parse_numbers(numbers, values, ","));
+                }
+            });
+            bench.run("str/append to_str(f64)", n, [&] {
+                str s;
+                for (u64 i = 0; i < n; i++) {
+                    if (s.size() > 4096) s.clear();
+                    s.append(to_str(static_cast<f64>(i) * 0.25));
+                }
+                do_not_optimize(s);
+            });
+            bench.run("str/append_number(f64)", n, [&] {
+                str s;
+                for (u64 i = 0; i < n; i++) {
+                    if (s.size() > 4096) s.clear();
+                    s.append_number(static_cast<f64>(i) * 0.25);
+                }
+                do_not_optimize(s);
+            });
+
+            //a few thousand asset names compared and looked up as strings and as atoms, reported per operation
+            AtomTable atoms;
+            Vector<str> names;
+            Vector<Atom> interned;
+            std::unordered_map<str, u32> by_name;
+            std::unordered_map<Atom, u32> by_atom;
+            for (u32 i = 0; i < 4096; i++) {
+                str name = "assets/textures/environment/";
+                name.append_number(i);
+                interned.push_back(atoms.intern(name));
+                by_name.emplace(name, i);
+                by_atom.emplace(interned.back(), i);
+                names.push_back(std::move(name));
+            }
+            bench.run("str/== (names)", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(names[i & 4095] == names[(i * 7) & 4095]);
+            });
+            bench.run("atom/==", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(interned[i & 4095] == interned[(i * 7) & 4095]);
+            });
+            bench.run("str/unordered_map lookup", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(by_name.find(names[(i * 7) & 4095]));
+            });
+            bench.run("atom/unordered_map lookup", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(by_atom.find(interned[(i * 7) & 4095]));
+            });
+            bench.run("atom/intern (existing)", n, [&] {
+                for (u64 i = 0; i < n; i++) do_not_optimize(atoms.intern(names[(i * 7) & 4095]));
+            });
+
+            //small edits scattered through a 1mb document, reported per edit
+            str document;
+            while (document.size() < 1024*1024) document.append("the quick brown fox jumps over the lazy dog\n");
+            const u64 edits = std::max<u64>(n / 1000, 1);
+            bench.run("str/insert + erase (1mb)", edits, [&] {
+                for (u64 i = 0; i < edits; i++) {
+                    const usize pos = (i * 7919) % document.size();
+                    document.insert(pos, "edit");
+                    document.erase((pos * 3) % document.size(), 4);
+                }
+            });
+            rope document_rope(document);
+            bench.run("rope/insert + erase (1mb)", edits, [&] {
+                for (u64 i = 0; i < edits; i++) {
+                    const usize pos = (i * 7919) % document.size();
+                    document_rope.insert(pos, "edit");
+                    document_rope.erase((pos * 3) % document.size(), 4);
+                }
+            });
+            bench.run("rope/to_str (1mb)", document.size(), [&] { do_not_optimize(document_rope.to_str()); });
+        }
+
+#if defined(AUXIL_BENCHMARK_NETWORKING)
+        //a small message written into a WriteBuffer and read back out of a ReceiveBuffer, items are messages
+        inline void serializer(Benchmark& bench, const u64 n = 1'000'000) {
+            const std::string name = "position_update";
+            WriteBuffer out;
+            bench.run("serializer/append (u64, f64, std::string)", n, [&] {
+                out.clear();
+                for (u64 i = 0; i < n; i++) out.append(i, 0.5, name);
+                do_not_optimize(out.bytes);
+            });
+            bench.run("serializer/append_frame (u64, f64, std::string)", n, [&] {
+                out.clear();
+                for (u64 i = 0; i < n; i++) out.append_frame(i, 0.5, name);
+                do_not_optimize(out.bytes);
+            });
+
+            out.clear();
+            for (u64 i = 0; i < n; i++) out.append(i, 0.5, name);
+            ReceiveBuffer in;
+            in.bytes = out.bytes;
+            in.size = in.bytes.size();
+            bench.run("serializer/try_read (u64, f64, std::string)", n, [&] {
+                in.pos = 0;
+                for (u64 i = 0; i < n; i++) {
+                    do_not_optimize(*in.try_read<u64>());
+                    do_not_optimize(*in.try_read<f64>());
+                    do_not_optimize(*in.try_read<std::string>());
+                }
+            });
+        }
+
+        //a Client talking to a MultiServer over loopback, u64 frames echoed back one at a time (round trips) and
+        //1kb frames sent one way in batches (throughput), items are frames
+        inline void loopback(Benchmark& bench, const u64 n = 100'000, const u16 port = 47'300,
+                             const u32 threads = 2) {
+            IOContextPool pool(threads);
+            const auto address = boost::asio::ip::make_address("127.0.0.1");
+            MultiServer server(pool, address, port);
+            std::atomic_uint64_t received{0};
+            server.serve([&received](MultiServer::Session session) -> boost::asio::awaitable<void> {
+                while (session->is_connected()) {
+                    const auto frame = co_await session->co_read_frame();
+                    if (frame.size() == sizeof(u64)) {
+                        co_await session->co_write_frame(deserialize_from<u64>({frame.data(), frame.size()}));
+                    } else if (received.fetch_add(1, std::memory_order_release) % 1024 == 1023) {
+                        received.notify_all();
+                    }
+                }
+            });
+
+            Client client(address, port);
+            const u64 round_trips = std::max<u64>(n / 10, 1);
+            bench.run("loopback/round trip (u64 frame)", round_trips, [&] {
+                for (u64 i = 0; i < round_trips; i++) {
+                    client.write_frame(i);
+                    do_not_optimize(client.read_frame_as<u64>());
+                }
+            });
+
+            //a multiple of 1024 frames, so the server's last notify comes with the last frame
+            const u64 frames = std::max<u64>(n / 1024, 1) * 1024;
+            const std::string payload(1024, 'x');
+            client.set_auto_flush({.max_bytes = 64 * 1024});
+            bench.run("loopback/one way (1kb frames)", frames, [&] {
+                const u64 target = received.load(std::memory_order_relaxed) + frames;
+                for (u64 i = 0; i < frames; i++) client.queue_frame(payload);
+                client.flush();
+                for (u64 r = received.load(std::memory_order_acquire); r < target; r = received.load(std::memory_order_acquire)) {
+                    received.wait(r, std::memory_order_acquire);
+                }
+            });
+
+            client.close();
+            server.stop();
+        }
+#endif
+
+        //every suite, by the name the driver selects it with, scale multiplies their sizes
+        inline std::vector<std::pair<std::string, std::function<void(Benchmark&, f64)>>> suites() {
+            auto scaled = [](const u64 n, const f64 scale) {
+                return std::max<u64>(static_cast<u64>(static_cast<f64>(n) * scale), 1);
+            };
+            return {
+                {"executor", [=](Benchmark& b, const f64 s) { executor_submission(b, scaled(1'000'000, s)); }},
+                {"matrix", [=](Benchmark& b, const f64 s) {
+                    for (const usize n: {64, 128, 256, 512}) matrix(b, std::max<usize>(static_cast<usize>(n * std::cbrt(s)), 8));
+                }},
+                {"strings", [=](Benchmark& b, const f64 s) { strings(b, scaled(1'000'000, s)); }},
+                {"random", [=](Benchmark& b, const f64 s) { random(b, scaled(10'000'000, s)); }},
+                {"vectors", [=](Benchmark& b, const f64 s) { vectors(b, scaled(10'000'000, s)); }},
+                {"bounds_checks", [=](Benchmark& b, const f64 s) { bounds_checks(b, scaled(10'000'000, s)); }},
+                {"logging", [=](Benchmark& b, const f64 s) { logging(b, scaled(1'000'000, s)); }},
+                {"linked_lists", [=](Benchmark& b, const f64 s) { linked_lists(b, scaled(1'000'000, s)); }},
+                {"arena", [=](Benchmark& b, const f64 s) { arena(b, scaled(1'000'000, s)); }},
+#if defined(AUXIL_BENCHMARK_NETWORKING)
+                {"serializer", [=](Benchmark& b, const f64 s) { serializer(b, scaled(1'000'000, s)); }},
+                {"loopback", [=](Benchmark& b, const f64 s) { loopback(b, scaled(100'000, s)); }},
+#endif
+            };
+        }
+
+        /*
+         * a main for a benchmark executable, int main(int argc, char** argv) { return Auxil::Benchmarks::run_main(argc, argv); }
+         * --suites=a,b        only run these suites (see --list), all of them by default
+         * --format=table|json|csv
+         * --output=path       write the results to a file instead of stdout
+         * --repetitions=n     timed repetitions of each benchmark, 5 by default
+         * --scale=f           multiplies every suite's size, below 1 for a quick run
+         * --list              prints the suite names
+         */
+        inline int run_main(const int argc, char** argv) {
+            const auto all = suites();
+            std::vector<std::string> selected;
+            std::string format = "table", output;
+            u32 repetitions = 5;
+            f64 scale = 1;
+
+            auto usage = [&] {
+                std::cerr << "usage: " << (argc > 0 ? argv[0] : "bench")
+                          << " [--suites=a,b] [--format=table|json|csv] [--output=path] [--repetitions=n] [--scale=f] [--list]\n";
+                return 1;
+            };
+
+            try {
+                for (int i = 1; i < argc; i++) {
+                    const std::string_view arg = argv[i];
+                    const usize eq = arg.find('=');
+                    const std::string_view key = arg.substr(0, eq);
+                    const std::string_view value = eq == std::string_view::npos ? "" : arg.substr(eq + 1);
+
+                    if (key == "--list") {
+                        for (const auto& [name, run]: all) std::cout << name << "\n";
+                        return 0;
+                    }
+                    if (key == "--suites") {
+                        for (usize start = 0; start <= value.size();) {
+                            const usize comma = std::min(value.find(',', start), value.size());
+                            if (comma > start) selected.emplace_back(value.substr(start, comma - start));
+                            start = comma + 1;
+                        }
+                    } else if (key == "--format" && (value == "table" || value == "json" || value == "csv")) {
+                        format = value;
+                    } else if (key == "--output" && !value.empty()) {
+                        output = value;
+                    } else if (key == "--repetitions") {
+                        repetitions = std::stoul(std::string(value));
+                    } else if (key == "--scale") {
+                        scale = std::stod(std::string(value));
+                        if (!(scale > 0)) return usage();
+                    } else {
+                        return usage();
+                    }
+                }
+            } catch (const std::exception&) {
+                return usage();
+            }
+
+            for (const auto& name: selected) {
+                if (std::ranges::none_of(all, [&](const auto& suite) { return suite.first == name; })) {
+                    std::cerr << "unknown suite \"" << name << "\"\n";
+                    return 1;
+                }
+            }
+
+            Benchmark bench(repetitions);
+            for (const auto& [name, run]: all) {
+                if (selected.empty() || std::ranges::find(selected, name) != selected.end()) run(bench, scale);
+            }
+
+            std::ofstream file;
+            if (!output.empty()) {
+                file.open(output);
+                if (!file) {
+                    std::cerr << "cannot open " << output << "\n";
+                    return 1;
+                }
+            }
+            std::ostream& os = output.empty() ? std::cout : file;
+            if (format == "json") bench.write_json(os);
+            else if (format == "csv") bench.write_csv(os);
+            else bench.report(os);
+
+            return 0;
+        }
+    }
+}
+
+#endif //BENCHMARK_HPP
@@ -2,31 +2,56 @@
 #define CONTAINERS_HPP
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <expected>
+#include <system_error>
 #include "iterator.hpp"
 #include "exception.hpp"
 #include "math.hpp"
 #include "globals.hpp"
+#include "memory.hpp"
 
 namespace Auxil {
+    //what the try_ accessors return, the element or std::errc::result_out_of_range, they check the index whatever
+    //AUXIL_BOUNDS_CHECK is set to and never throw, for code that would rather branch on a bad index than catch it
+    template<typename T>
+    using Checked = std::expected<std::reference_wrapper<T>, std::errc>;
+
     //A fixed-size array, but can be allocated at runtime
+    //the storage comes from a std::pmr::memory_resource (null for the default resource), copies use the default
+    //resource unless one is passed in, moves take the other array's resource with them
     template<std::semiregular T>
     class Array {
     protected:
         T* _arr{nullptr};
         usize _size{0};
         bool _is_pointer_wrapper = false;
+        std::pmr::memory_resource* _resource{nullptr};
 
 
         void destruct() {
-            if (!_is_pointer_wrapper) delete[] _arr;
+            if (!_is_pointer_wrapper && _arr) {
+                MemoryDetail::destroy(_arr, _size);
+                MemoryDetail::deallocate(_resource, _arr, _size);
+            }
             _size = 0;
             _arr = nullptr;
+            _is_pointer_wrapper = false;
+        }
+
+        //allocates storage for size elements without constructing them
+        void allocate(const usize size) {
+            _arr = MemoryDetail::allocate<T>(_resource, size);
+            _size = size;
         }
 
         void initialize() {
-            for (usize i = 0; i < _size; i++) {
-                new (_arr+i) T();
-            }
+            std::uninitialized_value_construct_n(_arr, _size);
+        }
+
+        template<typename It>
+        void copy_construct(It first) {
+            std::uninitialized_copy_n(first, _size, _arr);
         }
 
     public:
@@ -36,20 +61,18 @@ namespace Auxil {
 
         Array() = default;
 
-        explicit Array(const usize size) {
-            _arr = new T[size];
-            _size = size;
+        explicit Array(std::pmr::memory_resource* resource) : _resource(resource) {}
+
+        explicit Array(const usize size, std::pmr::memory_resource* resource = nullptr)
+            : _resource(resource) {
+            allocate(size);
             initialize();
         }
 
-        Array(const std::initializer_list<T>& init) {
-            _arr = new T[init.size()];
-            _size = init.size();
-            auto it = init.begin();
-
-            for (usize i = 0; i < _size; i++) {
-                _arr[i] = *(it++);
-            }
+        Array(const std::initializer_list<T>& init, std::pmr::memory_resource* resource = nullptr)
+            : _resource(resource) {
+            allocate(init.size());
+            copy_construct(init.begin());
         }
 
         Array(T* ptr, usize size) {
@@ -59,9 +82,10 @@ namespace Auxil {
         }
 
         template<Iterable I, typename = std::enable_if_t<std::is_convertible_v<iterable_value_t<I>, T>>>
-        explicit Array(const I& iterable) {
-            _size = static_cast<usize>(iterable.size());
-            _arr = new T[_size];
+        explicit Array(const I& iterable, std::pmr::memory_resource* resource = nullptr)
+            : _resource(resource) {
+            allocate(static_cast<usize>(iterable.size()));
+            initialize();
             for (auto[member, init_list]: Auxil::zip_copy(
                 iterate_pointer(_arr, _arr+_size),
                 iterable
@@ -70,53 +94,48 @@ namespace Auxil {
             }
         }
 
-        Array(const Array& arr) {
-            _size = arr.size();
-            _arr = new T[_size];
-            for (usize i = 0; i < _size; i++) {
-                std::construct_at(_arr+i, arr[i]);
-            }
+        Array(const Array& arr, std::pmr::memory_resource* resource = nullptr)
+            : _resource(resource) {
+            allocate(arr.size());
+            copy_construct(arr._arr);
         }
 
         Array(Array&& arr)  noexcept {
             _size = arr._size;
             _arr = arr._arr;
+            _is_pointer_wrapper = arr._is_pointer_wrapper;
+            _resource = arr._resource;
             arr._arr = nullptr;
             arr.destruct();
         }
 
         Array& operator=(const usize size) {
             destruct();
-            _arr = new T[size];
-            _size = size;
+            allocate(size);
+            initialize();
 
             return *this;
         }
 
         Array& operator=(const std::initializer_list<T>& init) {
             destruct();
-            _arr = new T[init.size()];
-            _size = init.size();
-
-            for (auto[member, init_list]:
-                Auxil::zip_copy(
-                    iterate_pointer(_arr, _arr+_size),
-                    iterate_pointer(init.begin(), init.end()))) {
-                member = init_list;
-                    }
+            allocate(init.size());
+            copy_construct(init.begin());
 
             return *this;
         }
 
+        //keeps this array's resource, and its storage when the sizes already match
         Array& operator=(const Array& arr) {
             if (&arr == this) return *this;
+            if (_size == arr._size && !_is_pointer_wrapper) {
+                std::copy_n(arr._arr, _size, _arr);
+                return *this;
+            }
             destruct();
 
-            _size = arr.size();
-            _arr = new T[_size];
-            for (usize i = 0; i < _size; i++) {
-                std::construct_at(_arr+i, arr[i]);
-            }
+            allocate(arr.size());
+            copy_construct(arr._arr);
 
             return *this;
         }
@@ -124,8 +143,8 @@ namespace Auxil {
         template<Iterable I, typename = std::enable_if_t<std::is_convertible_v<iterable_value_t<I>, T>>>
         Array& operator=(const I& iterable) {
             destruct();
-            _size = static_cast<usize>(iterable.size());
-            _arr = new T[_size];
+            allocate(static_cast<usize>(iterable.size()));
+            initialize();
             for (auto[member, init_list]: Auxil::zip_copy(
                 iterate_pointer(_arr, _arr+_size),
                 iterable
@@ -142,12 +161,18 @@ namespace Auxil {
             destruct();
             _size = arr._size;
             _arr = arr._arr;
+            _is_pointer_wrapper = arr._is_pointer_wrapper;
+            _resource = arr._resource;
             arr._arr = nullptr;
             arr.destruct();
 
             return *this;
         }
 
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return MemoryDetail::resolve(_resource);
+        }
+
         [[nodiscard]] bool is_pointer_wrapper() {
             return _is_pointer_wrapper;
         }
@@ -186,12 +211,17 @@ namespace Auxil {
         }
 
         FORCE_INLINE T& at(usize ind) const {
-            if (ind >= _size) throw Auxil::Exception("Cannot access element at index {}", ind);
+            AUXIL_CHECK_BOUNDS(ind >= _size, "Cannot access element at index {}", ind);
             return _arr[ind];
         }
 
+        FORCE_INLINE Checked<T> try_at(const usize ind) const noexcept {
+            if (ind >= _size) [[unlikely]] return std::unexpected(std::errc::result_out_of_range);
+            return std::ref(_arr[ind]);
+        }
+
         FORCE_INLINE T& operator[](usize ind) const {
-            if (ind >= _size) throw Auxil::Exception("Cannot access element at index {}", ind);
+            AUXIL_CHECK_BOUNDS(ind >= _size, "Cannot access element at index {}", ind);
             return _arr[ind];
         }
 
@@ -227,1285 +257,3164 @@ namespace Auxil {
         return os;
     }
 
+    namespace VectorDetail {
+        //room for N elements inside the Vector itself, nothing at all when N is 0
+        template<typename T, usize N>
+        struct InlineStorage {
+            alignas(T) std::byte bytes[N * sizeof(T)];
 
+            FORCE_INLINE T* data() noexcept {
+                return reinterpret_cast<T*>(bytes);
+            }
 
-    template<typename T, typename = std::enable_if_t<std::semiregular<T>>>
-    class Grid {
-        T* matrix{nullptr};
-        usize _columns{0}, _rows{0};
-
+            FORCE_INLINE const T* data() const noexcept {
+                return reinterpret_cast<const T*>(bytes);
+            }
+        };
 
-        void initialize(const usize rows, const usize columns, bool default_initialize = false) {
-            matrix = static_cast<T*>(::operator new[](sizeof(T)*columns*rows));
-            this->_columns = columns;
-            this->_rows = rows;
+        template<typename T>
+        struct InlineStorage<T, 0> {
+            FORCE_INLINE T* data() const noexcept {
+                return nullptr;
+            }
+        };
+    }
 
-            if (default_initialize) {
-                for (usize i = 0; i < columns*rows; i++) {
-                    new (matrix+i) T();
-                }
+    /*
+     * a growable array that keeps its first N elements inside the object, so small vectors never allocate, once it
+     * outgrows them the elements move to the heap and grow by MemoryDetail::grow_capacity
+     *
+     * with no resource the heap is malloc/realloc, so trivially relocatable elements grow in place whenever the
+     * allocator can extend the block, with a std::pmr::memory_resource they are relocated into a new block,
+     * copies use the C heap unless they are given a resource, moves take the other vector's resource with them
+     */
+    template<typename T, usize N = 0>
+    class Vector {
+        T* _data;
+        usize _size{0};
+        usize _capacity{N};
+        std::pmr::memory_resource* _resource{nullptr};
+        [[no_unique_address]] VectorDetail::InlineStorage<T, N> _inline;
+
+        //realloc only hands back max_align_t aligned memory
+        static constexpr bool can_realloc = is_trivially_relocatable_v<T> && alignof(T) <= alignof(std::max_align_t);
+
+        T* allocate(const usize n) {
+            if (_resource) return static_cast<T*>(_resource->allocate(n * sizeof(T), alignof(T)));
+            if constexpr (alignof(T) <= alignof(std::max_align_t)) {
+                auto* p = static_cast<T*>(std::malloc(n * sizeof(T)));
+                if (!p) throw std::bad_alloc();
+                return p;
+            } else {
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
             }
         }
 
-        void destruct() {
-            for (usize i = 0; i < _columns*_rows; i++) {
-                matrix[i].~T();
+        void deallocate(T* p, const usize n) {
+            if (_resource) {
+                _resource->deallocate(p, n * sizeof(T), alignof(T));
+            } else if constexpr (alignof(T) <= alignof(std::max_align_t)) {
+                std::free(p);
+            } else {
+                ::operator delete(p, std::align_val_t(alignof(T)));
             }
+        }
 
-            ::operator delete[](matrix);
-            matrix = nullptr;
-            _columns = 0;
-            _rows = 0;
+        void release() {
+            MemoryDetail::destroy(_data, _size);
+            if (!is_inline()) deallocate(_data, _capacity);
         }
 
+        //moves the elements into a block of new_capacity, which must be at least size()
+        void reallocate(const usize new_capacity) {
+            if (new_capacity <= N) {
+                if (is_inline()) return;
+                T* old = _data;
+                MemoryDetail::relocate(old, _size, _inline.data());
+                deallocate(old, _capacity);
+                _data = _inline.data();
+                _capacity = N;
+                return;
+            }
 
-        FORCE_INLINE static Grid dot(const Grid& left, const Grid& right) {
+            if constexpr (can_realloc) {
+                if (!_resource && !is_inline()) {
+                    auto* p = static_cast<T*>(std::realloc(_data, new_capacity * sizeof(T)));
+                    if (!p) throw std::bad_alloc();
+                    _data = p;
+                    _capacity = new_capacity;
+                    return;
+                }
+            }
 
-            Grid result = make(left._rows, right._columns);
+            T* fresh = allocate(new_capacity);
+            MemoryDetail::relocate(_data, _size, fresh);
+            if (!is_inline()) deallocate(_data, _capacity);
+            _data = fresh;
+            _capacity = new_capacity;
+        }
 
-            for (usize i = 0; i < left._rows; i++) {
-                for (usize j = 0; j < right._columns; j++) {
-                    T sum = 0;
-                    for (usize k = 0; k < left._columns; k++) {
-                        sum += left[i][k] * right[k][j];
-                    }
-                    result[i][j] = sum;
+        //the element is constructed before the old elements are relocated, so args may refer to one of them
+        template<typename... Args>
+        T& emplace_back_grow(Args&&... args) {
+            const usize new_capacity = MemoryDetail::grow_capacity(_capacity, _size + 1);
+
+            if constexpr (can_realloc) {
+                if (!_resource && !is_inline()) {
+                    T value(std::forward<Args>(args)...);
+                    reallocate(new_capacity);
+                    return *std::construct_at(_data + _size++, std::move(value));
                 }
             }
 
-            return result;
+            T* fresh = allocate(new_capacity);
+            try {
+                std::construct_at(fresh + _size, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(fresh, new_capacity);
+                throw;
+            }
+            MemoryDetail::relocate(_data, _size, fresh);
+            if (!is_inline()) deallocate(_data, _capacity);
+            _data = fresh;
+            _capacity = new_capacity;
+
+            return _data[_size++];
+        }
+
+        //takes other's elements, leaving it empty and inline
+        void steal(Vector& other) noexcept {
+            _resource = other._resource;
+            _size = other._size;
+            if (other.is_inline()) {
+                _data = _inline.data();
+                _capacity = N;
+                MemoryDetail::relocate(other._data, other._size, _data);
+            } else {
+                _data = other._data;
+                _capacity = other._capacity;
+                other._data = other._inline.data();
+                other._capacity = N;
+            }
+            other._size = 0;
         }
 
     public:
+        using value_type = T;
+        using size_type = usize;
+        using iterator = PointerIterator<T>;
+        static constexpr usize inline_capacity = N;
 
-        ~Grid() {
-            destruct();
+        ~Vector() {
+            release();
         }
 
-        Grid() = default;
+        Vector() noexcept : _data(_inline.data()) {}
 
-        [[nodiscard]] static Grid make(const usize rows, const usize columns) {
-            Grid res;
-            res.initialize(rows, columns, true);
+        explicit Vector(std::pmr::memory_resource* resource) noexcept : _data(_inline.data()), _resource(resource) {}
 
-            return res;
+        explicit Vector(const usize size, std::pmr::memory_resource* resource = nullptr) : Vector(resource) {
+            resize(size);
         }
 
-
-        Grid(std::initializer_list<std::initializer_list<T>> init_list) {
-            auto it = init_list.begin();
-            initialize(init_list.size(), it->size(), true);
-            usize i = 0;
-            for (; it != init_list.end(); ++it) {
-                for (usize j = 0; j < it->size() && j < _columns; j++) {
-                    std::construct_at(&matrix[i++], *((*it).begin()+j));
-                }
-            }
+        Vector(const usize size, const T& value, std::pmr::memory_resource* resource = nullptr) : Vector(resource) {
+            resize(size, value);
         }
 
-        Grid(const Grid& grid) noexcept {
-            if (grid._rows == 0) return;
-            initialize(grid._rows, grid._columns);
+        Vector(const std::initializer_list<T>& init, std::pmr::memory_resource* resource = nullptr) : Vector(resource) {
+            reserve(init.size());
+            std::uninitialized_copy(init.begin(), init.end(), _data);
+            _size = init.size();
+        }
 
-            for (usize i = 0; i < grid.size(); i++) {
-                std::construct_at(&matrix[i], grid.matrix[i]);
-            }
+        template<Iterable I, typename = std::enable_if_t<std::is_convertible_v<iterable_value_t<I>, T>>>
+        explicit Vector(const I& iterable, std::pmr::memory_resource* resource = nullptr) : Vector(resource) {
+            reserve(static_cast<usize>(iterable.size()));
+            for (auto& v: iterable) emplace_back(v);
         }
 
-        Grid(Grid&& grid) noexcept {
-            if (grid._rows == 0) return;
+        Vector(const Vector& other, std::pmr::memory_resource* resource = nullptr) : Vector(resource) {
+            reserve(other._size);
+            std::uninitialized_copy_n(other._data, other._size, _data);
+            _size = other._size;
+        }
 
-            matrix = grid.matrix;
-            _columns = grid._columns;
-            _rows = grid._rows;
-            grid.matrix = nullptr;
-            grid.destruct();
+        Vector(Vector&& other) noexcept : _data(_inline.data()) {
+            steal(other);
         }
 
-        Grid& operator=(const Grid& grid) noexcept {
-            if (grid._rows == 0) return *this;
-            if (&grid == this) return *this;
+        //keeps this vector's resource and storage
+        Vector& operator=(const Vector& other) {
+            if (&other == this) return *this;
+            clear();
+            reserve(other._size);
+            std::uninitialized_copy_n(other._data, other._size, _data);
+            _size = other._size;
 
-            destruct();
+            return *this;
+        }
 
-            initialize(grid._rows, grid._columns);
+        Vector& operator=(Vector&& other) noexcept {
+            if (&other == this) return *this;
+            release();
+            _data = _inline.data();
+            steal(other);
 
-            for (usize i = 0; i < grid.size(); i++) {
-                std::construct_at(&matrix[i], grid.matrix[i]);
-            }
+            return *this;
+        }
+
+        Vector& operator=(const std::initializer_list<T>& init) {
+            clear();
+            reserve(init.size());
+            std::uninitialized_copy(init.begin(), init.end(), _data);
+            _size = init.size();
 
             return *this;
         }
 
-        Grid& operator=(Grid&& grid) noexcept {
-            if (grid._rows == 0) return *this;
-            if (&grid == this) return *this;
+        //--------- Adding values -----------
 
-            destruct();
+        template<typename... Args>
+        requires std::constructible_from<T, Args&&...>
+        FORCE_INLINE T& emplace_back(Args&&... args) {
+            if (_size == _capacity) [[unlikely]] return emplace_back_grow(std::forward<Args>(args)...);
+            return *std::construct_at(_data + _size++, std::forward<Args>(args)...);
+        }
 
-            matrix = grid.matrix;
-            _rows = grid._rows;
-            _columns = grid._columns;
-            grid.matrix = nullptr;
-            grid.destruct();
+        FORCE_INLINE T& push_back(const T& value) {
+            return emplace_back(value);
+        }
+
+        FORCE_INLINE T& push_back(T&& value) {
+            return emplace_back(std::move(value));
+        }
+
+        //inserts value before index, shifting the elements after it
+        template<typename U>
+        requires std::constructible_from<T, U&&>
+        T& insert(const usize index, U&& value) {
+            if (index > _size) throw Exception("Cannot insert at index {} of a vector with {} elements", index, _size);
+            if (index == _size) return emplace_back(std::forward<U>(value));
+
+            T tmp(std::forward<U>(value));
+            emplace_back(std::move(_data[_size-1]));
+            std::move_backward(_data + index, _data + _size - 2, _data + _size - 1);
+            _data[index] = std::move(tmp);
+            return _data[index];
+        }
+
+        //--------- Removing values -----------
+
+        void pop_back() {
+            if (_size == 0) throw Exception("Cannot pop back of empty vector!");
+            std::destroy_at(_data + --_size);
+        }
+
+        //removes the element at index, shifting the elements after it
+        void erase(const usize index) {
+            if (index >= _size) throw Exception("Cannot erase index {} of a vector with {} elements", index, _size);
+            std::move(_data + index + 1, _data + _size, _data + index);
+            pop_back();
+        }
+
+        //removes the element at index by moving the last element into its place
+        void swap_erase(const usize index) {
+            if (index >= _size) throw Exception("Cannot erase index {} of a vector with {} elements", index, _size);
+            if (index != _size - 1) _data[index] = std::move(_data[_size - 1]);
+            pop_back();
+        }
+
+        Vector& clear() {
+            MemoryDetail::destroy(_data, _size);
+            _size = 0;
 
             return *this;
         }
 
-        template<typename... Args>
-        FORCE_INLINE T& emplace_at(usize row, usize column, Args&&... constructor) {
-            if (row >= _rows || column >= _columns) {
-                throw Exception("Cannot create element at ({}, {}) in Grid with dimensions {}x{}", column, row, _rows, _columns);
-            }
-            std::destroy_at((matrix+row*_columns)+column);
-            auto& elem = *std::construct_at((matrix+row*_columns), std::forward<Args>(constructor)...);
-            return elem;
+        //--------- Size management -----------
+
+        Vector& reserve(const usize new_capacity) {
+            if (new_capacity > _capacity) reallocate(new_capacity);
+            return *this;
         }
 
-        [[nodiscard]] FORCE_INLINE usize width() const {
-            return _columns;
+        Vector& resize(const usize new_size) {
+            if (new_size < _size) {
+                MemoryDetail::destroy(_data + new_size, _size - new_size);
+            } else if (new_size > _size) {
+                reserve(new_size);
+                std::uninitialized_value_construct_n(_data + _size, new_size - _size);
+            }
+            _size = new_size;
+
+            return *this;
         }
 
-        [[nodiscard]] FORCE_INLINE  usize height() const {
-            return _rows;
+        Vector& resize(const usize new_size, const T& value) {
+            if (new_size < _size) {
+                MemoryDetail::destroy(_data + new_size, _size - new_size);
+            } else if (new_size > _size) {
+                if (new_size > _capacity) {
+                    //value may be one of the elements, so copy it before they move
+                    T copy = value;
+                    reserve(new_size);
+                    std::uninitialized_fill_n(_data + _size, new_size - _size, copy);
+                } else {
+                    std::uninitialized_fill_n(_data + _size, new_size - _size, value);
+                }
+            }
+            _size = new_size;
+
+            return *this;
         }
 
-        [[nodiscard]] FORCE_INLINE usize area() const {
-            return _rows*_columns;
+        //moves the elements back inline if they fit, otherwise into a block of exactly size() elements
+        Vector& shrink_to_fit() {
+            if (_capacity > std::max(_size, N)) reallocate(std::max(_size, N));
+            return *this;
         }
 
-        [[nodiscard]] FORCE_INLINE usize columns() const {
-            return _columns;
+        //--------- Access -----------
+
+        [[nodiscard]] FORCE_INLINE usize size() const noexcept {
+            return _size;
         }
 
-        [[nodiscard]] FORCE_INLINE  usize rows() const {
-            return _rows;
+        [[nodiscard]] FORCE_INLINE usize capacity() const noexcept {
+            return _capacity;
         }
 
-        [[nodiscard]] FORCE_INLINE  usize size() const {
-            return _rows*_columns;
+        [[nodiscard]] FORCE_INLINE bool empty() const noexcept {
+            return _size == 0;
         }
 
-        FORCE_INLINE Array<T> at(const usize row_ind) const {
-            if (row_ind >= _rows) throw Exception("{} out of range of Grid with {} rows", row_ind, _rows);
-            return Array<T>(matrix+(row_ind*_columns), _columns);
+        //if the elements are stored in the vector itself
+        [[nodiscard]] FORCE_INLINE bool is_inline() const noexcept {
+            return _data == _inline.data();
         }
 
-        FORCE_INLINE T& at_flat(const usize ind) const {
-            if (ind >= _rows*_columns) throw Exception("{} out of range of Grid with {} elements", ind, _rows*_columns);
-            return matrix[ind];
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return MemoryDetail::resolve(_resource);
         }
 
-        FORCE_INLINE Array<T> operator[](const usize row_ind) const {
-            if (row_ind >= _rows) throw Exception("{} out of range of Grid with {} rows", row_ind, _rows);
-            return Array<T>(matrix+(row_ind*_columns), _columns);
+        FORCE_INLINE T& at(const usize ind) const {
+            AUXIL_CHECK_BOUNDS(ind >= _size, "Cannot access element at index {}", ind);
+            return _data[ind];
         }
 
-        FORCE_INLINE Array<T> front() const {
-            if (_rows == 0) throw Exception("Cannot access front of empty grid");
-            return Array<T>(matrix, _columns);
+        FORCE_INLINE Checked<T> try_at(const usize ind) const noexcept {
+            if (ind >= _size) [[unlikely]] return std::unexpected(std::errc::result_out_of_range);
+            return std::ref(_data[ind]);
         }
 
-        FORCE_INLINE Array<T> back() const {
-            if (_rows == 0) throw Exception("Cannot access back of empty grid");
-            return Array<T>(matrix+((_rows-1)*_columns), _columns);
+        FORCE_INLINE T& operator[](const usize ind) const {
+            AUXIL_CHECK_BOUNDS(ind >= _size, "Cannot access element at index {}", ind);
+            return _data[ind];
         }
 
-        FORCE_INLINE T& first() const {
-            if (_rows * _columns == 0) throw Exception("Cannot access first element of a {}x{} grid", _rows, _columns);
-            return matrix[0];
+        FORCE_INLINE T& front() const {
+            AUXIL_CHECK_BOUNDS(_size == 0, "Cannot access front of empty vector!");
+            return _data[0];
         }
 
-        FORCE_INLINE T& last() const {
-            if (_rows * _columns == 0) throw Exception("Cannot access last element of a {}x{} grid", _rows, _columns);
-            return matrix[_rows*_columns-1];
+        FORCE_INLINE T& back() const {
+            AUXIL_CHECK_BOUNDS(_size == 0, "Cannot access back of empty vector!");
+            return _data[_size - 1];
         }
 
-        FORCE_INLINE T* data() const {
-            return matrix;
+        FORCE_INLINE T* data() const noexcept {
+            return _data;
         }
 
         PointerIterator<T> begin() const {
-            return matrix;
+            return _data;
         }
 
         PointerIterator<T> end() const {
-            return matrix+(_rows*_columns);
+            return _data + _size;
         }
 
         ReversePointerIterator<T> rbegin() const {
-            return matrix+((_rows*_columns)-1);
+            return _data + _size - 1;
         }
 
         ReversePointerIterator<T> rend() const {
-            return matrix-1;
+            return _data - 1;
         }
 
-        [[nodiscard]] FORCE_INLINE bool empty() const {
-            return _rows*_columns == 0;
+        bool operator==(const Vector& other) const requires std::equality_comparable<T> {
+            return _size == other._size && std::equal(_data, _data + _size, other._data);
         }
+    };
 
-        Grid& reset() {
-            for (usize i = 0; i < _rows*_columns; i++) {
-                matrix[i] = T();
-            }
-
-            return *this;
+    template<OstreamFormattable U, usize N>
+    std::ostream& operator<<(std::ostream& os, const Vector<U, N>& vec) {
+        os << '[';
+        for (usize i = 0; i < vec.size(); i++) {
+            if (i != 0) os << ", ";
+            os << vec.data()[i];
         }
+        os << ']';
 
+        return os;
+    }
 
-        Grid operator+(const Grid& other) const {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot add grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other.rows, other.columns,
-                                _rows, _columns);
-            }
 
-            Grid result = make(_rows, _columns);
-            for (usize i = 0; i < size(); i++) {
-                std::construct_at(&result.matrix[i], matrix[i] + other.matrix[i]);
-            }
 
-            return result;
-        }
+    namespace MatmulDetail {
+        using namespace Simd;
 
+        //tuned for 32kb of L1 and 256kb+ of L2, a kc x nc block of b is reused by every row of a
+        constexpr usize kc = 256;
+        constexpr usize nc = 512;
+        //rows of c computed at once, each one keeps two vectors of accumulators in registers
+        constexpr usize mr = 4;
 
-        Grid operator-(const Grid& other) const {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot subtract grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other.rows, other.columns,
-                                _rows, _columns);
+        //c[i..i+rows)[j..j+2*lanes) += a[i..i+rows)[p0..p1) * b[p0..p1)[j..j+2*lanes)
+        template<SimdArithmetic T, usize rows>
+        FORCE_INLINE void micro_kernel(const T* a, const T* b, T* c, const usize k, const usize n,
+                                       const usize p0, const usize p1) {
+            constexpr usize w = lanes<T>;
+            Vec<T> acc[rows][2];
+            for (usize r = 0; r < rows; r++) {
+                acc[r][0] = load(c + r*n);
+                acc[r][1] = load(c + r*n + w);
             }
 
-            Grid result = make(_rows, _columns);
-            for (usize i = 0; i < size(); i++) {
-                std::construct_at(&result.matrix[i], matrix[i] - other.matrix[i]);
+            for (usize p = p0; p < p1; p++) {
+                const Vec<T> b0 = load(b + p*n);
+                const Vec<T> b1 = load(b + p*n + w);
+                for (usize r = 0; r < rows; r++) {
+                    const T av = a[r*k + p];
+                    acc[r][0] += av * b0;
+                    acc[r][1] += av * b1;
+                }
             }
 
-            return result;
+            for (usize r = 0; r < rows; r++) {
+                store(c + r*n, acc[r][0]);
+                store(c + r*n + w, acc[r][1]);
+            }
         }
 
+        template<SimdArithmetic T>
+        void matmul_blocked(const T* a, const T* b, T* c, const usize m, const usize k, const usize n) {
+            constexpr usize nr = 2 * lanes<T>;
+            std::fill(c, c + m*n, T{});
 
-        Grid& operator+=(const Grid& other) {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot add grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other.rows, other.columns,
-                                _rows, _columns);
-            }
-
-            for (usize i = 0; i < size(); i++) {
-                matrix[i] += other.matrix[i];
-            }
+            for (usize j0 = 0; j0 < n; j0 += nc) {
+                const usize j1 = std::min(n, j0 + nc);
+                //columns past the last full register tile are done by the scalar loop below
+                const usize j_tiles = j0 + (j1 - j0) / nr * nr;
 
-            return this;
-        }
+                for (usize p0 = 0; p0 < k; p0 += kc) {
+                    const usize p1 = std::min(k, p0 + kc);
 
+                    usize i = 0;
+                    for (; i + mr <= m; i += mr) {
+                        for (usize j = j0; j < j_tiles; j += nr) {
+                            micro_kernel<T, mr>(a + i*k, b + j, c + i*n + j, k, n, p0, p1);
+                        }
+                    }
+                    for (; i < m; i++) {
+                        for (usize j = j0; j < j_tiles; j += nr) {
+                            micro_kernel<T, 1>(a + i*k, b + j, c + i*n + j, k, n, p0, p1);
+                        }
+                    }
 
-        Grid& operator-=(const Grid& other) {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot subtract grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other.rows, other.columns,
-                                _rows, _columns);
+                    for (i = 0; i < m; i++) {
+                        for (usize p = p0; p < p1; p++) {
+                            const T av = a[i*k + p];
+                            for (usize j = j_tiles; j < j1; j++) {
+                                c[i*n + j] += av * b[p*n + j];
+                            }
+                        }
+                    }
+                }
             }
+        }
+    }
 
-            for (usize i = 0; i < size(); i++) {
-                matrix[i] -= other.matrix[i];
+    //c = a * b where a is m x k, b is k x n and c is m x n, all densely packed in row major order,
+    //c must not overlap a or b
+    //arithmetic types go through a cache blocked, register tiled kernel written with vector extensions,
+    //everything else uses an i-k-j loop that at least walks b and c along their rows
+    template<typename T>
+    void matmul(const T* a, const T* b, T* c, const usize m, const usize k, const usize n) {
+        if (m == 0 || n == 0) return;
+
+        if constexpr (SimdArithmetic<T>) {
+            MatmulDetail::matmul_blocked(a, b, c, m, k, n);
+        } else {
+            for (usize i = 0; i < m; i++) {
+                T* c_row = c + i*n;
+                for (usize p = 0; p < k; p++) {
+                    const T& av = a[i*k + p];
+                    const T* b_row = b + p*n;
+                    for (usize j = 0; j < n; j++) {
+                        if (p == 0) c_row[j] = av * b_row[j];
+                        else c_row[j] += av * b_row[j];
+                    }
+                }
             }
-
-            return this;
         }
+    }
 
+    //a row of a Grid (or of a SubGridView), it doesn't own its elements and indexing isn't bounds checked,
+    //use at() for a checked access
+    template<typename T>
+    class RowView {
+        T* _data{nullptr};
+        usize _size{0};
 
+    public:
+        RowView() = default;
 
+        RowView(T* data, const usize size) : _data(data), _size(size) {}
 
-        FORCE_INLINE Grid dot(const Grid& right) const {
-            if (_columns != right._rows) {
-                if (right._columns == _rows) return dot(right, *this);
-                throw Exception("Cannot compute the dot product of grids where the columns of one"
-                                " does not equal the number of rows of the other\n"
-                                "Left: {}x{}, Right: {}x{}", _rows, _columns, right._rows, right._columns);
-            }
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return _size;
+        }
 
-            return dot(*this, right);
+        [[nodiscard]] FORCE_INLINE bool empty() const {
+            return _size == 0;
         }
 
+        FORCE_INLINE T* data() const {
+            return _data;
+        }
 
+        FORCE_INLINE T& operator[](const usize ind) const {
+            return _data[ind];
+        }
 
-        Grid operator*(const Grid& other) {
-            return dot(other);
+        FORCE_INLINE T& at(const usize ind) const {
+            AUXIL_CHECK_BOUNDS(ind >= _size, "{} out of range of a row with {} elements", ind, _size);
+            return _data[ind];
         }
 
+        FORCE_INLINE T& front() const {
+            return _data[0];
+        }
 
-        //this one does a hadamard multiplication
-        Grid& operator*=(const Grid& other) {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot perform a hadamard operation (multiplication) on grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other._rows, other._columns,
-                                _rows, _columns);
-            }
+        FORCE_INLINE T& back() const {
+            return _data[_size-1];
+        }
 
-            for (usize i = 0; i < size(); i++) {
-                matrix[i] *= other.matrix[i];
-            }
+        PointerIterator<T> begin() const {
+            return _data;
+        }
 
-            return this;
+        PointerIterator<T> end() const {
+            return _data+_size;
         }
+    };
 
+    //a column of a Grid (or of a SubGridView), consecutive elements are stride elements apart in memory,
+    //indexing isn't bounds checked, use at() for a checked access
+    template<typename T>
+    class ColumnView {
+        T* _data{nullptr};
+        usize _size{0};
+        usize _stride{1};
 
-        //hadamard multiplication
-        Grid multiply(const Grid& other) {
-            if (_rows != other._rows || _columns != other._columns) {
-                throw Exception("Cannot perform a hadamard operation (multiplication) on grids of different sizes.\n"
-                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other._rows, other._columns,
-                                _rows, _columns);
-            }
+    public:
+        ColumnView() = default;
 
-            Grid res = make(_rows, _columns);
-            res *= other;
+        ColumnView(T* data, const usize size, const usize stride) : _data(data), _size(size), _stride(stride) {}
 
-            return res;
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return _size;
         }
 
-        template<Arithmetic U>
-        Grid operator /(U scalar) {
-            Grid res = make(_rows, _columns);
-            for (usize i = 0; i < res.size(); i++) {
-                res.matrix[i] = matrix[i] / scalar;
-            }
+        [[nodiscard]] FORCE_INLINE usize stride() const {
+            return _stride;
+        }
 
-            return res;
+        [[nodiscard]] FORCE_INLINE bool empty() const {
+            return _size == 0;
         }
 
-        template<Arithmetic U>
-        Grid& operator /=(U scalar) {
+        FORCE_INLINE T& operator[](const usize ind) const {
+            return _data[ind*_stride];
+        }
 
-            for (usize i = 0; i < size(); i++) {
-                matrix[i] /= scalar;
-            }
+        FORCE_INLINE T& at(const usize ind) const {
+            AUXIL_CHECK_BOUNDS(ind >= _size, "{} out of range of a column with {} elements", ind, _size);
+            return _data[ind*_stride];
+        }
 
-            return *this;
+        FORCE_INLINE T& front() const {
+            return _data[0];
         }
 
-        //TODO: add hadamard division
+        FORCE_INLINE T& back() const {
+            return _data[(_size-1)*_stride];
+        }
+
+        StridedIterator<T> begin() const {
+            return {_data, 0, static_cast<std::ptrdiff_t>(_stride)};
+        }
+
+        StridedIterator<T> end() const {
+            return {_data, static_cast<std::ptrdiff_t>(_size), static_cast<std::ptrdiff_t>(_stride)};
+        }
     };
 
-    template<typename U, typename = std::enable_if_t<OstreamFormattable<U>>>
-        std::ostream& operator<<(std::ostream& os, const Grid<U>& self) {
-        os << '[';
-        for (usize r = 0; r < self._rows; r++) {
-            os << '[';
-            for (usize c = 0; c < self._columns; c++) {
-                os << self.matrix[r*self._columns + c];
-                if (c != self._columns-1) os << ", ";
+    namespace GridViewDetail {
+        //yields a RowView for every row of a rectangle that is stride elements wide in memory
+        template<typename T>
+        class RowIterator {
+            T* data{nullptr};
+            usize row{0}, columns{0}, stride{0};
+
+        public:
+            using value_type = RowView<T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = RowView<T>;
+            using iterator_category = std::forward_iterator_tag;
+
+            RowIterator() = default;
+
+            RowIterator(T* data, const usize row, const usize columns, const usize stride) :
+            data(data), row(row), columns(columns), stride(stride) {}
+
+            RowView<T> operator*() const {
+                return {data + row*stride, columns};
             }
-            os << ']';
-            if (r != self._rows-1) os << ", ";
-        }
-        os << ']';
 
-        return os;
-    }
+            RowIterator& operator++() {
+                ++row;
+                return *this;
+            }
 
+            RowIterator operator++(int) {
+                auto res = *this;
+                ++row;
+                return res;
+            }
 
-    /*
-     * A container designed to be a sort of
-     * Army swiss knife of linear containers that can grow, combining the allocation efficiency of a std::vector
-     * while also having the insertion, and removal speed of a linked list, random element access is still slower than
-     * a vector, but accessing the front and back elements is O(1) still with some simple data management
-     *
-     */
-    template<typename T, typename = std::enable_if_t<std::semiregular<T>>>
-    class LinkedList {
-    public:
-        static constexpr usize npos = std::numeric_limits<usize>::max();
-        struct Node {
-            T value{};
-            //indices into whatever is next or previous
-            usize prev{npos};
-            usize next{npos};
+            difference_type operator-(const RowIterator& other) const {
+                return static_cast<difference_type>(row) - static_cast<difference_type>(other.row);
+            }
 
-            void reset() {
-                value = T();
-                prev = npos;
-                next = npos;
+            bool operator==(const RowIterator& other) const {
+                return row == other.row;
             }
         };
-    private:
 
-        //makes it easier to manage memory allocation
-        //to make life easy, the start of the list will always be the first element, and likewise the last element
-        //will be right after it
-        //also, to make appending, popping, and other good stuff just as fast as a linked list, all empty elements
-        //will be moved to the back of the array by swapping their position with the current last element
-        Array<Node> nodes{};
-        usize length{0};
-        mutable usize cur_index{npos};
+        //yields a ColumnView for every column of a rectangle that is stride elements wide in memory
+        template<typename T>
+        class ColumnIterator {
+            T* data{nullptr};
+            usize column{0}, rows{0}, stride{0};
 
-        void swap(usize i1, usize i2) {
+        public:
+            using value_type = ColumnView<T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = ColumnView<T>;
+            using iterator_category = std::forward_iterator_tag;
 
-            if (cur_index == i1) cur_index = i2;
-            else if (cur_index == i2) cur_index = i1;
+            ColumnIterator() = default;
 
-            Node& one = nodes[i1];
-            Node& two = nodes[i2];
+            ColumnIterator(T* data, const usize column, const usize rows, const usize stride) :
+            data(data), column(column), rows(rows), stride(stride) {}
 
-            bool change2_prev{true};
-            bool change2_next{true};
+            ColumnView<T> operator*() const {
+                return {data + column, rows, stride};
+            }
 
+            ColumnIterator& operator++() {
+                ++column;
+                return *this;
+            }
 
-            if (one.next != npos) {
-                if (one.next == i2) {
-                    nodes[one.next].prev = i2;
-                    one.next = i1;
-                    change2_prev = false;
-                } else {
-                    nodes[one.next].prev = i2;
-                }
+            ColumnIterator operator++(int) {
+                auto res = *this;
+                ++column;
+                return res;
             }
-            if (one.prev != npos) {
-                if (one.prev == i2) {
-                    nodes[one.prev].next = i2;
-                    one.prev = i1;
-                    change2_next = false;
-                } else {
-                    nodes[one.prev].next = i2;
-                }
+
+            difference_type operator-(const ColumnIterator& other) const {
+                return static_cast<difference_type>(column) - static_cast<difference_type>(other.column);
             }
 
-            if (two.next != npos && change2_next) nodes[two.next].prev = i1;
-            if (two.prev != npos && change2_prev) nodes[two.prev].next = i1;
+            bool operator==(const ColumnIterator& other) const {
+                return column == other.column;
+            }
+        };
 
-            std::swap(one, two);
-        }
+        //every element of a rectangle in row major order
+        template<typename T>
+        class ElementIterator {
+            T* data{nullptr};
+            usize row{0}, column{0}, columns{0}, stride{0};
 
-        void destruct() {
-            length = 0;
-            cur_index = npos;
-        }
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+            using iterator_category = std::forward_iterator_tag;
 
-    public:
+            ElementIterator() = default;
 
-        ~LinkedList() {
-            destruct();
-        }
+            ElementIterator(T* data, const usize row, const usize columns, const usize stride) :
+            data(data), row(row), columns(columns), stride(stride) {}
 
-        LinkedList() = default;
+            reference operator*() const {
+                return data[row*stride + column];
+            }
 
-        LinkedList(const std::initializer_list<T>& elements) {
-            reserve(elements.size());
-            for (auto& element: elements) {
-                push_back(element);
+            pointer operator->() const {
+                return data + row*stride + column;
             }
-        }
 
-        template<typename It>
-        LinkedList(It start, It finish) {
-            while (start != finish) {
-                push_back(*start);
-                ++start;
+            ElementIterator& operator++() {
+                if (++column == columns) {
+                    column = 0;
+                    ++row;
+                }
+                return *this;
             }
-        }
 
-        LinkedList(const LinkedList& other) {
-            if (other.empty()) return;
-            reserve(other.length);
+            ElementIterator operator++(int) {
+                auto res = *this;
+                ++(*this);
+                return res;
+            }
 
-            usize node = 0;
-            while (node != npos) {
-                push_back(other.nodes[node].value);
-                node = other.nodes[node].next;
+            bool operator==(const ElementIterator& other) const {
+                return row == other.row && column == other.column;
+            }
+        };
+    }
+
+    /*
+     * A rectangular window into a Grid, it is stride elements between the start of one row and the next,
+     * it doesn't own or copy its elements, so it must not outlive the grid
+     * Element access isn't bounds checked, use at() for a checked access, making a view from a view is checked
+     */
+    template<typename T>
+    class SubGridView {
+        T* _data{nullptr};
+        usize _rows{0}, _columns{0}, _stride{0};
+
+        void require_in_range(const usize row, const usize column, const usize rows, const usize columns) const {
+            if (row + rows > _rows || column + columns > _columns) {
+                throw Exception("A {}x{} view at ({}, {}) is out of range of a {}x{} grid",
+                    rows, columns, row, column, _rows, _columns);
             }
         }
 
-        LinkedList(LinkedList&& other)  noexcept {
-            nodes = std::move(other.nodes);
-            length = other.length;
-            cur_index = other.cur_index;
-            other.destruct();
+    public:
+        SubGridView() = default;
+
+        SubGridView(T* data, const usize rows, const usize columns, const usize stride) :
+        _data(data), _rows(rows), _columns(columns), _stride(stride) {}
+
+        [[nodiscard]] FORCE_INLINE usize rows() const {
+            return _rows;
         }
 
-        LinkedList& operator=(const LinkedList& other) {
-            if (&other == this) return *this;
-            destruct();
-            if (other.empty()) return *this;
-            reserve(other.length);
+        [[nodiscard]] FORCE_INLINE usize columns() const {
+            return _columns;
+        }
 
-            usize node = 0;
-            while (node != npos) {
-                push_back(other.nodes[node].value);
-                node = other.nodes[node].next;
-            }
+        [[nodiscard]] FORCE_INLINE usize stride() const {
+            return _stride;
+        }
 
-            return *this;
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return _rows*_columns;
         }
 
-        LinkedList& operator=(LinkedList&& other) noexcept {
-            if (&other == this) return *this;
-            nodes = std::move(other.nodes);
-            length = other.length;
-            cur_index = other.cur_index;
-            other.destruct();
+        [[nodiscard]] FORCE_INLINE bool empty() const {
+            return _rows*_columns == 0;
+        }
 
-            return *this;
+        FORCE_INLINE T* data() const {
+            return _data;
         }
 
+        FORCE_INLINE T& operator()(const usize row, const usize column) const {
+            return _data[row*_stride + column];
+        }
 
+        FORCE_INLINE T& at(const usize row, const usize column) const {
+            AUXIL_CHECK_BOUNDS(row >= _rows || column >= _columns,
+                "({}, {}) out of range of a {}x{} grid", row, column, _rows, _columns);
+            return _data[row*_stride + column];
+        }
 
-        //reserves allocated memory
-        LinkedList& reserve(usize new_size) {
-            Array new_allocation = Array<Node>(new_size);
+        FORCE_INLINE RowView<T> operator[](const usize row) const {
+            return {_data + row*_stride, _columns};
+        }
 
-            auto rng = nodes | std::views::take(new_size);
-            std::ranges::move(rng, new_allocation.begin());
-            length = std::min(new_size, length);
+        RowView<T> row(const usize row) const {
+            require_in_range(row, 0, 1, _columns);
+            return {_data + row*_stride, _columns};
+        }
 
-            nodes = std::move(new_allocation);
+        ColumnView<T> column(const usize column) const {
+            require_in_range(0, column, _rows, 1);
+            return {_data + column, _rows, _stride};
+        }
 
-            return *this;
+        SubGridView sub_grid(const usize row, const usize column, const usize rows, const usize columns) const {
+            require_in_range(row, column, rows, columns);
+            return {_data + row*_stride + column, rows, columns, _stride};
         }
 
-        //reserves memory, but appends elements to the list
-        LinkedList& resize(usize new_size) {
-            if (new_size <= length) {
-                reserve(new_size);
-                return *this;
-            }
-            new_size -= length;
-            reserve(new_size+length);
+        GenericIterable<GridViewDetail::RowIterator<T>> row_views() const {
+            return {{_data, 0, _columns, _stride}, {_data, _rows, _columns, _stride}};
+        }
 
-            while (new_size-- > 0) {
-                push_back(T());
-            }
+        GenericIterable<GridViewDetail::ColumnIterator<T>> column_views() const {
+            return {{_data, 0, _rows, _stride}, {_data, _columns, _rows, _stride}};
+        }
 
-            return *this;
+        GridViewDetail::ElementIterator<T> begin() const {
+            return {_data, 0, _columns, _stride};
         }
 
-        //--------- Adding values -----------
+        GridViewDetail::ElementIterator<T> end() const {
+            return {_data, _columns == 0 ? 0 : _rows, _columns, _stride};
+        }
+    };
 
-        //appends a value to the end of the list
-        T& push_back(const T& value) {
-            if (length == nodes.size()) {
-                //ensures we get at least enough space for the new element
-                reserve(nodes.size()*2+1);
-            }
-            //if the array is empty, there is no 'back'
-            //if the array has just 1 element, then the back is also the front, so the zero'th element,
-            //if the array has 2 or more elements, then the back should be the first element so long as
-            //nothing has gone wrong
-            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
-            Node& n = nodes.emplace_at(length++, value, back_ind, npos);
+    //every lazy Grid expression derives from this, see GridExpr below
+    struct GridExpressionBase {};
 
-            //set it to 1 because we swap its current position with 1 later, if this is the only element currently added
-            //then the npos check will stop anything from happening,
-            if (back_ind != npos) nodes[back_ind].next = length-1;
+    template<typename E>
+    concept GridExpression = std::derived_from<std::remove_cvref_t<E>, GridExpressionBase>;
 
-            //this is to make sure we keep the last element in the second index
-            //this also will fix the fact that the back index which we pointed to previously has now changed and all
-            //references should stay consistent
-            if (length > 2) swap(1, length-1);
-
-            if (cur_index == npos) cur_index = 0;
-
-            //return the new value
-            return n.value;
-        }
-
-        //appends a value to the start of the list
-        T& push_front(const T& value) {
-            if (length == nodes.size()) {
-                //ensures we get at least enough space for the new element
-                reserve(nodes.size()*2+1);
+    namespace GridExprDetail {
+        inline void require_same_size(const usize rows, const usize columns, const usize other_rows,
+                                      const usize other_columns, const char* operation) {
+            if (rows != other_rows || columns != other_columns) {
+                throw Exception(std::string(operation) + " grids of different sizes.\n"
+                                "Note, right matrix had dimensions {}x{}, expected {}x{}", other_rows, other_columns,
+                                rows, columns);
             }
-            //if the array is empty, there is no 'back'
-            //if the array has 1 or more elements, then the front is index 0
-            //nothing has gone wrong
-            usize start_ind = length > 0 /*If not empty*/ ? 0 : npos;
-            Node& n = nodes.emplace_at(length++, value, npos, start_ind);
+        }
+    }
 
-            //set it to 1 because we swap its current position with 1 later, if this is the only element currently added
-            //then the npos check will stop anything from happening,
-            if (start_ind != npos) nodes[start_ind].prev = length-1;
+    //the elements come from a std::pmr::memory_resource the same way Array's do
+    template<typename T, typename = std::enable_if_t<std::semiregular<T>>>
+    class Grid {
+        T* matrix{nullptr};
+        usize _columns{0}, _rows{0};
+        std::pmr::memory_resource* _resource{nullptr};
 
-            //this is to make sure we keep the last element in the second index
-            //this also will fix the fact that the back index which we pointed to previously has now changed and all
-            //references should stay consistent
-            if (length > 1) swap(0, length-1);
 
-            if (cur_index == npos) cur_index = 0;
+        void initialize(const usize rows, const usize columns, bool default_initialize = false) {
+            matrix = MemoryDetail::allocate<T>(_resource, columns*rows);
+            this->_columns = columns;
+            this->_rows = rows;
 
-            //return the new value
-            return n.value;
+            if (default_initialize) {
+                std::uninitialized_value_construct_n(matrix, columns*rows);
+            }
         }
 
-        //moves a value to the end of the list
-        T& push_back(const T&& value) {
-            if (length == nodes.size()) {
-                //ensures we get at least enough space for the new element
-                reserve(nodes.size()*2+1);
+        void destruct() {
+            if (matrix) {
+                MemoryDetail::destroy(matrix, _columns*_rows);
+                MemoryDetail::deallocate(_resource, matrix, _columns*_rows);
             }
-            //if the array is empty, there is no 'back'
-            //if the array has just 1 element, then the back is also the front, so the zeroth element,
-            //if the array has 2 or more elements, then the back should be the first element so long as
-            //nothing has gone wrong
-            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
-            Node& n = nodes.emplace_at(length++, value, back_ind, npos);
-
-            //set it to length-1 because we swap its current position with 1 later, if this is the only element currently added
-            //then the npos check will stop anything from happening,
-            if (back_ind != npos) nodes[back_ind].next = length-1;
+            matrix = nullptr;
+            _columns = 0;
+            _rows = 0;
+        }
 
-            //this is to make sure we keep the last element in the second index
-            //this also will fix the fact that the back index which we pointed to previously has now changed and all
-            //references should stay consistent
-            if (length > 2)
-                swap(1, length-1);
 
-            if (cur_index == npos) cur_index = 0;
+        FORCE_INLINE static const T& element(const Grid& grid, const usize i) {
+            return grid.matrix[i];
+        }
 
-            //return the new value
-            return n.value;
+        template<GridExpression E>
+        FORCE_INLINE static decltype(auto) element(const E& expr, const usize i) {
+            return expr.evaluate(i);
         }
 
-        //moves a value to the start of the list
-        T& push_front(const T&& value) {
-            if (length == nodes.size()) {
-                //ensures we get at least enough space for the new element
-                reserve(nodes.size()*2+1);
-            }
-            //if the array is empty, there is no 'back'
-            //if the array has 1 or more elements, then the front is index 0
-            //nothing has gone wrong
-            usize start_ind = length > 0 /*If not empty*/ ? 0 : npos;
-            Node& n = nodes.emplace_at(length++, value, npos, start_ind);
+        FORCE_INLINE static Grid dot(const Grid& left, const Grid& right) {
 
-            //if this is the only element currently added then the npos check will stop anything from happening
-            if (start_ind != npos) nodes[start_ind].prev = length-1;
+            Grid result = make(left._rows, right._columns);
+            matmul(left.matrix, right.matrix, result.matrix, left._rows, left._columns, right._columns);
 
-            //this is to make sure we keep the last element in the second index
-            //this also will fix the fact that the back index which we pointed to previously has now changed and all
-            //references should stay consistent
-            if (length > 1) swap(0, length-1);
+            return result;
+        }
 
-            if (cur_index == npos) cur_index = 0;
+    public:
 
-            //return the new value
-            return n.value;
+        ~Grid() {
+            destruct();
         }
 
-        //pushes a value in front of the current node in the list
-        T& push_ahead(const T& value) {
-            if (length == nodes.size()) {
-                reserve(nodes.size()*2)+1;
-            }
-            Node* cur = nullptr;
-            if (cur_index != npos) cur = &nodes[cur_index];
-            Node& n = nodes.emplace_at(length++, value, cur_index, cur ? cur->next:npos);
-            if (cur) {
-                if (cur->next != npos) nodes[cur->next].prev = length-1;
-                cur->next = length-1;
-            }
-            //if this is the new end
-            if (n.next == npos && length > 2) {
-                swap(length-1, 1);
-            }
+        Grid() = default;
 
-            if (cur_index == npos) cur_index = 0;
+        explicit Grid(std::pmr::memory_resource* resource) : _resource(resource) {}
 
-            return n.value;
+        [[nodiscard]] static Grid make(const usize rows, const usize columns,
+                                       std::pmr::memory_resource* resource = nullptr) {
+            Grid res(resource);
+            res.initialize(rows, columns, true);
+
+            return res;
         }
 
-        //pushes a value in behind the current node in the list
-        T& push_behind(const T& value) {
-            if (length == nodes.size()) {
-                reserve(nodes.size()*2)+1;
-            }
-            Node* cur = nullptr;
-            if (cur_index != npos) cur = &nodes[cur_index];
-            Node& n = nodes.emplace_at(length++, value, cur ? cur->prev:npos, cur_index);
-            if (cur) {
-                if (cur->prev != npos) nodes[cur->prev].next = length-1;
-                cur->prev = length-1;
+
+        Grid(std::initializer_list<std::initializer_list<T>> init_list) {
+            auto it = init_list.begin();
+            initialize(init_list.size(), it->size(), true);
+            usize i = 0;
+            for (; it != init_list.end(); ++it) {
+                for (usize j = 0; j < it->size() && j < _columns; j++) {
+                    matrix[i++] = *((*it).begin()+j);
+                }
             }
-            //if this is the new beginning
-            if (n.prev == npos && length > 1) {
-                swap(length-1, 0);
+        }
+
+        Grid(const Grid& grid, std::pmr::memory_resource* resource = nullptr) : _resource(resource) {
+            if (grid._rows == 0) return;
+            initialize(grid._rows, grid._columns);
+
+            for (usize i = 0; i < grid.size(); i++) {
+                std::construct_at(&matrix[i], grid.matrix[i]);
             }
+        }
 
-            if (cur_index == npos) cur_index = 0;
+        Grid(Grid&& grid) noexcept {
+            if (grid._rows == 0) return;
 
-            return n.value;
+            matrix = grid.matrix;
+            _columns = grid._columns;
+            _rows = grid._rows;
+            _resource = grid._resource;
+            grid.matrix = nullptr;
+            grid.destruct();
         }
 
-        //moves a value in front of the current node in the list
-        T& push_ahead(const T&& value) {
-            if (length == nodes.size()) {
-                reserve(nodes.size()*2)+1;
-            }
-            Node* cur = nullptr;
-            if (cur_index != npos) cur = &nodes[cur_index];
-            Node& n = nodes.emplace_at(length++, value, cur_index, cur ? cur->next:npos);
-            if (cur) {
-                if (cur->next != npos) nodes[cur->next].prev = length-1;
-                cur->next = length-1;
+        //evaluates a lazy expression such as a + b - c / 2 in a single pass over the elements
+        template<GridExpression E>
+        Grid(const E& expr, std::pmr::memory_resource* resource = nullptr) : _resource(resource) {
+            if (expr.rows() == 0) return;
+            initialize(expr.rows(), expr.columns());
+
+            T* out = matrix;
+            const usize n = size();
+            //every element only reads the same index of its operands, which lets the whole expression vectorize
+#pragma GCC ivdep
+            for (usize i = 0; i < n; i++) {
+                std::construct_at(&out[i], static_cast<T>(expr.evaluate(i)));
             }
-            //if this is the new end
-            if (n.next == npos && length > 2) {
-                swap(length-1, 1);
+        }
+
+        Grid& operator=(const Grid& grid) noexcept {
+            if (grid._rows == 0) return *this;
+            if (&grid == this) return *this;
+            //same shape, so the storage (and the resource it came from) can be kept
+            if (matrix && _rows == grid._rows && _columns == grid._columns) {
+                std::copy_n(grid.matrix, size(), matrix);
+                return *this;
             }
 
-            if (cur_index == npos) cur_index = 0;
+            destruct();
 
-            return n.value;
-        }
+            initialize(grid._rows, grid._columns);
 
-        //moves a value in behind the current node in the list
-        T& push_behind(const T&& value) {
-            if (length == nodes.size()) {
-                reserve(nodes.size()*2)+1;
-            }
-            Node* cur = nullptr;
-            if (cur_index != npos) cur = &nodes[cur_index];
-            Node& n = nodes.emplace_at(length++, value, cur ? cur->prev:npos, cur_index);
-            if (cur) {
-                if (cur->prev != npos) nodes[cur->prev].next = length-1;
-                cur->prev = length-1;
-            }
-            //if this is the new beginning
-            if (n.prev == npos && length > 1) {
-                swap(length-1, 0);
+            for (usize i = 0; i < grid.size(); i++) {
+                std::construct_at(&matrix[i], grid.matrix[i]);
             }
 
-            if (cur_index == npos) cur_index = 0;
-
-            return n.value;
+            return *this;
         }
 
-        //--------- Removing Items -----------
+        Grid& operator=(Grid&& grid) noexcept {
+            if (grid._rows == 0) return *this;
+            if (&grid == this) return *this;
 
-        void remove_ahead() {
-            if (cur_index == npos) return;
-            Node* cur = &nodes[cur_index];
+            destruct();
 
-            Node* next = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
+            matrix = grid.matrix;
+            _rows = grid._rows;
+            _columns = grid._columns;
+            _resource = grid._resource;
+            grid.matrix = nullptr;
+            grid.destruct();
 
-            if (next) {
-                //swap references
-                usize nex_id = cur->next;
-                cur->next = next->next;
-                if (cur->next != npos) nodes[cur->next].prev = cur_index;
+            return *this;
+        }
 
-                //check if next was the previous back, and if so, make the cur index the back
-                if (next->next == npos) {
-                    usize back_ind = length > 1 ? 1 : 0;
-                    swap(cur_index, back_ind);
-                }
+        //writes the expression over the existing elements when the dimensions match, so it doesn't allocate,
+        //expressions are element-wise so it is fine for the expression to read from this grid
+        template<GridExpression E>
+        Grid& operator=(const E& expr) {
+            if (matrix == nullptr || _rows != expr.rows() || _columns != expr.columns()) {
+                return *this = Grid(expr, _resource);
+            }
 
-                //makes sure we don't accidentally use this node
-                next->reset();
-                //swap with the last element
-                swap(nex_id, length-1);
+            T* out = matrix;
+            const usize n = size();
+#pragma GCC ivdep
+            for (usize i = 0; i < n; i++) {
+                out[i] = static_cast<T>(expr.evaluate(i));
+            }
 
-                length--;
+            return *this;
+        }
+
+        template<typename... Args>
+        FORCE_INLINE T& emplace_at(usize row, usize column, Args&&... constructor) {
+            if (row >= _rows || column >= _columns) {
+                throw Exception("Cannot create element at ({}, {}) in Grid with dimensions {}x{}", column, row, _rows, _columns);
             }
+            std::destroy_at((matrix+row*_columns)+column);
+            auto& elem = *std::construct_at((matrix+row*_columns)+column, std::forward<Args>(constructor)...);
+            return elem;
         }
 
-        void remove_behind() {
-            if (cur_index == npos) return;
+        [[nodiscard]] FORCE_INLINE usize width() const {
+            return _columns;
+        }
 
-            Node* cur = &nodes[cur_index];
+        [[nodiscard]] FORCE_INLINE  usize height() const {
+            return _rows;
+        }
 
-            Node* prev = nullptr;
-            if (cur->prev != npos) prev = &nodes[cur->prev];
+        [[nodiscard]] FORCE_INLINE usize area() const {
+            return _rows*_columns;
+        }
 
-            if (prev) {
-                //swap references
-                usize prev_id = cur->prev;
-                cur->prev = prev->prev;
-                if (cur->prev != npos) nodes[cur->prev].next = cur_index;
+        [[nodiscard]] FORCE_INLINE usize columns() const {
+            return _columns;
+        }
 
-                //check if next was the previous start, and if so, make the cur index the back
-                if (prev->prev == npos) {
-                    swap(cur_index, 0);
-                }
+        [[nodiscard]] FORCE_INLINE  usize rows() const {
+            return _rows;
+        }
 
-                //makes sure we don't accidentally use this node
-                prev->reset();
-                //swap with the last element
-                swap(prev_id, length-1);
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return MemoryDetail::resolve(_resource);
+        }
 
-                length--;
+        [[nodiscard]] FORCE_INLINE  usize size() const {
+            return _rows*_columns;
+        }
+
+        FORCE_INLINE Array<T> at(const usize row_ind) const {
+            AUXIL_CHECK_BOUNDS(row_ind >= _rows, "{} out of range of Grid with {} rows", row_ind, _rows);
+            return Array<T>(matrix+(row_ind*_columns), _columns);
+        }
+
+        FORCE_INLINE T& at_flat(const usize ind) const {
+            AUXIL_CHECK_BOUNDS(ind >= _rows*_columns, "{} out of range of Grid with {} elements", ind, _rows*_columns);
+            return matrix[ind];
+        }
+
+        FORCE_INLINE Checked<T> try_at_flat(const usize ind) const noexcept {
+            if (ind >= _rows*_columns) [[unlikely]] return std::unexpected(std::errc::result_out_of_range);
+            return std::ref(matrix[ind]);
+        }
+
+        FORCE_INLINE Array<T> operator[](const usize row_ind) const {
+            AUXIL_CHECK_BOUNDS(row_ind >= _rows, "{} out of range of Grid with {} rows", row_ind, _rows);
+            return Array<T>(matrix+(row_ind*_columns), _columns);
+        }
+
+        //not bounds checked, for inner loops that already know their indices are in range
+        FORCE_INLINE T& operator()(const usize row, const usize column) const {
+            return matrix[row*_columns + column];
+        }
+
+        FORCE_INLINE T& at(const usize row, const usize column) const {
+            AUXIL_CHECK_BOUNDS(row >= _rows || column >= _columns,
+                "({}, {}) out of range of Grid with dimensions {}x{}", row, column, _rows, _columns);
+            return matrix[row*_columns + column];
+        }
+
+        FORCE_INLINE Checked<T> try_at(const usize row, const usize column) const noexcept {
+            if (row >= _rows || column >= _columns) [[unlikely]] return std::unexpected(std::errc::result_out_of_range);
+            return std::ref(matrix[row*_columns + column]);
+        }
+
+        //the views below are checked when they are made, not when their elements are accessed
+
+        [[nodiscard]] SubGridView<T> view() const {
+            return {matrix, _rows, _columns, _columns};
+        }
+
+        [[nodiscard]] RowView<T> row(const usize row_ind) const {
+            return view().row(row_ind);
+        }
+
+        [[nodiscard]] ColumnView<T> column(const usize column_ind) const {
+            return view().column(column_ind);
+        }
+
+        [[nodiscard]] SubGridView<T> sub_grid(const usize row, const usize column, const usize rows,
+                                              const usize columns) const {
+            return view().sub_grid(row, column, rows, columns);
+        }
+
+        [[nodiscard]] GenericIterable<GridViewDetail::RowIterator<T>> row_views() const {
+            return view().row_views();
+        }
+
+        [[nodiscard]] GenericIterable<GridViewDetail::ColumnIterator<T>> column_views() const {
+            return view().column_views();
+        }
+
+        FORCE_INLINE Array<T> front() const {
+            AUXIL_CHECK_BOUNDS(_rows == 0, "Cannot access front of empty grid");
+            return Array<T>(matrix, _columns);
+        }
+
+        FORCE_INLINE Array<T> back() const {
+            AUXIL_CHECK_BOUNDS(_rows == 0, "Cannot access back of empty grid");
+            return Array<T>(matrix+((_rows-1)*_columns), _columns);
+        }
+
+        FORCE_INLINE T& first() const {
+            AUXIL_CHECK_BOUNDS(_rows * _columns == 0, "Cannot access first element of a {}x{} grid", _rows, _columns);
+            return matrix[0];
+        }
+
+        FORCE_INLINE T& last() const {
+            AUXIL_CHECK_BOUNDS(_rows * _columns == 0, "Cannot access last element of a {}x{} grid", _rows, _columns);
+            return matrix[_rows*_columns-1];
+        }
+
+        FORCE_INLINE T* data() const {
+            return matrix;
+        }
+
+        PointerIterator<T> begin() const {
+            return matrix;
+        }
+
+        PointerIterator<T> end() const {
+            return matrix+(_rows*_columns);
+        }
+
+        ReversePointerIterator<T> rbegin() const {
+            return matrix+((_rows*_columns)-1);
+        }
+
+        ReversePointerIterator<T> rend() const {
+            return matrix-1;
+        }
+
+        [[nodiscard]] FORCE_INLINE bool empty() const {
+            return _rows*_columns == 0;
+        }
+
+        Grid& reset() {
+            for (usize i = 0; i < _rows*_columns; i++) {
+                matrix[i] = T();
             }
+
+            return *this;
         }
 
-        void remove_advance() {
-            if (cur_index == npos) return;
-            Node* cur = &nodes[cur_index];
-            Node* next = nullptr;
-            Node* prev = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
-            if (cur->prev != npos) prev = &nodes[cur->prev];
 
-            if (next) {
-                //first check if its the front
-                if (cur->prev == npos) {
-                    swap(cur->next, 0);
-                }
+        //+, - and multiply (and the scalar * and /) return a GridExpr instead of a Grid, see below
 
-                //replace references
-                next->prev = cur->prev;
-                if (prev) prev->next = cur->next;
+        template<typename E>
+        requires GridExpression<E> || std::same_as<E, Grid>
+        Grid& operator+=(const E& other) {
+            GridExprDetail::require_same_size(_rows, _columns, other.rows(), other.columns(), "Cannot add");
 
-                usize cind = cur_index;
-                cur_index = cur->next;
+            for (usize i = 0; i < size(); i++) {
+                matrix[i] += element(other, i);
+            }
 
-                cur->reset();
+            return *this;
+        }
 
-                //move to the back
-                swap(cind, length-1);
-            } else if (prev) {
-                //cur must be the last node
-                swap(cur->prev, length > 1 ? 1 : 0);
 
+        template<typename E>
+        requires GridExpression<E> || std::same_as<E, Grid>
+        Grid& operator-=(const E& other) {
+            GridExprDetail::require_same_size(_rows, _columns, other.rows(), other.columns(), "Cannot subtract");
 
-                //we dont have to update next because its null
-                prev->next = npos;
+            for (usize i = 0; i < size(); i++) {
+                matrix[i] -= element(other, i);
+            }
 
-                usize cind = cur_index;
-                //advance to the __void__
-                cur_index = npos;
+            return *this;
+        }
 
-                cur->reset();
 
-                //move to the back
-                swap(cind, length-1);
-            } else {
-                cur->reset();
-                cur_index = npos;
+
+
+        FORCE_INLINE Grid dot(const Grid& right) const {
+            if (_columns != right._rows) {
+                if (right._columns == _rows) return dot(right, *this);
+                throw Exception("Cannot compute the dot product of grids where the columns of one"
+                                " does not equal the number of rows of the other\n"
+                                "Left: {}x{}, Right: {}x{}", _rows, _columns, right._rows, right._columns);
             }
-            length--;
+
+            return dot(*this, right);
         }
 
-        void remove_retreat() {
-            if (cur_index == npos) return;
 
-            Node* cur = &nodes[cur_index];
 
-            Node* next = nullptr;
-            Node* prev = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
-            if (cur->prev != npos) prev = &nodes[cur->prev];
+        Grid operator*(const Grid& other) const {
+            return dot(other);
+        }
 
-            if (prev) {
-                //first check if it's the back
-                if (cur->next == npos) {
-                    swap(cur->next, length > 1 ? 1 : 0);
+
+        //this one does a hadamard multiplication
+        template<typename E>
+        requires GridExpression<E> || std::same_as<E, Grid>
+        Grid& operator*=(const E& other) {
+            GridExprDetail::require_same_size(_rows, _columns, other.rows(), other.columns(),
+                "Cannot perform a hadamard operation (multiplication) on");
+
+            for (usize i = 0; i < size(); i++) {
+                matrix[i] *= element(other, i);
+            }
+
+            return *this;
+        }
+
+
+        //lazy hadamard multiplication, a temporary grid is moved into the expression
+        template<typename E>
+        requires GridExpression<E> || std::same_as<std::remove_cvref_t<E>, Grid>
+        auto multiply(E&& other) const & {
+            return hadamard(*this, std::forward<E>(other));
+        }
+
+        template<typename E>
+        requires GridExpression<E> || std::same_as<std::remove_cvref_t<E>, Grid>
+        auto multiply(E&& other) && {
+            return hadamard(std::move(*this), std::forward<E>(other));
+        }
+
+        template<Arithmetic U>
+        Grid& operator *=(U scalar) {
+
+            for (usize i = 0; i < size(); i++) {
+                matrix[i] *= scalar;
+            }
+
+            return *this;
+        }
+
+        template<Arithmetic U>
+        Grid& operator /=(U scalar) {
+
+            for (usize i = 0; i < size(); i++) {
+                matrix[i] /= scalar;
+            }
+
+            return *this;
+        }
+
+        //TODO: add hadamard division
+    };
+
+    template<GridExpression E>
+    Grid(const E&) -> Grid<typename E::value_type>;
+
+    template<typename G>
+    struct is_grid : std::false_type {};
+
+    template<typename T, typename E>
+    struct is_grid<Grid<T, E>> : std::true_type {};
+
+    //anything that can be an operand of a lazy grid expression
+    template<typename G>
+    concept GridOperand = GridExpression<G> || is_grid<std::remove_cvref_t<G>>::value;
+
+    namespace GridExprDetail {
+        //a grid that is only read from, it has to outlive the expression
+        template<typename T>
+        struct Ref {
+            using value_type = T;
+            const T* data;
+            usize _rows, _columns;
+
+            [[nodiscard]] FORCE_INLINE const T& evaluate(const usize i) const {
+                return data[i];
+            }
+
+            [[nodiscard]] FORCE_INLINE usize rows() const { return _rows; }
+            [[nodiscard]] FORCE_INLINE usize columns() const { return _columns; }
+        };
+
+        //a temporary grid moved into the expression so that something like a.dot(b) + c can't dangle
+        template<typename T>
+        struct Owned {
+            using value_type = T;
+            Grid<T> grid;
+
+            [[nodiscard]] FORCE_INLINE const T& evaluate(const usize i) const {
+                return grid.data()[i];
+            }
+
+            [[nodiscard]] FORCE_INLINE usize rows() const { return grid.rows(); }
+            [[nodiscard]] FORCE_INLINE usize columns() const { return grid.columns(); }
+        };
+
+        template<Arithmetic U>
+        struct Scalar {
+            using value_type = U;
+            U value;
+
+            [[nodiscard]] FORCE_INLINE U evaluate(usize) const {
+                return value;
+            }
+        };
+
+        template<typename W>
+        struct is_scalar : std::false_type {};
+
+        template<Arithmetic U>
+        struct is_scalar<Scalar<U>> : std::true_type {};
+
+        //lvalue grids are referenced, temporary grids are owned and expressions are stored by value
+        template<GridOperand G>
+        auto wrap(G&& operand) {
+            using D = std::remove_cvref_t<G>;
+            if constexpr (GridExpression<D>) {
+                return D(std::forward<G>(operand));
+            } else {
+                using T = std::remove_cvref_t<decltype(*operand.data())>;
+                if constexpr (std::is_lvalue_reference_v<G>) {
+                    return Ref<T>{operand.data(), operand.rows(), operand.columns()};
+                } else {
+                    return Owned<T>{std::move(operand)};
                 }
+            }
+        }
+    }
 
-                //replace references
-                prev->next = cur->next;
-                if (next) next->prev = cur->prev;
+    /*
+     * An element-wise operation on grids that is only computed once it is assigned to a Grid (or eval() is called),
+     * so a + b - c / 2 runs as one loop with one allocation, or none when assigned to a grid of the same size
+     * Grids used by an expression are held by reference, so an expression stored with auto must not outlive them
+     * Like the in-place operators the result keeps the element type of the left grid (the right one for scalar * grid),
+     * so Grid<u8> + Grid<u8> is still a Grid<u8> and Grid<f32> * 0.5 is still a Grid<f32>
+     */
+    template<typename Op, typename L, typename R>
+    class GridExpr : public GridExpressionBase {
+        L left;
+        R right;
+        usize _rows, _columns;
 
-                usize cind = cur_index;
-                cur_index = cur->prev;
+    public:
+        using value_type = std::conditional_t<GridExprDetail::is_scalar<L>::value,
+            typename R::value_type, typename L::value_type>;
 
-                cur->reset();
+        GridExpr(L left, R right, const usize rows, const usize columns) :
+        left(std::move(left)), right(std::move(right)), _rows(rows), _columns(columns) {}
 
-                //move to the back
-                swap(cind, length-1);
-            } else if (next) {
-                //cur must be the first node
-                swap(cur->next, 0);
+        //the element at index i as if though the data were a continuous array, not bounds checked
+        [[nodiscard]] FORCE_INLINE value_type evaluate(const usize i) const {
+            return static_cast<value_type>(Op{}(left.evaluate(i), right.evaluate(i)));
+        }
+
+        [[nodiscard]] FORCE_INLINE usize rows() const {
+            return _rows;
+        }
+
+        [[nodiscard]] FORCE_INLINE usize columns() const {
+            return _columns;
+        }
+
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return _rows*_columns;
+        }
+
+        [[nodiscard]] Grid<value_type> eval() const {
+            return Grid<value_type>(*this);
+        }
+
+        template<GridOperand E>
+        auto multiply(E&& other) const & {
+            return hadamard(*this, std::forward<E>(other));
+        }
+
+        template<GridOperand E>
+        auto multiply(E&& other) && {
+            return hadamard(std::move(*this), std::forward<E>(other));
+        }
+    };
+
+    namespace GridExprDetail {
+        template<typename Op, GridOperand L, GridOperand R>
+        auto binary(L&& l, R&& r, const char* operation) {
+            auto lw = wrap(std::forward<L>(l));
+            auto rw = wrap(std::forward<R>(r));
+            require_same_size(lw.rows(), lw.columns(), rw.rows(), rw.columns(), operation);
+
+            const usize rows = lw.rows(), columns = lw.columns();
+            return GridExpr<Op, decltype(lw), decltype(rw)>(std::move(lw), std::move(rw), rows, columns);
+        }
+    }
+
+    template<GridOperand L, GridOperand R>
+    auto operator+(L&& left, R&& right) {
+        return GridExprDetail::binary<std::plus<>>(std::forward<L>(left), std::forward<R>(right), "Cannot add");
+    }
+
+    template<GridOperand L, GridOperand R>
+    auto operator-(L&& left, R&& right) {
+        return GridExprDetail::binary<std::minus<>>(std::forward<L>(left), std::forward<R>(right), "Cannot subtract");
+    }
+
+    //element-wise multiplication, a * b on two grids is the dot product
+    template<GridOperand L, GridOperand R>
+    auto hadamard(L&& left, R&& right) {
+        return GridExprDetail::binary<std::multiplies<>>(std::forward<L>(left), std::forward<R>(right),
+            "Cannot perform a hadamard operation (multiplication) on");
+    }
+
+    template<GridOperand L, Arithmetic U>
+    auto operator*(L&& left, const U scalar) {
+        auto lw = GridExprDetail::wrap(std::forward<L>(left));
+        const usize rows = lw.rows(), columns = lw.columns();
+        return GridExpr<std::multiplies<>, decltype(lw), GridExprDetail::Scalar<U>>(std::move(lw), {scalar}, rows, columns);
+    }
+
+    template<Arithmetic U, GridOperand R>
+    auto operator*(const U scalar, R&& right) {
+        auto rw = GridExprDetail::wrap(std::forward<R>(right));
+        const usize rows = rw.rows(), columns = rw.columns();
+        return GridExpr<std::multiplies<>, GridExprDetail::Scalar<U>, decltype(rw)>({scalar}, std::move(rw), rows, columns);
+    }
+
+    template<GridOperand L, Arithmetic U>
+    auto operator/(L&& left, const U scalar) {
+        auto lw = GridExprDetail::wrap(std::forward<L>(left));
+        const usize rows = lw.rows(), columns = lw.columns();
+        return GridExpr<std::divides<>, decltype(lw), GridExprDetail::Scalar<U>>(std::move(lw), {scalar}, rows, columns);
+    }
+
+    template<typename U, typename = std::enable_if_t<OstreamFormattable<U>>>
+        std::ostream& operator<<(std::ostream& os, const Grid<U>& self) {
+        os << '[';
+        for (usize r = 0; r < self._rows; r++) {
+            os << '[';
+            for (usize c = 0; c < self._columns; c++) {
+                os << self.matrix[r*self._columns + c];
+                if (c != self._columns-1) os << ", ";
+            }
+            os << ']';
+            if (r != self._rows-1) os << ", ";
+        }
+        os << ']';
+
+        return os;
+    }
+
+
+    /*
+     * A container designed to be a sort of
+     * Army swiss knife of linear containers that can grow, combining the allocation efficiency of a std::vector
+     * while also having the insertion, and removal speed of a linked list, random element access is still slower than
+     * a vector, but accessing the front and back elements is O(1) still with some simple data management
+     *
+     */
+    template<typename T, typename = std::enable_if_t<std::semiregular<T>>>
+    class LinkedList {
+    public:
+        static constexpr usize npos = std::numeric_limits<usize>::max();
+        struct Node {
+            T value{};
+            //indices into whatever is next or previous
+            usize prev{npos};
+            usize next{npos};
+
+            void reset() {
+                value = T();
+                prev = npos;
+                next = npos;
+            }
+        };
+    private:
+
+        //makes it easier to manage memory allocation
+        //to make life easy, the start of the list will always be the first element, and likewise the last element
+        //will be right after it
+        //also, to make appending, popping, and other good stuff just as fast as a linked list, all empty elements
+        //will be moved to the back of the array by swapping their position with the current last element
+        Array<Node> nodes{};
+        usize length{0};
+        mutable usize cur_index{npos};
+
+        void swap(usize i1, usize i2) {
+
+            if (cur_index == i1) cur_index = i2;
+            else if (cur_index == i2) cur_index = i1;
+
+            Node& one = nodes[i1];
+            Node& two = nodes[i2];
+
+            bool change2_prev{true};
+            bool change2_next{true};
+
+
+            if (one.next != npos) {
+                if (one.next == i2) {
+                    nodes[one.next].prev = i2;
+                    one.next = i1;
+                    change2_prev = false;
+                } else {
+                    nodes[one.next].prev = i2;
+                }
+            }
+            if (one.prev != npos) {
+                if (one.prev == i2) {
+                    nodes[one.prev].next = i2;
+                    one.prev = i1;
+                    change2_next = false;
+                } else {
+                    nodes[one.prev].next = i2;
+                }
+            }
+
+            if (two.next != npos && change2_next) nodes[two.next].prev = i1;
+            if (two.prev != npos && change2_prev) nodes[two.prev].next = i1;
+
+            std::swap(one, two);
+        }
+
+        void destruct() {
+            length = 0;
+            cur_index = npos;
+        }
+
+    public:
+
+        ~LinkedList() {
+            destruct();
+        }
+
+        LinkedList() = default;
+
+        //the nodes are allocated from resource
+        explicit LinkedList(std::pmr::memory_resource* resource) : nodes(resource) {}
+
+        LinkedList(const std::initializer_list<T>& elements) {
+            reserve(elements.size());
+            for (auto& element: elements) {
+                push_back(element);
+            }
+        }
+
+        template<typename It>
+        LinkedList(It start, It finish) {
+            while (start != finish) {
+                push_back(*start);
+                ++start;
+            }
+        }
+
+        LinkedList(const LinkedList& other) {
+            if (other.empty()) return;
+            reserve(other.length);
+
+            usize node = 0;
+            while (node != npos) {
+                push_back(other.nodes[node].value);
+                node = other.nodes[node].next;
+            }
+        }
+
+        LinkedList(LinkedList&& other)  noexcept {
+            nodes = std::move(other.nodes);
+            length = other.length;
+            cur_index = other.cur_index;
+            other.destruct();
+        }
+
+        LinkedList& operator=(const LinkedList& other) {
+            if (&other == this) return *this;
+            destruct();
+            if (other.empty()) return *this;
+            reserve(other.length);
+
+            usize node = 0;
+            while (node != npos) {
+                push_back(other.nodes[node].value);
+                node = other.nodes[node].next;
+            }
+
+            return *this;
+        }
+
+        LinkedList& operator=(LinkedList&& other) noexcept {
+            if (&other == this) return *this;
+            nodes = std::move(other.nodes);
+            length = other.length;
+            cur_index = other.cur_index;
+            other.destruct();
+
+            return *this;
+        }
+
+
+
+        //reserves allocated memory
+        LinkedList& reserve(usize new_size) {
+            Array new_allocation = Array<Node>(new_size, nodes.resource());
+
+            auto rng = nodes | std::views::take(new_size);
+            std::ranges::move(rng, new_allocation.begin());
+            length = std::min(new_size, length);
+
+            nodes = std::move(new_allocation);
+
+            return *this;
+        }
+
+        //reserves memory, but appends elements to the list
+        LinkedList& resize(usize new_size) {
+            if (new_size <= length) {
+                reserve(new_size);
+                return *this;
+            }
+            new_size -= length;
+            reserve(new_size+length);
+
+            while (new_size-- > 0) {
+                push_back(T());
+            }
+
+            return *this;
+        }
+
+        //--------- Adding values -----------
+
+        //appends a value to the end of the list
+        T& push_back(const T& value) {
+            if (length == nodes.size()) {
+                //ensures we get at least enough space for the new element
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            //if the array is empty, there is no 'back'
+            //if the array has just 1 element, then the back is also the front, so the zero'th element,
+            //if the array has 2 or more elements, then the back should be the first element so long as
+            //nothing has gone wrong
+            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
+            Node& n = nodes.emplace_at(length++, value, back_ind, npos);
+
+            //set it to 1 because we swap its current position with 1 later, if this is the only element currently added
+            //then the npos check will stop anything from happening,
+            if (back_ind != npos) nodes[back_ind].next = length-1;
+
+            //this is to make sure we keep the last element in the second index
+            //this also will fix the fact that the back index which we pointed to previously has now changed and all
+            //references should stay consistent
+            if (length > 2) swap(1, length-1);
+
+            if (cur_index == npos) cur_index = 0;
+
+            //return the new value
+            return n.value;
+        }
+
+        //appends a value to the start of the list
+        T& push_front(const T& value) {
+            if (length == nodes.size()) {
+                //ensures we get at least enough space for the new element
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            //if the array is empty, there is no 'back'
+            //if the array has 1 or more elements, then the front is index 0
+            //nothing has gone wrong
+            usize start_ind = length > 0 /*If not empty*/ ? 0 : npos;
+            Node& n = nodes.emplace_at(length++, value, npos, start_ind);
+
+            //set it to 1 because we swap its current position with 1 later, if this is the only element currently added
+            //then the npos check will stop anything from happening,
+            if (start_ind != npos) nodes[start_ind].prev = length-1;
+
+            //this is to make sure we keep the last element in the second index
+            //this also will fix the fact that the back index which we pointed to previously has now changed and all
+            //references should stay consistent
+            if (length > 1) swap(0, length-1);
+
+            if (cur_index == npos) cur_index = 0;
+
+            //return the new value
+            return n.value;
+        }
+
+        //moves a value to the end of the list
+        T& push_back(const T&& value) {
+            if (length == nodes.size()) {
+                //ensures we get at least enough space for the new element
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            //if the array is empty, there is no 'back'
+            //if the array has just 1 element, then the back is also the front, so the zeroth element,
+            //if the array has 2 or more elements, then the back should be the first element so long as
+            //nothing has gone wrong
+            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
+            Node& n = nodes.emplace_at(length++, value, back_ind, npos);
+
+            //set it to length-1 because we swap its current position with 1 later, if this is the only element currently added
+            //then the npos check will stop anything from happening,
+            if (back_ind != npos) nodes[back_ind].next = length-1;
+
+            //this is to make sure we keep the last element in the second index
+            //this also will fix the fact that the back index which we pointed to previously has now changed and all
+            //references should stay consistent
+            if (length > 2)
+                swap(1, length-1);
+
+            if (cur_index == npos) cur_index = 0;
+
+            //return the new value
+            return n.value;
+        }
+
+        //moves a value to the start of the list
+        T& push_front(const T&& value) {
+            if (length == nodes.size()) {
+                //ensures we get at least enough space for the new element
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            //if the array is empty, there is no 'back'
+            //if the array has 1 or more elements, then the front is index 0
+            //nothing has gone wrong
+            usize start_ind = length > 0 /*If not empty*/ ? 0 : npos;
+            Node& n = nodes.emplace_at(length++, value, npos, start_ind);
+
+            //if this is the only element currently added then the npos check will stop anything from happening
+            if (start_ind != npos) nodes[start_ind].prev = length-1;
+
+            //this is to make sure we keep the last element in the second index
+            //this also will fix the fact that the back index which we pointed to previously has now changed and all
+            //references should stay consistent
+            if (length > 1) swap(0, length-1);
+
+            if (cur_index == npos) cur_index = 0;
+
+            //return the new value
+            return n.value;
+        }
+
+        //pushes a value in front of the current node in the list
+        T& push_ahead(const T& value) {
+            if (length == nodes.size()) {
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            Node* cur = nullptr;
+            if (cur_index != npos) cur = &nodes[cur_index];
+            Node& n = nodes.emplace_at(length++, value, cur_index, cur ? cur->next:npos);
+            if (cur) {
+                if (cur->next != npos) nodes[cur->next].prev = length-1;
+                cur->next = length-1;
+            }
+            //if this is the new end
+            if (n.next == npos && length > 2) {
+                swap(length-1, 1);
+            }
+
+            if (cur_index == npos) cur_index = 0;
+
+            return n.value;
+        }
+
+        //pushes a value in behind the current node in the list
+        T& push_behind(const T& value) {
+            if (length == nodes.size()) {
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            Node* cur = nullptr;
+            if (cur_index != npos) cur = &nodes[cur_index];
+            Node& n = nodes.emplace_at(length++, value, cur ? cur->prev:npos, cur_index);
+            if (cur) {
+                if (cur->prev != npos) nodes[cur->prev].next = length-1;
+                cur->prev = length-1;
+            }
+            //if this is the new beginning
+            if (n.prev == npos && length > 1) {
+                swap(length-1, 0);
+            }
+
+            if (cur_index == npos) cur_index = 0;
+
+            return n.value;
+        }
+
+        //moves a value in front of the current node in the list
+        T& push_ahead(const T&& value) {
+            if (length == nodes.size()) {
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            Node* cur = nullptr;
+            if (cur_index != npos) cur = &nodes[cur_index];
+            Node& n = nodes.emplace_at(length++, value, cur_index, cur ? cur->next:npos);
+            if (cur) {
+                if (cur->next != npos) nodes[cur->next].prev = length-1;
+                cur->next = length-1;
+            }
+            //if this is the new end
+            if (n.next == npos && length > 2) {
+                swap(length-1, 1);
+            }
+
+            if (cur_index == npos) cur_index = 0;
+
+            return n.value;
+        }
+
+        //moves a value in behind the current node in the list
+        T& push_behind(const T&& value) {
+            if (length == nodes.size()) {
+                reserve(MemoryDetail::grow_capacity(nodes.size(), length+1));
+            }
+            Node* cur = nullptr;
+            if (cur_index != npos) cur = &nodes[cur_index];
+            Node& n = nodes.emplace_at(length++, value, cur ? cur->prev:npos, cur_index);
+            if (cur) {
+                if (cur->prev != npos) nodes[cur->prev].next = length-1;
+                cur->prev = length-1;
+            }
+            //if this is the new beginning
+            if (n.prev == npos && length > 1) {
+                swap(length-1, 0);
+            }
+
+            if (cur_index == npos) cur_index = 0;
+
+            return n.value;
+        }
+
+        //--------- Removing Items -----------
+
+        void remove_ahead() {
+            if (cur_index == npos) return;
+            Node* cur = &nodes[cur_index];
+
+            Node* next = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+
+            if (next) {
+                //swap references
+                usize nex_id = cur->next;
+                cur->next = next->next;
+                if (cur->next != npos) nodes[cur->next].prev = cur_index;
+
+                //check if next was the previous back, and if so, make the cur index the back
+                if (next->next == npos) {
+                    usize back_ind = length > 1 ? 1 : 0;
+                    swap(cur_index, back_ind);
+                }
+
+                //makes sure we don't accidentally use this node
+                next->reset();
+                //swap with the last element
+                swap(nex_id, length-1);
+
+                length--;
+            }
+        }
+
+        void remove_behind() {
+            if (cur_index == npos) return;
+
+            Node* cur = &nodes[cur_index];
+
+            Node* prev = nullptr;
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (prev) {
+                //swap references
+                usize prev_id = cur->prev;
+                cur->prev = prev->prev;
+                if (cur->prev != npos) nodes[cur->prev].next = cur_index;
+
+                //check if next was the previous start, and if so, make the cur index the back
+                if (prev->prev == npos) {
+                    swap(cur_index, 0);
+                }
+
+                //makes sure we don't accidentally use this node
+                prev->reset();
+                //swap with the last element
+                swap(prev_id, length-1);
+
+                length--;
+            }
+        }
+
+        void remove_advance() {
+            if (cur_index == npos) return;
+            Node* cur = &nodes[cur_index];
+            Node* next = nullptr;
+            Node* prev = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (next) {
+                //first check if its the front
+                if (cur->prev == npos) {
+                    swap(cur->next, 0);
+                }
+
+                //replace references
+                next->prev = cur->prev;
+                if (prev) prev->next = cur->next;
+
+                usize cind = cur_index;
+                cur_index = cur->next;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else if (prev) {
+                //cur must be the last node
+                swap(cur->prev, length > 1 ? 1 : 0);
+
+
+                //we dont have to update next because its null
+                prev->next = npos;
+
+                usize cind = cur_index;
+                //advance to the __void__
+                cur_index = npos;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else {
+                cur->reset();
+                cur_index = npos;
+            }
+            length--;
+        }
+
+        void remove_retreat() {
+            if (cur_index == npos) return;
+
+            Node* cur = &nodes[cur_index];
+
+            Node* next = nullptr;
+            Node* prev = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (prev) {
+                //first check if it's the back
+                if (cur->next == npos) {
+                    swap(cur->next, length > 1 ? 1 : 0);
+                }
+
+                //replace references
+                prev->next = cur->next;
+                if (next) next->prev = cur->prev;
+
+                usize cind = cur_index;
+                cur_index = cur->prev;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else if (next) {
+                //cur must be the first node
+                swap(cur->next, 0);
+
+
+                //we don't have to update prev because its null
+                next->prev = npos;
+
+                usize cind = cur_index;
+
+                //advance to the __void__
+                cur_index = npos;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else {
+                cur->reset();
+                cur_index = npos;
+            }
+            length--;
+        }
+
+        T pop_ahead() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            Node* cur = &nodes[cur_index];
+            T res = std::move(cur->value);
+            Node* next = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+
+            if (next) {
+                //swap references
+                usize nex_id = cur->next;
+                cur->next = next->next;
+                if (cur->next != npos) nodes[cur->next].prev = cur_index;
+
+                //check if next was the previous back, and if so, make the cur index the back
+                if (next->next == npos) {
+                    usize back_ind = length > 1 ? 1 : 0;
+                    swap(cur_index, back_ind);
+                }
+
+                //makes sure we don't accidentally use this node
+                next->reset();
+                //swap with the last element
+                swap(nex_id, length-1);
+
+                length--;
+            }
+
+            return res;
+        }
+
+        T pop_behind() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            Node* cur = &nodes[cur_index];
+            T res = std::move(cur->value);
+            Node* prev = nullptr;
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (prev) {
+                //swap references
+                usize prev_id = cur->prev;
+                cur->prev = prev->prev;
+                if (cur->prev != npos) nodes[cur->prev].next = cur_index;
+
+                //check if next was the previous start, and if so, make the cur index the back
+                if (prev->prev == npos) {
+                    swap(cur_index, 0);
+                }
+
+                //makes sure we don't accidentally use this node
+                prev->reset();
+                //swap with the last element
+                swap(prev_id, length-1);
+
+                length--;
+            }
+
+            return res;
+        }
+
+        //pops this node and attempts to advance to the next node
+        T pop_advance() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            Node* cur = &nodes[cur_index];
+            T res = std::move(cur->value);
+            Node* next = nullptr;
+            Node* prev = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (next) {
+                //first check if its the front
+                if (cur->prev == npos) {
+                    swap(cur->next, 0);
+                }
+
+                //replace references
+                next->prev = cur->prev;
+                if (prev) prev->next = cur->next;
+
+                usize cind = cur_index;
+                cur_index = cur->next;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else if (prev) {
+                //cur must be the last node
+                swap(cur->prev, length > 1 ? 1 : 0);
+
+
+                //we dont have to update next because its null
+                prev->next = npos;
+
+                usize cind = cur_index;
+                //advance to the __void__
+                cur_index = npos;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else {
+                cur->reset();
+                cur_index = npos;
+            }
+            length--;
+            return res;
+        }
+
+        //pops this node and attempts to retreat to the previous node
+        T pop_retreat() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            Node* cur = &nodes[cur_index];
+            T res = std::move(cur->value);
+            Node* next = nullptr;
+            Node* prev = nullptr;
+            if (cur->next != npos) next = &nodes[cur->next];
+            if (cur->prev != npos) prev = &nodes[cur->prev];
+
+            if (prev) {
+                //first check if it's the back
+                if (cur->next == npos) {
+                    swap(cur->next, length > 1 ? 1 : 0);
+                }
+
+                //replace references
+                prev->next = cur->next;
+                if (next) next->prev = cur->prev;
+
+                usize cind = cur_index;
+                cur_index = cur->prev;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else if (next) {
+                //cur must be the first node
+                swap(cur->next, 0);
+
+
+                //we don't have to update prev because its null
+                next->prev = npos;
+
+                usize cind = cur_index;
+
+                //advance to the __void__
+                cur_index = npos;
+
+                cur->reset();
+
+                //move to the back
+                swap(cind, length-1);
+            } else {
+                cur->reset();
+                cur_index = npos;
+            }
+            length--;
+            return res;
+        }
+
+
+        //pops the back of the list, if the current node is the back, it goes to npos
+        T pop_back() {
+            if (cur_index == npos) throw Exception("Cannot pop back of empty linked list!");
+
+            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
+
+
+
+            Node* back{nullptr};
+            if (back_ind != npos) back = &nodes[back_ind];
+            else return *this;
+            T res = std::move(back->value);
+
+            if (back_ind == cur_index) cur_index = npos;
+
+            //move this back to the end
+            swap(back_ind, length-1);
+            back = &nodes[length-1];
+
+            //move its previous node to the "back"
+            if (back->prev != npos) swap(back->prev, back_ind);
+
+            back->reset();
+
+            length--;
+
+            return res;
+        }
+
+        //pops the front of the list, if the current node is the front, it goes to npos
+        T pop_front() {
+            if (cur_index == npos) throw Exception("Cannot pop front of empty linked list!");
+
+            Node* front{nullptr};
+            front = &nodes[0];
+            T res = std::move(front->value);
+
+            if (cur_index == 0) cur_index = npos;
+
+            //move this front to the end
+            swap(0, length-1);
+            front = &nodes[length-1];
+
+            //move its previous node to the front
+            if (front->next != npos) swap(front->next, 0);
+
+            front->reset();
+
+            length--;
+
+            return res;
+        }
+
+        bool try_pop_ahead(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_ahead();
+            return true;
+        }
+
+        bool try_pop_behind(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_behind();
+            return true;
+        }
+
+        bool try_pop_advance(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_advance();
+            return true;
+        }
+
+        bool try_pop_retreat(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_retreat();
+            return true;
+        }
+
+        bool try_pop_front(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_front();
+            return true;
+        }
+
+        bool try_pop_back(T& out) {
+            if (cur_index == npos) {
+                return false;
+            }
+            out = pop_back();
+            return true;
+        }
+
+        LinkedList& clear() {
+            for (auto& node: nodes) {
+                node.reset();
+            }
+
+            length = 0;
+            cur_index = npos;
+
+            return *this;
+        }
+
+        //--------- Navigating List -----------
+
+        void advance() const {
+            if (cur_index == npos) return;
+
+            cur_index = nodes[cur_index].next;
+            return;
+        }
+
+        void retreat() const {
+            if (cur_index == npos) return;
+
+            cur_index = nodes[cur_index].prev;
+            return;
+        }
+
+        void advance(usize amt) const {
+            while (cur_index != npos && amt-- > 0) {
+                cur_index = nodes[cur_index].next;
+            }
+
+            return;
+        }
+
+        void retreat(usize amt) const {
+            while (cur_index != npos && amt-- > 0) {
+                cur_index = nodes[cur_index].prev;
+            }
+
+            return;
+        }
+
+        LinkedList& advance() {
+            if (cur_index == npos) return  *this;
+
+            cur_index = nodes[cur_index].next;
+            return *this;
+        }
+
+        LinkedList& retreat() {
+            if (cur_index == npos) return  *this;
+
+            cur_index = nodes[cur_index].prev;
+            return  *this;
+        }
+
+        LinkedList& advance(usize amt) {
+
+            while (cur_index != npos && amt-- > 0) {
+                cur_index = nodes[cur_index].next;
+            }
+
+            return *this;
+        }
+
+        LinkedList& retreat(usize amt) {
+
+            while (cur_index != npos && amt-- > 0) {
+                cur_index = nodes[cur_index].prev;
+            }
+
+            return *this;
+        }
+
+        bool valid() {
+            return cur_index != npos;
+        }
+
+        void to_front() const {
+            if (cur_index == npos) return;
+
+            cur_index = 0;
+            return;
+        }
+
+        void to_back() const {
+            if (cur_index == npos) return;
+
+            if (length == 1) return;
+            cur_index = 1;
+        }
+
+        LinkedList& to_front() {
+            if (cur_index == npos) return *this;
+
+            cur_index = 0;
+            return *this;
+        }
+
+        LinkedList& to_back() {
+            if (cur_index == npos) return *this;
+
+            if (length == 1) return *this;
+            cur_index = 1;
+            return *this;
+        }
+
+        //--------- Retrieving values -----------
+
+        T& front() const {
+            if (length == 0) throw Exception("Cannot access front of empty linked list!");
+
+            return nodes[0].value;
+        }
+
+        T& back() const {
+            if (length == 0) throw Exception("Cannot access back of empty linked list!");
+
+            usize b = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
+
+            return nodes[b].value;
+        }
+
+        T& get() const {
+            if (cur_index == npos) throw Exception("Cannot access current element of empty linked list!");
+            return nodes[cur_index].value;
+        }
+
+        //--------- List Data Management ----------
+
+        [[nodiscard]] usize size() const {
+            return length;
+        }
+
+        [[nodiscard]] bool has_next() const {
+            return cur_index != npos && nodes[cur_index].next != npos;
+        }
+
+        [[nodiscard]] bool has_prev() const {
+            return cur_index != npos && nodes[cur_index].prev != npos;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return cur_index == npos;
+        }
+
+        LinkedList& shrink_to_fit() {
+            reserve(length);
+
+            return *this;
+        }
+
+        //access the internal Nodes data array
+        Array<Node> data() const {
+            return nodes;
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return nodes.resource();
+        }
+
+
+        usize get_node_index() const {
+            return cur_index;
+        }
+
+        //--------- Iterators ----------
+        //the funny part is a linked list basically is an iterator, for speed however
+        //and separation of ideas, ill make a different iterator
+
+        struct Iterator {
+        private:
+            LinkedList* llist{nullptr};
+            usize node_index{npos};
+
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+            using iterator_category = std::random_access_iterator_tag;
+
+            Iterator() = default;
+
+            explicit Iterator(LinkedList& llist) : llist(&llist), node_index(llist.empty() ? npos:0) {}
+            explicit Iterator(LinkedList& llist, usize ind) : llist(&llist), node_index(llist.empty() ? npos:ind) {}
+
+            reference operator*() const {
+                if (node_index == npos) throw Exception("Invalid access of Linked List via Iterator\n"
+                                                        "Note: attempted to dereference a iterator to a empty list");
+                return llist->nodes[node_index].value;
+            }
+
+            pointer operator->() const {
+                if (node_index == npos) return nullptr;
+                return &llist->nodes[node_index].value;
+            }
+
+            Iterator& operator++() {
+                if (node_index == npos) return *this;
+                node_index = llist->nodes[node_index].next;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                if (node_index == npos) return *this;
+
+                Iterator res = *this;
+                node_index = llist->nodes[node_index].next;
+
+                return res;
+            }
+
+            Iterator& operator--() {
+                if (node_index == npos) return *this;
+                node_index = llist->nodes[node_index].prev;
+
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                if (node_index == npos) return *this;
+
+                Iterator res = *this;
+                node_index = llist->nodes[node_index].prev;
+
+                return res;
+            }
+
+            [[nodiscard]] bool is_valid() const {
+                return node_index != npos;
+            }
+
+            std::strong_ordering operator<=>(const Iterator &it) const {
+                if (it.llist != llist) return llist <=> it.llist;
+                return node_index <=> it.node_index;
+            }
+
+            bool operator==(const Iterator&) const = default;
+            bool operator!=(const Iterator&) const = default;
+            bool operator>(const Iterator&) const = default;
+            bool operator<(const Iterator&) const = default;
+            bool operator>=(const Iterator&) const = default;
+            bool operator<=(const Iterator&) const = default;
+        };
+
+        //returns a forward iterator starting here
+        Iterator current() {
+            return Iterator(*this, cur_index);
+        }
+
+        Iterator begin() {
+            return Iterator(*this);
+        }
+
+        Iterator end() {
+            return Iterator(*this, npos);
+        }
+
+        template<OstreamFormattable U>
+        friend std::ostream& operator<<(std::ostream& os, const LinkedList<U>& llist);
+        friend ::std::formatter<LinkedList, char>;
+
+    };
+
+
+
+
+    template<OstreamFormattable U>
+    std::ostream& operator<<(std::ostream& os, const LinkedList<U>& llist) {
+        if (llist.empty()) {
+            os << "[]";
+            return os;
+        }
+        os << "[";
+        usize node = 0;
+        const Array<typename LinkedList<U>::Node>* nodes = &llist.nodes;
+        usize max_iterations = llist.size()+1;
+
+        //print all the nodes leading up to the current index
+        while (node != llist.get_node_index() && max_iterations > 0) {
+            os << nodes->at(node).value;
+            node = nodes->at(node).next;
+            os << " <- ";
+            --max_iterations;
+        }
+
+        //print the current node
+        os << nodes->at(node).value;
+        --max_iterations;
+        node = nodes->at(node).next;
+        while (node != LinkedList<U>::npos && max_iterations > 0) {
+            os << " -> " << nodes->at(node).value;
+            node = nodes->at(node).next;
+            --max_iterations;
+        }
+        os << "]";
 
+        return os;
+    }
 
-                //we don't have to update prev because its null
-                next->prev = npos;
+    namespace ListDetail {
+        //an implicit treap over the slots of a CompactLinkedList, ordered by list position, every node knows the
+        //size of its subtree and its parent, so a slot's position and the slot at a position are both O(log n)
+        template<std::unsigned_integral Index>
+        class PositionTree {
+            static constexpr Index npos = std::numeric_limits<Index>::max();
+            struct Node {
+                Index left{npos};
+                Index right{npos};
+                Index parent{npos};
+                Index size{1};
+                u32 priority{0};
+            };
+
+            Array<Node> nodes{};
+            Index root{npos};
+            u64 seed{0x9E3779B97F4A7C15ULL};
+
+            u32 next_priority() {
+                //splitmix64
+                u64 z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return static_cast<u32>(z ^ (z >> 31));
+            }
+
+            [[nodiscard]] Index size_of(const Index t) const {
+                return t == npos ? 0 : nodes.data()[t].size;
+            }
+
+            void update(const Index t) {
+                Node* n = nodes.data();
+                n[t].size = static_cast<Index>(1 + size_of(n[t].left) + size_of(n[t].right));
+                if (n[t].left != npos) n[n[t].left].parent = t;
+                if (n[t].right != npos) n[n[t].right].parent = t;
+            }
+
+            //splits t into its first k nodes and the rest
+            std::pair<Index, Index> split(const Index t, const usize k) {
+                if (t == npos) return {npos, npos};
+                Node* n = nodes.data();
+                if (size_of(n[t].left) >= k) {
+                    auto [a, b] = split(n[t].left, k);
+                    n[t].left = b;
+                    update(t);
+                    if (a != npos) n[a].parent = npos;
+                    return {a, t};
+                }
+                auto [a, b] = split(n[t].right, k - size_of(n[t].left) - 1);
+                n[t].right = a;
+                update(t);
+                if (b != npos) n[b].parent = npos;
+                return {t, b};
+            }
+
+            Index merge(const Index a, const Index b) {
+                if (a == npos) return b;
+                if (b == npos) return a;
+                Node* n = nodes.data();
+                if (n[a].priority > n[b].priority) {
+                    n[a].right = merge(n[a].right, b);
+                    update(a);
+                    return a;
+                }
+                n[b].left = merge(a, n[b].left);
+                update(b);
+                return b;
+            }
 
-                usize cind = cur_index;
+            Index recount(const Index t) {
+                if (t == npos) return 0;
+                Node* n = nodes.data();
+                n[t].size = static_cast<Index>(1 + recount(n[t].left) + recount(n[t].right));
+                return n[t].size;
+            }
 
-                //advance to the __void__
-                cur_index = npos;
+            void set_root(const Index t) {
+                root = t;
+                if (t != npos) nodes.data()[t].parent = npos;
+            }
 
-                cur->reset();
+        public:
+            //keeps the first used slots when the list grows or shrinks
+            void resize(const usize capacity, const usize used, std::pmr::memory_resource* resource) {
+                Array<Node> new_nodes(capacity, resource);
+                std::copy_n(nodes.data(), std::min(used, capacity), new_nodes.data());
+                nodes = std::move(new_nodes);
+            }
 
-                //move to the back
-                swap(cind, length-1);
-            } else {
-                cur->reset();
-                cur_index = npos;
+            void clear() {
+                root = npos;
             }
-            length--;
-        }
 
-        T pop_ahead() {
-            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
-            Node* cur = &nodes[cur_index];
-            T res = std::move(cur->value);
-            Node* next = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
+            //puts slot x at position k
+            void insert(const Index x, const usize k) {
+                nodes.data()[x] = {npos, npos, npos, 1, next_priority()};
+                auto [a, b] = split(root, k);
+                set_root(merge(merge(a, x), b));
+            }
 
-            if (next) {
-                //swap references
-                usize nex_id = cur->next;
-                cur->next = next->next;
-                if (cur->next != npos) nodes[cur->next].prev = cur_index;
+            void erase(const Index x) {
+                Node* n = nodes.data();
+                //a node's children merged in place of it, then the sizes above it are one smaller
+                const Index parent = n[x].parent;
+                const Index sub = merge(n[x].left, n[x].right);
 
-                //check if next was the previous back, and if so, make the cur index the back
-                if (next->next == npos) {
-                    usize back_ind = length > 1 ? 1 : 0;
-                    swap(cur_index, back_ind);
+                if (parent == npos) {
+                    set_root(sub);
+                } else {
+                    if (n[parent].left == x) n[parent].left = sub;
+                    else n[parent].right = sub;
+                    if (sub != npos) n[sub].parent = parent;
+                    for (Index p = parent; p != npos; p = n[p].parent) n[p].size--;
                 }
+            }
 
-                //makes sure we don't accidentally use this node
-                next->reset();
-                //swap with the last element
-                swap(nex_id, length-1);
+            [[nodiscard]] usize position_of(Index x) const {
+                const Node* n = nodes.data();
+                usize pos = size_of(n[x].left);
+                for (Index p = n[x].parent; p != npos; x = p, p = n[p].parent) {
+                    if (n[p].right == x) pos += size_of(n[p].left) + 1;
+                }
+                return pos;
+            }
+
+            [[nodiscard]] Index slot_at(usize k) const {
+                const Node* n = nodes.data();
+                Index t = root;
+                while (t != npos) {
+                    const usize left = size_of(n[t].left);
+                    if (k < left) {
+                        t = n[t].left;
+                    } else if (k == left) {
+                        return t;
+                    } else {
+                        k -= left + 1;
+                        t = n[t].right;
+                    }
+                }
+                return npos;
+            }
+
+            //rebuilds the tree for a list stored in order in slots [0, count), in O(n)
+            void build(const usize count) {
+                Node* n = nodes.data();
+                std::vector<Index> spine;
+                for (usize s = 0; s < count; s++) {
+                    const auto i = static_cast<Index>(s);
+                    n[i] = {npos, npos, npos, 1, next_priority()};
+
+                    //the right spine of the tree so far, the new node goes on the end of it
+                    Index last = npos;
+                    while (!spine.empty() && n[spine.back()].priority < n[i].priority) {
+                        last = spine.back();
+                        spine.pop_back();
+                    }
+                    n[i].left = last;
+                    if (last != npos) n[last].parent = i;
+                    if (!spine.empty()) {
+                        n[spine.back()].right = i;
+                        n[i].parent = spine.back();
+                    }
+                    spine.push_back(i);
+                }
 
-                length--;
+                root = spine.empty() ? npos : spine.front();
+                recount(root);
             }
+        };
 
-            return res;
-        }
+        //what a CompactLinkedList holds instead of a PositionTree when it isn't indexed
+        struct NoPositionTree {};
+    }
 
-        T pop_behind() {
-            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
-            Node* cur = &nodes[cur_index];
-            T res = std::move(cur->value);
-            Node* prev = nullptr;
-            if (cur->prev != npos) prev = &nodes[cur->prev];
+    /*
+     * the same cursor based list as LinkedList with a layout built for traversal, links are Index sized (32 bits
+     * by default) and kept in their own array apart from the values, and removed slots go onto an intrusive free
+     * list instead of being swapped to the back, so every insertion and removal is O(1) and never moves another
+     * node, compact() re-orders the nodes into traversal order once a long-lived list gets fragmented
+     *
+     * with Indexed the list also keeps a positional index, which gives O(log n) at(i), insert_at(i) and erase_at(i),
+     * navigating and reading the front, back and current node stay O(1), but every insertion and removal becomes
+     * O(log n) because it has to update the index too
+     */
+    template<typename T, std::unsigned_integral Index = u32, bool Indexed = false,
+             typename = std::enable_if_t<std::semiregular<T>>>
+    class CompactLinkedList {
+    public:
+        static constexpr Index npos = std::numeric_limits<Index>::max();
+        struct Link {
+            Index prev{npos};
+            //the next node, or the next free slot for slots on the free list
+            Index next{npos};
+        };
+    private:
+        Array<T> values{};
+        Array<Link> links{};
+        Index head{npos};
+        Index tail{npos};
+        //the first slot on the free list
+        Index free_head{npos};
+        //slots past this have never been handed out, so they don't need to be on the free list
+        Index used{0};
+        usize length{0};
+        mutable Index cur_index{npos};
+        [[no_unique_address]] std::conditional_t<Indexed, ListDetail::PositionTree<Index>, ListDetail::NoPositionTree> tree{};
 
-            if (prev) {
-                //swap references
-                usize prev_id = cur->prev;
-                cur->prev = prev->prev;
-                if (cur->prev != npos) nodes[cur->prev].next = cur_index;
+        [[noreturn]] static void throw_full() {
+            throw Exception("CompactLinkedList cannot hold more than {} elements", static_cast<usize>(npos) - 1);
+        }
 
-                //check if next was the previous start, and if so, make the cur index the back
-                if (prev->prev == npos) {
-                    swap(cur_index, 0);
-                }
+        void grow(const usize new_capacity) {
+            if (new_capacity >= npos) throw_full();
+            Array<T> new_values(new_capacity, values.resource());
+            Array<Link> new_links(new_capacity, links.resource());
 
-                //makes sure we don't accidentally use this node
-                prev->reset();
-                //swap with the last element
-                swap(prev_id, length-1);
+            T* src = values.data();
+            T* dst = new_values.data();
+            for (Index i = 0; i < used; i++) dst[i] = std::move(src[i]);
+            std::copy_n(links.data(), used, new_links.data());
+            if constexpr (Indexed) tree.resize(new_capacity, used, links.resource());
 
-                length--;
+            values = std::move(new_values);
+            links = std::move(new_links);
+        }
+
+        template<typename U>
+        Index allocate(U&& value) {
+            Index i;
+            if (free_head != npos) {
+                i = free_head;
+                free_head = links.data()[i].next;
+            } else {
+                if (used == links.size()) {
+                    //npos marks the end of a chain, so only npos-1 slots can ever be named
+                    if (static_cast<usize>(used) + 1 >= npos) throw_full();
+                    grow(std::min<usize>(MemoryDetail::grow_capacity(links.size(), used+1), npos-1));
+                }
+                i = used++;
             }
+            values.data()[i] = std::forward<U>(value);
+            length++;
+            return i;
+        }
 
+        T release(const Index i) {
+            T res = std::move(values.data()[i]);
+            values.data()[i] = T();
+            links.data()[i] = {npos, free_head};
+            free_head = i;
+            length--;
             return res;
         }
 
-        //pops this node and attempts to advance to the next node
-        T pop_advance() {
-            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
-            Node* cur = &nodes[cur_index];
-            T res = std::move(cur->value);
-            Node* next = nullptr;
-            Node* prev = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
-            if (cur->prev != npos) prev = &nodes[cur->prev];
-
-            if (next) {
-                //first check if its the front
-                if (cur->prev == npos) {
-                    swap(cur->next, 0);
-                }
+        //puts node i between prev and next, either of which may be npos
+        void link(const Index i, const Index prev, const Index next) {
+            if constexpr (Indexed) {
+                //length already counts i, so the back is a position that doesn't need looking up
+                tree.insert(i, prev == npos ? 0 : next == npos ? length - 1 : tree.position_of(prev) + 1);
+            }
+            Link* l = links.data();
+            l[i] = {prev, next};
+            if (prev != npos) l[prev].next = i;
+            else head = i;
+            if (next != npos) l[next].prev = i;
+            else tail = i;
+        }
 
-                //replace references
-                next->prev = cur->prev;
-                if (prev) prev->next = cur->next;
+        void unlink(const Index i) {
+            if constexpr (Indexed) tree.erase(i);
+            Link* l = links.data();
+            const Link node = l[i];
+            if (node.prev != npos) l[node.prev].next = node.next;
+            else head = node.next;
+            if (node.next != npos) l[node.next].prev = node.prev;
+            else tail = node.prev;
+        }
 
-                usize cind = cur_index;
-                cur_index = cur->next;
+        template<typename U>
+        Index insert_node(U&& value, const Index prev, const Index next) {
+            const Index i = allocate(std::forward<U>(value));
+            link(i, prev, next);
+            if (cur_index == npos) cur_index = head;
+            return i;
+        }
 
-                cur->reset();
+        template<typename U>
+        T& insert_between(U&& value, const Index prev, const Index next) {
+            //the insert may grow the arrays, so data() has to be read after it
+            const Index i = insert_node(std::forward<U>(value), prev, next);
+            return values.data()[i];
+        }
 
-                //move to the back
-                swap(cind, length-1);
-            } else if (prev) {
-                //cur must be the last node
-                swap(cur->prev, length > 1 ? 1 : 0);
+        T remove(const Index i) {
+            unlink(i);
+            return release(i);
+        }
 
+        void destruct() {
+            head = tail = free_head = npos;
+            used = 0;
+            length = 0;
+            cur_index = npos;
+            if constexpr (Indexed) tree.clear();
+        }
 
-                //we dont have to update next because its null
-                prev->next = npos;
+        [[nodiscard]] Index slot_at(const usize i) const {
+            if (i >= length) throw Exception("Cannot access element at index {} of a linked list with {} elements", i, length);
+            return tree.slot_at(i);
+        }
 
-                usize cind = cur_index;
-                //advance to the __void__
-                cur_index = npos;
+    public:
+        CompactLinkedList() = default;
 
-                cur->reset();
+        //the values, links and index are allocated from resource
+        explicit CompactLinkedList(std::pmr::memory_resource* resource) : values(resource), links(resource) {}
 
-                //move to the back
-                swap(cind, length-1);
-            } else {
-                cur->reset();
-                cur_index = npos;
+        CompactLinkedList(const std::initializer_list<T>& elements) {
+            reserve(elements.size());
+            for (auto& element: elements) {
+                push_back(element);
             }
-            length--;
-            return res;
         }
 
-        //pops this node and attempts to retreat to the previous node
-        T pop_retreat() {
-            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
-            Node* cur = &nodes[cur_index];
-            T res = std::move(cur->value);
-            Node* next = nullptr;
-            Node* prev = nullptr;
-            if (cur->next != npos) next = &nodes[cur->next];
-            if (cur->prev != npos) prev = &nodes[cur->prev];
-
-            if (prev) {
-                //first check if it's the back
-                if (cur->next == npos) {
-                    swap(cur->next, length > 1 ? 1 : 0);
-                }
+        template<typename It>
+        CompactLinkedList(It start, It finish) {
+            while (start != finish) {
+                push_back(*start);
+                ++start;
+            }
+        }
 
-                //replace references
-                prev->next = cur->next;
-                if (next) next->prev = cur->prev;
+        CompactLinkedList(const CompactLinkedList&) = default;
+        CompactLinkedList& operator=(const CompactLinkedList&) = default;
 
-                usize cind = cur_index;
-                cur_index = cur->prev;
+        CompactLinkedList(CompactLinkedList&& other) noexcept :
+            values(std::move(other.values)), links(std::move(other.links)), head(other.head), tail(other.tail),
+            free_head(other.free_head), used(other.used), length(other.length), cur_index(other.cur_index),
+            tree(std::move(other.tree)) {
+            other.destruct();
+        }
 
-                cur->reset();
+        CompactLinkedList& operator=(CompactLinkedList&& other) noexcept {
+            if (&other == this) return *this;
+            values = std::move(other.values);
+            links = std::move(other.links);
+            head = other.head;
+            tail = other.tail;
+            free_head = other.free_head;
+            used = other.used;
+            length = other.length;
+            cur_index = other.cur_index;
+            tree = std::move(other.tree);
+            other.destruct();
 
-                //move to the back
-                swap(cind, length-1);
-            } else if (next) {
-                //cur must be the first node
-                swap(cur->next, 0);
+            return *this;
+        }
 
+        //reserves memory for at least new_size nodes, never shrinks the list
+        CompactLinkedList& reserve(const usize new_size) {
+            if (new_size > links.size()) grow(new_size);
+            return *this;
+        }
 
-                //we don't have to update prev because its null
-                next->prev = npos;
+        //appends default values until the list has new_size elements, or pops the back until it does
+        CompactLinkedList& resize(const usize new_size) {
+            while (length > new_size) pop_back();
+            reserve(new_size);
+            while (length < new_size) push_back(T());
 
-                usize cind = cur_index;
+            return *this;
+        }
 
-                //advance to the __void__
-                cur_index = npos;
+        //--------- Adding values -----------
 
-                cur->reset();
+        T& push_back(const T& value) {
+            return insert_between(value, tail, npos);
+        }
 
-                //move to the back
-                swap(cind, length-1);
-            } else {
-                cur->reset();
-                cur_index = npos;
-            }
-            length--;
-            return res;
+        T& push_back(T&& value) {
+            return insert_between(std::move(value), tail, npos);
         }
 
+        T& push_front(const T& value) {
+            return insert_between(value, npos, head);
+        }
 
-        //pops the back of the list, if the current node is the back, it goes to npos
-        T pop_back() {
-            if (cur_index == npos) throw Exception("Cannot pop back of empty linked list!");
+        T& push_front(T&& value) {
+            return insert_between(std::move(value), npos, head);
+        }
 
-            usize back_ind = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
+        //pushes a value in front of the current node, or to the back if there is no current node
+        T& push_ahead(const T& value) {
+            if (cur_index == npos) return push_back(value);
+            return insert_between(value, cur_index, links.data()[cur_index].next);
+        }
 
+        T& push_ahead(T&& value) {
+            if (cur_index == npos) return push_back(std::move(value));
+            return insert_between(std::move(value), cur_index, links.data()[cur_index].next);
+        }
 
+        //pushes a value behind the current node, or to the front if there is no current node
+        T& push_behind(const T& value) {
+            if (cur_index == npos) return push_front(value);
+            return insert_between(value, links.data()[cur_index].prev, cur_index);
+        }
 
-            Node* back{nullptr};
-            if (back_ind != npos) back = &nodes[back_ind];
-            else return *this;
-            T res = std::move(back->value);
+        T& push_behind(T&& value) {
+            if (cur_index == npos) return push_front(std::move(value));
+            return insert_between(std::move(value), links.data()[cur_index].prev, cur_index);
+        }
 
-            if (back_ind == cur_index) cur_index = npos;
+        //--------- Removing Items -----------
 
-            //move this back to the end
-            swap(back_ind, length-1);
-            back = &nodes[length-1];
+        //removes the node ahead of the current node, returns its value
+        T pop_ahead() {
+            if (!has_next()) throw Exception("Cannot pop the element ahead of the current node, there is none!");
+            return remove(links.data()[cur_index].next);
+        }
 
-            //move its previous node to the "back"
-            if (back->prev != npos) swap(back->prev, back_ind);
+        //removes the node behind the current node, returns its value
+        T pop_behind() {
+            if (!has_prev()) throw Exception("Cannot pop the element behind the current node, there is none!");
+            return remove(links.data()[cur_index].prev);
+        }
 
-            back->reset();
+        //pops the current node and moves to the next one, or npos if it was the back
+        T pop_advance() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            const Index i = cur_index;
+            cur_index = links.data()[i].next;
+            return remove(i);
+        }
 
-            length--;
+        //pops the current node and moves to the previous one, or npos if it was the front
+        T pop_retreat() {
+            if (cur_index == npos) throw Exception("Cannot pop element of empty linked list!");
+            const Index i = cur_index;
+            cur_index = links.data()[i].prev;
+            return remove(i);
+        }
 
-            return res;
+        //pops the back of the list, if the current node is the back, it goes to npos
+        T pop_back() {
+            if (length == 0) throw Exception("Cannot pop back of empty linked list!");
+            if (cur_index == tail) cur_index = npos;
+            return remove(tail);
         }
 
         //pops the front of the list, if the current node is the front, it goes to npos
-        T pop_front() {
-            if (cur_index == npos) throw Exception("Cannot pop front of empty linked list!");
-
-            Node* front{nullptr};
-            front = &nodes[0];
-            T res = std::move(front->value);
-
-            if (cur_index == 0) cur_index = npos;
-
-            //move this front to the end
-            swap(0, length-1);
-            front = &nodes[length-1];
+        T pop_front() {
+            if (length == 0) throw Exception("Cannot pop front of empty linked list!");
+            if (cur_index == head) cur_index = npos;
+            return remove(head);
+        }
 
-            //move its previous node to the front
-            if (front->next != npos) swap(front->next, 0);
+        void remove_ahead() {
+            if (has_next()) remove(links.data()[cur_index].next);
+        }
 
-            front->reset();
+        void remove_behind() {
+            if (has_prev()) remove(links.data()[cur_index].prev);
+        }
 
-            length--;
+        void remove_advance() {
+            if (cur_index != npos) pop_advance();
+        }
 
-            return res;
+        void remove_retreat() {
+            if (cur_index != npos) pop_retreat();
         }
 
         bool try_pop_ahead(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (!has_next()) return false;
             out = pop_ahead();
             return true;
         }
 
         bool try_pop_behind(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (!has_prev()) return false;
             out = pop_behind();
             return true;
         }
 
         bool try_pop_advance(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (cur_index == npos) return false;
             out = pop_advance();
             return true;
         }
 
         bool try_pop_retreat(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (cur_index == npos) return false;
             out = pop_retreat();
             return true;
         }
 
         bool try_pop_front(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (length == 0) return false;
             out = pop_front();
             return true;
         }
 
         bool try_pop_back(T& out) {
-            if (cur_index == npos) {
-                return false;
-            }
+            if (length == 0) return false;
             out = pop_back();
             return true;
         }
 
-        LinkedList& clear() {
-            for (auto& node: nodes) {
-                node.reset();
-            }
-
-            length = 0;
-            cur_index = npos;
+        CompactLinkedList& clear() {
+            T* v = values.data();
+            for (Index i = 0; i < used; i++) v[i] = T();
+            destruct();
 
             return *this;
         }
 
-        //--------- Navigating List -----------
-
-        void advance() const {
-            if (cur_index == npos) return;
-
-            cur_index = nodes[cur_index].next;
-            return;
-        }
-
-        void retreat() const {
-            if (cur_index == npos) return;
-
-            cur_index = nodes[cur_index].prev;
-            return;
-        }
-
-        void advance(usize amt) const {
-            while (cur_index != npos && amt-- > 0) {
-                cur_index = nodes[cur_index].next;
-            }
+        //re-orders the nodes so that the list is stored in traversal order from slot 0 and the free list is empty,
+        //after this iterating the list walks its values sequentially in memory, the current node is kept
+        CompactLinkedList& compact() {
+            Array<T> new_values(links.size(), values.resource());
+            Array<Link> new_links(links.size(), links.resource());
+            T* src = values.data();
+            T* dst = new_values.data();
+            const Link* l = links.data();
+            Link* nl = new_links.data();
+
+            Index new_cur = npos;
+            Index k = 0;
+            for (Index i = head; i != npos; i = l[i].next, k++) {
+                if (i == cur_index) new_cur = k;
+                dst[k] = std::move(src[i]);
+                nl[k] = {k == 0 ? npos : static_cast<Index>(k-1), k+1 == length ? npos : static_cast<Index>(k+1)};
+            }
+
+            values = std::move(new_values);
+            links = std::move(new_links);
+            head = length > 0 ? 0 : npos;
+            tail = length > 0 ? static_cast<Index>(length-1) : npos;
+            free_head = npos;
+            used = k;
+            cur_index = new_cur;
+            if constexpr (Indexed) tree.build(length);
 
-            return;
+            return *this;
         }
 
-        void retreat(usize amt) const {
-            while (cur_index != npos && amt-- > 0) {
-                cur_index = nodes[cur_index].prev;
+        //compacts the list and drops the memory it isn't using
+        CompactLinkedList& shrink_to_fit() {
+            compact();
+            if (links.size() != length) {
+                grow(length);
             }
 
-            return;
-        }
-
-        LinkedList& advance() {
-            if (cur_index == npos) return  *this;
-
-            cur_index = nodes[cur_index].next;
             return *this;
         }
 
-        LinkedList& retreat() {
-            if (cur_index == npos) return  *this;
+        //--------- Navigating List -----------
 
-            cur_index = nodes[cur_index].prev;
-            return  *this;
+        void advance(usize amt = 1) const {
+            const Link* l = links.data();
+            while (cur_index != npos && amt-- > 0) {
+                cur_index = l[cur_index].next;
+            }
         }
 
-        LinkedList& advance(usize amt) {
-
+        void retreat(usize amt = 1) const {
+            const Link* l = links.data();
             while (cur_index != npos && amt-- > 0) {
-                cur_index = nodes[cur_index].next;
+                cur_index = l[cur_index].prev;
             }
+        }
 
+        CompactLinkedList& advance(usize amt = 1) {
+            std::as_const(*this).advance(amt);
             return *this;
         }
 
-        LinkedList& retreat(usize amt) {
-
-            while (cur_index != npos && amt-- > 0) {
-                cur_index = nodes[cur_index].prev;
-            }
-
+        CompactLinkedList& retreat(usize amt = 1) {
+            std::as_const(*this).retreat(amt);
             return *this;
         }
 
-        bool valid() {
+        [[nodiscard]] bool valid() const {
             return cur_index != npos;
         }
 
         void to_front() const {
-            if (cur_index == npos) return;
-
-            cur_index = 0;
-            return;
+            cur_index = head;
         }
 
         void to_back() const {
-            if (cur_index == npos) return;
-
-            if (length == 1) return;
-            cur_index = 1;
+            cur_index = tail;
         }
 
-        LinkedList& to_front() {
-            if (cur_index == npos) return *this;
-
-            cur_index = 0;
+        CompactLinkedList& to_front() {
+            cur_index = head;
             return *this;
         }
 
-        LinkedList& to_back() {
-            if (cur_index == npos) return *this;
-
-            if (length == 1) return *this;
-            cur_index = 1;
+        CompactLinkedList& to_back() {
+            cur_index = tail;
             return *this;
         }
 
@@ -1513,21 +3422,17 @@ namespace Auxil {
 
         T& front() const {
             if (length == 0) throw Exception("Cannot access front of empty linked list!");
-
-            return nodes[0].value;
+            return values[head];
         }
 
         T& back() const {
             if (length == 0) throw Exception("Cannot access back of empty linked list!");
-
-            usize b = length > 0 /*If empty*/ ? (length >= 2 /*If it has 2 or more elements*/ ? 1:0) : npos;
-
-            return nodes[b].value;
+            return values[tail];
         }
 
         T& get() const {
             if (cur_index == npos) throw Exception("Cannot access current element of empty linked list!");
-            return nodes[cur_index].value;
+            return values[cur_index];
         }
 
         //--------- List Data Management ----------
@@ -1536,94 +3441,138 @@ namespace Auxil {
             return length;
         }
 
+        [[nodiscard]] usize capacity() const {
+            return links.size();
+        }
+
         [[nodiscard]] bool has_next() const {
-            return cur_index != npos && nodes[cur_index].next != npos;
+            return cur_index != npos && links.data()[cur_index].next != npos;
         }
 
         [[nodiscard]] bool has_prev() const {
-            return cur_index != npos && nodes[cur_index].prev != npos;
+            return cur_index != npos && links.data()[cur_index].prev != npos;
         }
 
         [[nodiscard]] bool empty() const {
-            return cur_index == npos;
+            return length == 0;
         }
 
-        LinkedList& shrink_to_fit() {
-            reserve(length);
-
-            return *this;
+        //the value and link arrays, indexed by slot, slots that aren't in the list hold T()
+        [[nodiscard]] const Array<T>& data() const {
+            return values;
         }
 
-        //access the internal Nodes data array
-        Array<Node> data() const {
-            return nodes;
+        [[nodiscard]] const Array<Link>& link_data() const {
+            return links;
         }
 
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return values.resource();
+        }
 
-        usize get_node_index() const {
+        [[nodiscard]] Index get_node_index() const {
             return cur_index;
         }
 
+        //--------- Positional access (Indexed only) ----------
+
+        T& at(const usize i) const requires Indexed {
+            return values[slot_at(i)];
+        }
+
+        T& operator[](const usize i) const requires Indexed {
+            return values[slot_at(i)];
+        }
+
+        //the position of the current node, or size() if there is none
+        [[nodiscard]] usize position() const requires Indexed {
+            return cur_index == npos ? length : tree.position_of(cur_index);
+        }
+
+        //makes the node at position i the current node
+        void move_to(const usize i) const requires Indexed {
+            cur_index = slot_at(i);
+        }
+
+        CompactLinkedList& move_to(const usize i) requires Indexed {
+            cur_index = slot_at(i);
+            return *this;
+        }
+
+        //inserts value so that it ends up at position i, i == size() appends it
+        template<typename U>
+        requires Indexed && std::constructible_from<T, U&&>
+        T& insert_at(const usize i, U&& value) {
+            if (i > length) throw Exception("Cannot insert at index {} of a linked list with {} elements", i, length);
+            const Index next = i == length ? npos : tree.slot_at(i);
+            const Index prev = next == npos ? tail : links.data()[next].prev;
+            return insert_between(std::forward<U>(value), prev, next);
+        }
+
+        //removes the node at position i and returns its value, if it is the current node, the current node advances
+        T erase_at(const usize i) requires Indexed {
+            const Index slot = slot_at(i);
+            if (cur_index == slot) cur_index = links.data()[slot].next;
+            return remove(slot);
+        }
+
         //--------- Iterators ----------
-        //the funny part is a linked list basically is an iterator, for speed however
-        //and separation of ideas, ill make a different iterator
 
-        struct Iterator {
+        //a bidirectional iterator that walks the links directly, it is invalidated when the list grows or compacts
+        template<bool Const>
+        struct BasicIterator {
         private:
-            LinkedList* llist{nullptr};
-            usize node_index{npos};
+            using Value = std::conditional_t<Const, const T, T>;
+            Value* vals{nullptr};
+            const Link* lnks{nullptr};
+            Index node_index{npos};
+
+            BasicIterator(Value* vals, const Link* lnks, const Index ind) : vals(vals), lnks(lnks), node_index(ind) {}
 
+            friend CompactLinkedList;
         public:
             using value_type = T;
             using difference_type = std::ptrdiff_t;
-            using pointer = T*;
-            using reference = T&;
-            using iterator_category = std::random_access_iterator_tag;
+            using pointer = Value*;
+            using reference = Value&;
+            using iterator_category = std::bidirectional_iterator_tag;
 
-            Iterator() = default;
+            BasicIterator() = default;
 
-            explicit Iterator(LinkedList& llist) : llist(&llist), node_index(llist.empty() ? npos:0) {}
-            explicit Iterator(LinkedList& llist, usize ind) : llist(&llist), node_index(llist.empty() ? npos:ind) {}
+            //a const iterator from a mutable one
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            BasicIterator(const BasicIterator<false>& it) : vals(it.vals), lnks(it.lnks), node_index(it.node_index) {}
 
             reference operator*() const {
                 if (node_index == npos) throw Exception("Invalid access of Linked List via Iterator\n"
-                                                        "Note: attempted to dereference a iterator to a empty list");
-                return llist->nodes[node_index].value;
+                                                        "Note: attempted to dereference the end of the list");
+                return vals[node_index];
             }
 
             pointer operator->() const {
                 if (node_index == npos) return nullptr;
-                return &llist->nodes[node_index].value;
+                return vals + node_index;
             }
 
-            Iterator& operator++() {
-                if (node_index == npos) return *this;
-                node_index = llist->nodes[node_index].next;
+            BasicIterator& operator++() {
+                if (node_index != npos) node_index = lnks[node_index].next;
                 return *this;
             }
 
-            Iterator operator++(int) {
-                if (node_index == npos) return *this;
-
-                Iterator res = *this;
-                node_index = llist->nodes[node_index].next;
-
+            BasicIterator operator++(int) {
+                BasicIterator res = *this;
+                ++*this;
                 return res;
             }
 
-            Iterator& operator--() {
-                if (node_index == npos) return *this;
-                node_index = llist->nodes[node_index].prev;
-
+            BasicIterator& operator--() {
+                if (node_index != npos) node_index = lnks[node_index].prev;
                 return *this;
             }
 
-            Iterator operator--(int) {
-                if (node_index == npos) return *this;
-
-                Iterator res = *this;
-                node_index = llist->nodes[node_index].prev;
-
+            BasicIterator operator--(int) {
+                BasicIterator res = *this;
+                --*this;
                 return res;
             }
 
@@ -1631,68 +3580,88 @@ namespace Auxil {
                 return node_index != npos;
             }
 
-            std::strong_ordering operator<=>(const Iterator &it) const {
-                if (it.llist != llist) return llist <=> it.llist;
-                return node_index <=> it.node_index;
+            [[nodiscard]] Index index() const {
+                return node_index;
             }
 
-            bool operator==(const Iterator&) const = default;
-            bool operator!=(const Iterator&) const = default;
-            bool operator>(const Iterator&) const = default;
-            bool operator<(const Iterator&) const = default;
-            bool operator>=(const Iterator&) const = default;
-            bool operator<=(const Iterator&) const = default;
+            bool operator==(const BasicIterator& it) const {
+                return node_index == it.node_index;
+            }
+
+            friend BasicIterator<true>;
         };
 
+        using Iterator = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
         //returns a forward iterator starting here
         Iterator current() {
-            return Iterator(*this, cur_index);
+            return {values.data(), links.data(), cur_index};
         }
 
         Iterator begin() {
-            return Iterator(*this);
+            return {values.data(), links.data(), head};
         }
 
         Iterator end() {
-            return Iterator(*this, npos);
+            return {values.data(), links.data(), npos};
         }
 
-        template<OstreamFormattable U>
-        friend std::ostream& operator<<(std::ostream& os, const LinkedList<U>& llist);
-        friend ::std::formatter<LinkedList, char>;
+        ConstIterator begin() const {
+            return {values.data(), links.data(), head};
+        }
 
-    };
+        ConstIterator end() const {
+            return {values.data(), links.data(), npos};
+        }
 
+        Iterator iterator_at(const usize i) requires Indexed {
+            return {values.data(), links.data(), i == length ? npos : slot_at(i)};
+        }
 
+        ConstIterator iterator_at(const usize i) const requires Indexed {
+            return {values.data(), links.data(), i == length ? npos : slot_at(i)};
+        }
 
+        //the position of the node pos points to, or size() for end()
+        [[nodiscard]] usize index_of(const ConstIterator pos) const requires Indexed {
+            return pos.node_index == npos ? length : tree.position_of(pos.node_index);
+        }
 
-    template<OstreamFormattable U>
-    std::ostream& operator<<(std::ostream& os, const LinkedList<U>& llist) {
-        if (llist.empty()) {
-            os << "[]";
-            return os;
+        //inserts value before pos (at the back for end()), returns an iterator to it
+        template<typename U>
+        requires std::constructible_from<T, U&&>
+        Iterator insert(const ConstIterator pos, U&& value) {
+            const Index next = pos.node_index;
+            const Index prev = next == npos ? tail : links.data()[next].prev;
+            const Index i = insert_node(std::forward<U>(value), prev, next);
+            return {values.data(), links.data(), i};
         }
-        os << "[";
-        usize node = 0;
-        const Array<typename LinkedList<U>::Node>* nodes = &llist.nodes;
-        usize max_iterations = llist.size()+1;
 
-        //print all the nodes leading up to the current index
-        while (node != llist.get_node_index() && max_iterations > 0) {
-            os << nodes->at(node).value;
-            node = nodes->at(node).next;
-            os << " <- ";
-            --max_iterations;
+        //removes the node at pos in O(1), returns an iterator to the node after it, if pos is the current node,
+        //the current node advances too
+        Iterator erase(const ConstIterator pos) {
+            const Index i = pos.node_index;
+            if (i == npos) throw Exception("Cannot erase the end of a linked list!");
+            const Index next = links.data()[i].next;
+            if (cur_index == i) cur_index = next;
+            remove(i);
+            return {values.data(), links.data(), next};
         }
+    };
 
-        //print the current node
-        os << nodes->at(node).value;
-        --max_iterations;
-        node = nodes->at(node).next;
-        while (node != LinkedList<U>::npos && max_iterations > 0) {
-            os << " -> " << nodes->at(node).value;
-            node = nodes->at(node).next;
-            --max_iterations;
+    //a CompactLinkedList with the positional index
+    template<typename T, std::unsigned_integral Index = u32>
+    using IndexedLinkedList = CompactLinkedList<T, Index, true>;
+
+    template<OstreamFormattable U, std::unsigned_integral I, bool Indexed>
+    std::ostream& operator<<(std::ostream& os, const CompactLinkedList<U, I, Indexed>& llist) {
+        os << "[";
+        bool before = llist.valid();
+        for (auto it = llist.begin(); it != llist.end(); ++it) {
+            if (it != llist.begin()) os << (before ? " <- " : " -> ");
+            os << *it;
+            if (it.index() == llist.get_node_index()) before = false;
         }
         os << "]";
 
@@ -1734,6 +3703,26 @@ struct std::formatter<Auxil::Array<T>, char> {
     }
 };
 
+template<typename T, Auxil::usize N> requires Auxil::Formattable<T>
+struct std::formatter<Auxil::Vector<T, N>, char> {
+    std::formatter<T, char> formatter_t;
+
+    template<typename ParseContext>
+    auto parse(ParseContext& ctx) {
+        return formatter_t.parse(ctx);
+    }
+
+    template<typename FormatContext>
+    auto format(const Auxil::Vector<T, N>& vec, FormatContext& ctx) const {
+        auto out = std::format_to(ctx.out(), "[");
+        for (Auxil::usize i = 0; i < vec.size(); ++i) {
+            if (i != 0) out = std::format_to(out, ", ");
+            out = formatter_t.format(vec.data()[i], ctx);
+        }
+        return std::format_to(out, "]");
+    }
+};
+
 template<typename T> requires Auxil::Formattable<T>
 struct std::formatter<Auxil::Grid<T>, char> {
     std::formatter<T, char> formatter_t{};
@@ -1814,5 +3803,30 @@ struct std::formatter<Auxil::LinkedList<T>, char> {
     }
 };
 
+template<typename T, std::unsigned_integral Index, bool Indexed> requires Auxil::Formattable<T>
+struct std::formatter<Auxil::CompactLinkedList<T, Index, Indexed>, char> {
+    std::formatter<T, char> formatter_t{};
+
+    template<typename ParseContext>
+    auto parse(ParseContext& ctx) {
+        return formatter_t.parse(ctx);
+    }
+
+    template<typename FormatContext>
+    auto format(const Auxil::CompactLinkedList<T, Index, Indexed>& llist, FormatContext& ctx) const {
+        auto out = ctx.out();
+        out = std::format_to(out, "[");
+
+        bool before = llist.valid();
+        for (auto it = llist.begin(); it != llist.end(); ++it) {
+            if (it != llist.begin()) out = std::format_to(out, "{}", before ? " <- " : " -> ");
+            out = formatter_t.format(*it, ctx);
+            if (it.index() == llist.get_node_index()) before = false;
+        }
+
+        return std::format_to(out, "]");
+    }
+};
+
 
 #endif
\ No newline at end of file
@@ -2,44 +2,124 @@
 #define EXCEPTION_HPP
 
 #define BOOST_STACKTRACE_USE_BACKTRACE
+#include <cassert>
+#include <memory>
+#include <mutex>
 #include "boost/stacktrace.hpp"
 #include "print.hpp"
 
+/*
+ * what an Exception records about where it was thrown, define it before including Auxil to choose
+ * 0: nothing, so constructing one costs only its message
+ * 1: the return addresses, which are only symbolised the first time what() is called
+ * it defaults to 0 when NDEBUG is defined and 1 otherwise
+ */
+#ifndef AUXIL_STACKTRACE
+#ifdef NDEBUG
+#define AUXIL_STACKTRACE 0
+#else
+#define AUXIL_STACKTRACE 1
+#endif
+#endif
+
+/*
+ * what the bounds checks on container accessors (at, operator[], at_flat, front, back...) do when an index is out
+ * of range, define it before including Auxil to choose
+ * 2: throw an Exception (the default)
+ * 1: assert, so the check is gone when NDEBUG is defined
+ * 0: nothing, the index is trusted
+ * the try_ accessors always check, and never throw
+ */
+#ifndef AUXIL_BOUNDS_CHECK
+#define AUXIL_BOUNDS_CHECK 2
+#endif
+
+#if AUXIL_BOUNDS_CHECK >= 2
+#define AUXIL_CHECK_BOUNDS(out_of_range, ...) do { if (out_of_range) [[unlikely]] ::Auxil::throw_exception(__VA_ARGS__); } while (0)
+#elif AUXIL_BOUNDS_CHECK == 1
+#define AUXIL_CHECK_BOUNDS(out_of_range, ...) assert(!(out_of_range))
+#else
+#define AUXIL_CHECK_BOUNDS(out_of_range, ...) ((void)0)
+#endif
+
 namespace Auxil {
+    /*
+     * the message is formatted when the exception is made, the stacktrace (see AUXIL_STACKTRACE) is captured then
+     * but only turned into text the first time what() is called, so exceptions that are caught and handled never
+     * pay for symbolising it, copies share that text
+     */
     class Exception final : public std::runtime_error {
-        boost::stacktrace::stacktrace st;
-        std::string message;
+        struct Details {
+            std::string message;
+#if AUXIL_STACKTRACE
+            boost::stacktrace::stacktrace st;
+#endif
+            //message followed by the stacktrace
+            std::string text;
+            std::once_flag symbolised;
+        };
+
+        std::shared_ptr<Details> details;
+
+        void capture() {
+#if AUXIL_STACKTRACE
+            details->st = boost::stacktrace::stacktrace();
+#endif
+        }
     public:
-        Exception() : std::runtime_error("") {
-            st = boost::stacktrace::stacktrace();
-            this->message.append("\n");
-            message = (std::ostringstream() << st).str();
+        Exception() : std::runtime_error(""), details(std::make_shared<Details>()) {
+            capture();
         }
 
-        explicit Exception(const char* message) : std::runtime_error("") {
-            this->message = message;
-            this->message.append("\n");
-            st = boost::stacktrace::stacktrace();
-            this->message += (std::ostringstream() << st).str();
+        explicit Exception(const char* message) : std::runtime_error(""), details(std::make_shared<Details>()) {
+            details->message = message;
+            capture();
         }
 
         template<typename... Args>
         explicit Exception(const std::string& format, Args&&... args) :
-        std::runtime_error("") {
-            this->message.append("\n");
-            message = Auxil::format(format, std::forward<Args>(args)...);
-            st = boost::stacktrace::stacktrace();
-            this->message += (std::ostringstream() << st).str();
+        std::runtime_error(""), details(std::make_shared<Details>()) {
+            details->message = Auxil::format(format, std::forward<Args>(args)...);
+            capture();
         }
 
+        //the message and the stacktrace
         [[nodiscard]] const char *what() const noexcept override {
-            return message.c_str();
+            std::call_once(details->symbolised, [this] {
+                try {
+                    details->text = details->message;
+#if AUXIL_STACKTRACE
+                    details->text.append("\n");
+                    details->text += boost::stacktrace::to_string(details->st);
+#endif
+                } catch (...) {
+                    //what() can't throw, so without the memory for the stacktrace it is just the message
+                }
+            });
+            return details->text.empty() ? details->message.c_str() : details->text.c_str();
+        }
+
+        //just the message, without symbolising anything
+        [[nodiscard]] const std::string& message() const noexcept {
+            return details->message;
         }
 
-        [[nodiscard]] boost::stacktrace::stacktrace stacktrace() {
-            return st;
+        //empty when AUXIL_STACKTRACE is 0
+        [[nodiscard]] boost::stacktrace::stacktrace stacktrace() const {
+#if AUXIL_STACKTRACE
+            return details->st;
+#else
+            return boost::stacktrace::stacktrace(0, 0);
+#endif
         }
     };
+
+    //kept out of line and cold, so that the checks which call it add little more than a compare and a branch to
+    //the code around them
+    template<typename... Args>
+    [[noreturn, gnu::cold, gnu::noinline]] void throw_exception(const std::string& format, const Args&... args) {
+        throw Exception(format, args...);
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,6 @@
 #ifndef ITERATOR_HPP
 #define ITERATOR_HPP
+#include <compare>
 #include <type_traits>
 #include "misc.hpp"
 
@@ -407,6 +408,106 @@ namespace Auxil {
         }
     };
 
+    //walks elements that are a fixed number of elements apart, a column of a row major grid for example,
+    //it stores an index instead of a moving pointer so that end() never points past the allocation
+    template<typename T>
+    class StridedIterator {
+        T* base;
+        std::ptrdiff_t index;
+        std::ptrdiff_t stride;
+
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator_category = std::random_access_iterator_tag;
+
+        StridedIterator() : base(nullptr), index(0), stride(1) {}
+
+        StridedIterator(T* base, const difference_type index, const difference_type stride) :
+        base(base), index(index), stride(stride) {}
+
+        reference operator *() const {
+            return base[index*stride];
+        }
+
+        pointer operator->() const {
+            return base + index*stride;
+        }
+
+        reference operator[](const difference_type amt) const {
+            return base[(index + amt)*stride];
+        }
+
+        StridedIterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        StridedIterator operator++(int) {
+            auto res = *this;
+
+            ++index;
+
+            return res;
+        }
+
+        StridedIterator& operator --() {
+            --index;
+
+            return *this;
+        }
+
+        StridedIterator operator--(int) {
+            auto res = *this;
+
+            --index;
+
+            return res;
+        }
+
+        StridedIterator operator+(const difference_type amt) const {
+            return StridedIterator(base, index + amt, stride);
+        }
+
+        friend StridedIterator operator+(const difference_type amt, const StridedIterator& it) {
+            return it + amt;
+        }
+
+        StridedIterator operator-(const difference_type amt) const {
+            return StridedIterator(base, index - amt, stride);
+        }
+
+        difference_type operator-(const StridedIterator& other) const {
+            return index - other.index;
+        }
+
+        StridedIterator& operator+=(const difference_type amt) {
+            index += amt;
+
+            return *this;
+        }
+
+        StridedIterator& operator-=(const difference_type amt) {
+            index -= amt;
+
+            return *this;
+        }
+
+        bool operator==(const StridedIterator& other) const {
+            return other.index == index;
+        }
+
+        bool operator!=(const StridedIterator& other) const {
+            return other.index != index;
+        }
+
+        auto operator<=>(const StridedIterator& other) const {
+            return index <=> other.index;
+        }
+    };
+
     template<typename T>
     GenericIterable<PointerIterator<T>> iterate_pointer(T* begin, T* end) {
         return GenericIterable<PointerIterator<T>>(PointerIterator<T>(begin), PointerIterator<T>(end));
@@ -0,0 +1,281 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "exception.hpp"
+#include "misc.hpp"
+
+namespace Auxil {
+    using namespace Primitives;
+
+    namespace LogDetail {
+        //how many characters of a line fit in a cell, longer lines are copied to the heap
+        constexpr usize cell_chars = 236;
+
+        //a slot in the ring, sequence says whose turn it is: the producer claiming position p waits for p, the
+        //writer waits for p + 1, and hands it back for the next lap as p + capacity
+        struct alignas(64) Cell {
+            std::atomic<usize> sequence{0};
+            char* overflow{nullptr};
+            u32 length{0};
+            char chars[cell_chars];
+        };
+        static_assert(sizeof(Cell) == 256);
+
+        //how much the writer collects before handing it to write() in one call
+        constexpr usize batch_size = 64 * 1024;
+
+        //how many times the writer yields on an empty queue before it writes what it has and sleeps, so a burst
+        //of lines from other threads goes out in one call instead of one call per line
+        constexpr u32 idle_yields = 16;
+    }
+
+    /*
+     * an asynchronous sink for a file descriptor, print and println format on the calling thread (the format
+     * strings are checked at compile time) into a buffer on its stack, then copy the line into a bounded ring that
+     * any number of threads push to without a lock, a background thread drains the ring into large write() calls
+     *
+     * lines from one thread come out in the order they were logged, when the ring is full the logging thread waits
+     * for room, flush() waits until everything logged before it has been written, destroying the logger flushes it
+     * don't mix it with std::cout on the same descriptor, the two buffer separately
+     */
+    class Logger {
+        using Cell = LogDetail::Cell;
+
+        std::unique_ptr<Cell[]> cells;
+        usize mask{0};
+        int fd{-1};
+        bool owns_fd{false};
+
+        //the next position producers claim
+        alignas(64) std::atomic<usize> tail{0};
+        //every position before this one has been handed to write()
+        alignas(64) std::atomic<usize> written{0};
+        std::atomic_uint32_t sleeping{0};
+        std::atomic_bool running{true};
+        std::atomic_bool _failed{false};
+
+        std::thread writer;
+
+        void init(const usize capacity) {
+            const usize n = std::bit_ceil(std::max<usize>(capacity, 2));
+            cells = std::make_unique<Cell[]>(n);
+            mask = n - 1;
+            for (usize i = 0; i < n; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+            writer = std::thread([this] { run(); });
+        }
+
+        void wake() {
+            if (sleeping.exchange(0)) sleeping.notify_one();
+        }
+
+        //waits for the cell at the next position to be free and takes it
+        std::pair<Cell*, usize> claim() {
+            usize pos = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& c = cells[pos & mask];
+                const usize seq = c.sequence.load(std::memory_order_acquire);
+                const auto lap = static_cast<i64>(seq - pos);
+                if (lap == 0) {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return {&c, pos};
+                } else if (lap < 0) {
+                    //the ring is full, the writer is a lap behind
+                    wake();
+                    std::this_thread::yield();
+                    pos = tail.load(std::memory_order_relaxed);
+                } else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void publish(Cell& c, const usize pos) {
+            //seq_cst on both sides, so either the writer sees the cell or we see that it went to sleep
+            c.sequence.store(pos + 1, std::memory_order_seq_cst);
+            if (sleeping.load(std::memory_order_seq_cst)) wake();
+        }
+
+        void write_all(const char* text, usize n) {
+            while (n > 0) {
+                const ssize_t w = ::write(fd, text, n);
+                if (w < 0) {
+                    if (errno == EINTR) continue;
+                    _failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                text += w;
+                n -= static_cast<usize>(w);
+            }
+        }
+
+        void mark_written(const usize position) {
+            if (written.load(std::memory_order_relaxed) == position) return;
+            written.store(position, std::memory_order_release);
+            written.notify_all();
+        }
+
+        void run() {
+            const auto batch = std::make_unique<char[]>(LogDetail::batch_size);
+            usize used = 0, head = 0;
+            u32 idle = 0;
+
+            for (;;) {
+                Cell& c = cells[head & mask];
+                if (c.sequence.load(std::memory_order_acquire) == head + 1) {
+                    const char* text = c.overflow ? c.overflow : c.chars;
+                    if (used + c.length > LogDetail::batch_size) {
+                        write_all(batch.get(), used);
+                        used = 0;
+                        mark_written(head);
+                    }
+                    if (c.length > LogDetail::batch_size) {
+                        write_all(text, c.length);
+                    } else {
+                        std::memcpy(batch.get() + used, text, c.length);
+                        used += c.length;
+                    }
+                    delete[] c.overflow;
+                    c.overflow = nullptr;
+                    c.sequence.store(head + mask + 1, std::memory_order_release);
+                    head++;
+                    idle = 0;
+                    continue;
+                }
+
+                if (idle++ < LogDetail::idle_yields && running.load(std::memory_order_relaxed)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (used > 0) {
+                    write_all(batch.get(), used);
+                    used = 0;
+                }
+                mark_written(head);
+                if (!running.load(std::memory_order_acquire)) return;
+
+                sleeping.store(1, std::memory_order_seq_cst);
+                if (c.sequence.load(std::memory_order_seq_cst) == head + 1 || !running.load(std::memory_order_seq_cst)) {
+                    sleeping.store(0, std::memory_order_relaxed);
+                    continue;
+                }
+                sleeping.wait(1, std::memory_order_acquire);
+            }
+        }
+
+        //copies a line that fits in a cell
+        void push(const char* text, const usize length, const bool newline) {
+            auto [c, pos] = claim();
+            std::memcpy(c->chars, text, length);
+            if (newline) c->chars[length] = '\n';
+            c->length = static_cast<u32>(length + newline);
+            c->overflow = nullptr;
+            publish(*c, pos);
+        }
+
+        //hands over a line allocated with new[], the writer deletes it
+        void push_heap(char* text, const usize length) {
+            auto [c, pos] = claim();
+            c->length = static_cast<u32>(length);
+            c->overflow = text;
+            publish(*c, pos);
+        }
+
+    public:
+        //capacity is how many lines can be waiting to be written, rounded up to a power of two
+        explicit Logger(const int fd = STDOUT_FILENO, const usize capacity = 4096) : fd(fd) {
+            init(capacity);
+        }
+
+        //appends to the file at path, creating it if it doesn't exist
+        explicit Logger(const std::string& path, const usize capacity = 4096) {
+            fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if (fd < 0) throw Exception("Cannot open {} for logging: {}", path, std::strerror(errno));
+            owns_fd = true;
+            init(capacity);
+        }
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        ~Logger() {
+            running.store(false, std::memory_order_seq_cst);
+            wake();
+            writer.join();
+            if (owns_fd) ::close(fd);
+        }
+
+        //the line is formatted into a buffer the size of a cell on this thread's stack, and formatted again onto
+        //the heap if it didn't fit
+        template<typename... Args>
+        void print(std::format_string<Args...> fmt, Args&&... args) {
+            char line[LogDetail::cell_chars];
+            const auto size = static_cast<usize>(std::format_to_n(line, sizeof(line), fmt, std::forward<Args>(args)...).size);
+            if (size <= sizeof(line)) return push(line, size, false);
+
+            auto* text = new char[size];
+            std::format_to(text, fmt, std::forward<Args>(args)...);
+            push_heap(text, size);
+        }
+
+        template<typename... Args>
+        void println(std::format_string<Args...> fmt, Args&&... args) {
+            char line[LogDetail::cell_chars - 1];
+            const auto size = static_cast<usize>(std::format_to_n(line, sizeof(line), fmt, std::forward<Args>(args)...).size);
+            if (size <= sizeof(line)) return push(line, size, true);
+
+            auto* text = new char[size + 1];
+            std::format_to(text, fmt, std::forward<Args>(args)...);
+            text[size] = '\n';
+            push_heap(text, size + 1);
+        }
+
+        //logs text as it is
+        void write(const std::string_view text) {
+            if (text.size() <= LogDetail::cell_chars) return push(text.data(), text.size(), false);
+
+            auto* copy = new char[text.size()];
+            std::memcpy(copy, text.data(), text.size());
+            push_heap(copy, text.size());
+        }
+
+        //waits until everything logged before the call has been handed to write()
+        void flush() {
+            const usize target = tail.load(std::memory_order_acquire);
+            wake();
+            for (usize w = written.load(std::memory_order_acquire); w < target; w = written.load(std::memory_order_acquire)) {
+                written.wait(w, std::memory_order_acquire);
+            }
+        }
+
+        //if a write() has failed, the lines it was writing are lost
+        [[nodiscard]] bool failed() const {
+            return _failed.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] int descriptor() const {
+            return fd;
+        }
+
+        //loggers for stdout and stderr, they are flushed when the program exits normally
+        static Logger& out() {
+            static Logger logger(STDOUT_FILENO);
+            return logger;
+        }
+
+        static Logger& err() {
+            static Logger logger(STDERR_FILENO);
+            return logger;
+        }
+    };
+}
+
+#endif //LOG_HPP
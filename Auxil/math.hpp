@@ -1,8 +1,17 @@
 #ifndef MATH_HPP
 #define MATH_HPP
+#include <bit>
+#include <cstring>
+#include <string_view>
 #include "misc.hpp"
 #include "cmath"
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 
 namespace Auxil {
 
@@ -12,8 +21,80 @@ namespace Auxil {
     template<typename T>
     concept Arithmetic = std::is_arithmetic_v<T>;
 
+    //converts a value from host to network (big endian) byte order
     template<Arithmetic T>
-    T hton(T data);
+    constexpr T hton(const T data) {
+        if constexpr (std::endian::native == std::endian::big || sizeof(T) == 1) {
+            return data;
+        } else {
+            auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(data);
+            std::ranges::reverse(bytes);
+            return std::bit_cast<T>(bytes);
+        }
+    }
+
+    //converts a value from network (big endian) to host byte order
+    template<Arithmetic T>
+    constexpr T ntoh(const T data) {
+        return hton(data);
+    }
+
+    //the types that have a vectorized kernel (matmul, the batch types, ...)
+    template<typename T>
+    concept SimdArithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+    //portable vectors written with gcc/clang vector extensions, they compile to sse, avx or neon depending on -march
+    namespace Simd {
+        //avx registers when the target has them (avx512 stays at 32 to avoid the clock penalty), sse/neon width otherwise,
+        //gnu vectors wider than the hardware get split into several narrower ones
+#if defined(__AVX512F__) || defined(__AVX__)
+        constexpr usize vector_bytes = 32;
+#else
+        constexpr usize vector_bytes = 16;
+#endif
+
+        template<SimdArithmetic T>
+        using Vec [[gnu::vector_size(vector_bytes)]] = T;
+
+        template<SimdArithmetic T>
+        constexpr usize lanes = sizeof(Vec<T>) / sizeof(T);
+
+        template<SimdArithmetic T>
+        FORCE_INLINE Vec<T> load(const T* p) {
+            Vec<T> v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        template<SimdArithmetic T>
+        FORCE_INLINE void store(T* p, const std::type_identity_t<Vec<T>>& v) {
+            std::memcpy(p, &v, sizeof(v));
+        }
+
+        template<SimdArithmetic T>
+        FORCE_INLINE Vec<T> broadcast(const T value) {
+            return Vec<T>{} + value;
+        }
+
+        //there is no vector sqrt in the extensions, so this maps to the instruction where we know it
+        template<std::floating_point T>
+        FORCE_INLINE Vec<T> sqrt(const std::type_identity_t<Vec<T>>& v) {
+#if defined(__AVX__)
+            if constexpr (std::is_same_v<T, float>) return _mm256_sqrt_ps(v);
+            else return _mm256_sqrt_pd(v);
+#elif defined(__SSE2__)
+            if constexpr (std::is_same_v<T, float>) return _mm_sqrt_ps(v);
+            else return _mm_sqrt_pd(v);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            if constexpr (std::is_same_v<T, float>) return (Vec<T>)vsqrtq_f32((float32x4_t)v);
+            else return (Vec<T>)vsqrtq_f64((float64x2_t)v);
+#else
+            Vec<T> res;
+            for (usize i = 0; i < lanes<T>; i++) res[i] = std::sqrt(v[i]);
+            return res;
+#endif
+        }
+    }
 
 
     template<typename T>
@@ -94,42 +175,104 @@ namespace Auxil {
             };
         } flags;
 
-        NumericLiteralInformation(const bool is_valid, const bool is_hex, const bool is_binary, const bool is_negative) : is_valid(is_valid) {
+        constexpr NumericLiteralInformation(const bool is_valid, const bool is_hex, const bool is_binary, const bool is_negative) : is_valid(is_valid) {
             flags.is_hex = is_hex;
             flags.is_binary = is_binary;
             flags.negative = is_negative;
         }
     };
 
-    constexpr NumericLiteralInformation analyze_literal(const std::string& s) {
-        u8 flags = 0;//1 digit is hex, 2 digit is binary 4 is negative
-        usize step = 0;
-        if (s.empty()) return {true, false, false, false};
-        if (s.front() == '-') {
-            step++;
-            flags |= 4;
-        }
-        if (s.size()-step > 2) {
-            auto sub = s.substr(step, 2);
-            if (sub == "0x" || sub == "0X") {
-                step = 2;
-                flags |= 1;
-            } else if (sub == "0b" || sub == "0B") {
-                step = 2;
-                flags |= 2;
-            }
-        }
-        for (; step < s.size(); step++) {
-            const char c = s[step];
-            if (!(
-                    ((flags & 0b1) && ishexdigit(c)) ||
-                    ((flags & 0b10) && isbinarydigit(c)) ||
-                    (!(flags & 0b11) && isdigit(c))
-                )) {
-                return {false, false, false, false};
+    namespace ParseDetail {
+        //eight characters loaded little endian into a u64, so the first character is the lowest byte, the high bit
+        //of each byte that isn't a digit is set, along with bits after the first of them that can be wrong
+        FORCE_INLINE constexpr u64 non_digits(const u64 chunk) {
+            //bytes above '9' overflow into their high bit when 0x46 is added, bytes below '0' borrow into it
+            return ((chunk + 0x4646464646464646ULL) | (chunk - 0x3030303030303030ULL)) & 0x8080808080808080ULL;
+        }
+
+        //the value of eight digit values, one a byte, combining pairs, then fours, then both halves
+        FORCE_INLINE constexpr u64 combine_digits(u64 chunk) {
+            chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+            chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+            return (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFFULL;
+        }
+
+        FORCE_INLINE constexpr u32 digit_value(const char c) {
+            if (c >= '0' && c <= '9') return static_cast<u32>(c - '0');
+            if (c >= 'a' && c <= 'z') return static_cast<u32>(c - 'a' + 10);
+            if (c >= 'A' && c <= 'Z') return static_cast<u32>(c - 'A' + 10);
+            return 36;
+        }
+
+        /*
+         * reads the digits of base at the start of [p, end) into value and returns where they stop, overflow is
+         * set if the value doesn't fit in a u64, decimal digits are read eight at a time when they can be, which is
+         * most of the digits of any number long enough for it to matter
+         */
+        constexpr const char* parse_digits(const char* p, const char* end, const u32 base, u64& value, bool& overflow) {
+            value = 0;
+            overflow = false;
+            //how many digits always fit in a u64, only the digits after them are checked for overflow
+            const usize safe = base == 10 ? 19 : base == 16 ? 15 : base == 2 ? 63 : 0;
+            usize digits = 0;
+            if (base == 10 && std::endian::native == std::endian::little && !std::is_constant_evaluated()) {
+                constexpr u64 powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+                while (end - p >= 8) {
+                    u64 chunk;
+                    std::memcpy(&chunk, p, 8);
+                    const u64 mask = non_digits(chunk);
+                    const usize n = mask ? static_cast<usize>(std::countr_zero(mask)) / 8 : 8;
+                    if (digits + n > safe) break;
+                    if (n) {
+                        //shifting the digits to the top of the chunk leaves zeros in front of them
+                        const u64 values = (chunk - 0x3030303030303030ULL) << (64 - 8 * n);
+                        value = value * (n == 8 ? 100000000 : powers[n]) + combine_digits(values);
+                        digits += n;
+                        p += n;
+                    }
+                    if (n != 8) return p;
                 }
+            }
+            for (; p != end; ++p, ++digits) {
+                const u32 d = digit_value(*p);
+                if (d >= base) break;
+                if (digits >= safe && value > (std::numeric_limits<u64>::max() - d) / base) overflow = true;
+                value = value * base + d;
+            }
+            return p;
         }
-        return {true, static_cast<bool>(flags & 0b1), static_cast<bool>(flags & 0b10), static_cast<bool>(flags & 0b100)};
+    }
+
+    /*
+     * checks that s is an integer literal, decimal, 0x hexadecimal or 0b binary and optionally negative, and reads
+     * its magnitude into value in the same pass, so there is no need to analyze a literal and then parse it again,
+     * value wraps if the literal doesn't fit in a u64
+     */
+    constexpr NumericLiteralInformation parse_literal(const std::string_view s, u64& value) {
+        value = 0;
+        if (s.empty()) return {true, false, false, false};
+        const char* p = s.data();
+        const char* end = p + s.size();
+        const bool negative = *p == '-';
+        if (negative) ++p;
+
+        u32 base = 10;
+        if (end - p > 2 && p[0] == '0') {
+            if (p[1] == 'x' || p[1] == 'X') base = 16;
+            else if (p[1] == 'b' || p[1] == 'B') base = 2;
+            if (base != 10) p += 2;
+        }
+
+        bool overflow = false;
+        const char* stop = ParseDetail::parse_digits(p, end, base, value, overflow);
+        //a lone '-' was valid before, so it still is
+        if (stop != end) return {false, false, false, false};
+        return {true, base == 16, base == 2, negative};
+    }
+
+    constexpr NumericLiteralInformation analyze_literal(const std::string_view s) {
+        u64 value = 0;
+        return parse_literal(s, value);
     }
 
     template<std::floating_point T>
@@ -146,6 +289,117 @@ namespace Auxil {
 
 
     template<Arithmetic T>
+    struct SinCos {
+        T sin;
+        T cos;
+    };
+
+    namespace TrigDetail {
+        //fast_sincos is only used inside this range, outside of it the range reduction loses too much precision
+        template<std::floating_point T>
+        inline constexpr T fast_range = sizeof(T) == 4 ? T(8192) : T(1073741824.0);
+
+        //hides v from the optimizer so that -ffast-math can't fold (x + magic) - magic back into x or merge the
+        //steps of the range reduction
+        template<typename V>
+        FORCE_INLINE V opaque(V v) {
+#if defined(__SSE2__)
+            asm("" : "+x"(v));
+#elif defined(__aarch64__)
+            asm("" : "+w"(v));
+#else
+            asm("" : "+m"(v));
+#endif
+            return v;
+        }
+
+        //x = q*pi/2 + r, |r| <= pi/4, pi/2 is split in three so that q*pi/2 is exact inside fast_range (cody-waite),
+        //the polynomials are the cephes minimax polynomials for sin and cos on [-pi/4, pi/4]
+        //V is either T or Simd::Vec<T>, so the scalar and vector versions are the same code, the quadrant fix up
+        //after the polynomials is done with bit operations so it needs nothing sse2 doesn't have, but every lane
+        //that is outside fast_range or not finite then branches to std::sin and std::cos, so the kernel is
+        //neither branch free nor constant time
+        template<std::floating_point T, typename V>
+        FORCE_INLINE void sincos_kernel(const V& x, V& s, V& c) {
+            constexpr bool scalar = std::is_same_v<V, T>;
+            using U = std::conditional_t<sizeof(T) == 4, u32, u64>;
+            using UV = std::conditional_t<scalar, U, Simd::Vec<U>>;
+            //adding 1.5 * 2^(mantissa bits) rounds to the nearest integer and leaves it in the low mantissa bits
+            constexpr T magic = sizeof(T) == 4 ? T(12582912.0f) : T(6755399441055744.0);
+            constexpr U sign_shift = sizeof(T)*8 - 2;
+
+            const V shifted = opaque(x * (2 / std::numbers::pi_v<T>) + magic);
+            const V q = shifted - magic;
+            const UV quadrant = std::bit_cast<UV>(shifted);
+
+            V r, z, sr, cr;
+            if constexpr (sizeof(T) == 4) {
+                r = opaque(opaque(x - q*1.5703125f) - q*4.837512969970703125e-4f) - q*7.54978995489188216e-8f;
+                z = r*r;
+                sr = r + r*z*((-1.9515295891e-4f*z + 8.3321608736e-3f)*z - 1.6666654611e-1f);
+                cr = 1.0f - 0.5f*z + z*z*((2.443315711809948e-5f*z - 1.388731625493765e-3f)*z + 4.166664568298827e-2f);
+            } else {
+                r = opaque(opaque(x - q*1.57079625129699707031) - q*7.54978941586159635336e-8) - q*5.39030285815811905290e-15;
+                z = r*r;
+                sr = r + r*z*(((((1.58962301576546568060e-10*z - 2.50507477628578072866e-8)*z
+                    + 2.75573136213857245213e-6)*z - 1.98412698295895385996e-4)*z
+                    + 8.33333333332211858878e-3)*z - 1.66666666666666307295e-1);
+                cr = 1.0 - 0.5*z + z*z*(((((-1.13585365213876817300e-11*z + 2.08757008419747316778e-9)*z
+                    - 2.75573141792967388112e-7)*z + 2.48015872888517045348e-5)*z
+                    - 1.38888888888730564116e-3)*z + 4.16666666666665929218e-2);
+            }
+
+            //quadrant q mod 4 -> (sin, cos): 0 -> (s, c), 1 -> (c, -s), 2 -> (-s, -c), 3 -> (-c, s)
+            const UV swap = UV{} - (quadrant & 1);
+            const UV sb = std::bit_cast<UV>(sr), cb = std::bit_cast<UV>(cr);
+            s = std::bit_cast<V>(((cb & swap) | (sb & ~swap)) ^ ((quadrant & 2) << sign_shift));
+            c = std::bit_cast<V>(((sb & swap) | (cb & ~swap)) ^ (((quadrant + 1) & 2) << sign_shift));
+
+            if constexpr (scalar) {
+                if (!(std::abs(x) <= fast_range<T>)) {
+                    s = std::sin(x);
+                    c = std::cos(x);
+                }
+            } else {
+                for (usize i = 0; i < Simd::lanes<T>; i++) {
+                    if (!(std::abs(x[i]) <= fast_range<T>)) {
+                        s[i] = std::sin(x[i]);
+                        c[i] = std::cos(x[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    //sin and cos at once with a polynomial approximation, for float and double this is about 2x (float) to 4x
+    //(double) faster than std::sin + std::cos, the error is within 1e-7 (float) or 2e-16 (double) for angles
+    //around a few turns, and only grows as fast as the precision of theta itself for |theta| up to 8192 (float)
+    //or 2^30 (double), larger angles, infinities and NaN fall back to std::sin and std::cos,
+    //other types always use std::sin and std::cos
+    template<std::floating_point T>
+    FORCE_INLINE SinCos<T> fast_sincos(const radians_t<T> theta) {
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            SinCos<T> res;
+            TrigDetail::sincos_kernel<T>(theta, res.sin, res.cos);
+            return res;
+        } else {
+            return {std::sin(theta), std::cos(theta)};
+        }
+    }
+
+    //sin and cos at once, fast_sincos when AUXIL_FAST_TRIG is defined (before including Auxil), std::sin and std::cos
+    //otherwise, every rotation in the library goes through this
+    template<std::floating_point T>
+    FORCE_INLINE SinCos<T> sincos(const radians_t<T> theta) {
+#ifdef AUXIL_FAST_TRIG
+        return fast_sincos<T>(theta);
+#else
+        return {std::sin(theta), std::cos(theta)};
+#endif
+    }
+
+    //floating point only, like the radians_t it's constructed from
+    template<std::floating_point T>
     struct AngleComponents {
         T sin;
         T cos;
@@ -157,12 +411,56 @@ namespace Auxil {
         AngleComponents() = default;
 
         explicit AngleComponents(radians_t<T> theta) {
-            sin = std::sin(theta);
-            cos = std::cos(theta);
-            tan = std::tan(theta);
+            const auto sc = Auxil::sincos<T>(theta);
+            sin = sc.sin;
+            cos = sc.cos;
+            tan = sin / cos;
             csc = static_cast<T>(1.0) / sin;
             sec = static_cast<T>(1.0) / cos;
-            cot = static_cast<T>(1.0) / tan;
+            cot = cos / sin;
+        }
+    };
+
+    //the same as AngleComponents without paying for the tangent and reciprocals up front, they are only computed
+    //when they are read, this is what the rotation functions use
+    template<std::floating_point T>
+    struct LazyAngleComponents {
+        T sin;
+        T cos;
+
+        LazyAngleComponents() = default;
+
+        explicit LazyAngleComponents(radians_t<T> theta) {
+            const auto sc = Auxil::sincos<T>(theta);
+            sin = sc.sin;
+            cos = sc.cos;
+        }
+
+        [[nodiscard]] FORCE_INLINE T tan() const {
+            return sin / cos;
+        }
+
+        [[nodiscard]] FORCE_INLINE T csc() const {
+            return static_cast<T>(1.0) / sin;
+        }
+
+        [[nodiscard]] FORCE_INLINE T sec() const {
+            return static_cast<T>(1.0) / cos;
+        }
+
+        [[nodiscard]] FORCE_INLINE T cot() const {
+            return cos / sin;
+        }
+
+        [[nodiscard]] AngleComponents<T> full() const {
+            AngleComponents<T> res;
+            res.sin = sin;
+            res.cos = cos;
+            res.tan = tan();
+            res.csc = csc();
+            res.sec = sec();
+            res.cot = cot();
+            return res;
         }
     };
 
@@ -261,17 +559,19 @@ namespace Auxil {
 
         template<Arithmetic Theta = big_float>
         FORCE_INLINE static v2 of(T magnitude, radians_t<Theta> theta) {
-            return {magnitude*cos(theta), magnitude*sin(theta)};
+            const auto t = Auxil::sincos<Theta>(theta);
+            return {magnitude*t.cos, magnitude*t.sin};
         }
 
         template<Arithmetic Theta = big_float>
         FORCE_INLINE static v2 of_deg(T magnitude, arcdegrees_t<Theta> theta) {
-            return {magnitude*std::cos(theta*TO_RADIANS<Theta>), magnitude*std::sin(theta*TO_RADIANS<Theta>)};
+            const auto t = Auxil::sincos<Theta>(theta*TO_RADIANS<Theta>);
+            return {magnitude*t.cos, magnitude*t.sin};
         }
 
         template<Arithmetic Theta = big_float>
         v2 rotated(radians_t<Theta> theta, v2 origin = {0, 0}) const {
-            auto t = AngleComponents<Theta>(theta);
+            auto t = LazyAngleComponents<Theta>(theta);
             auto xp = (x-origin.x)*t.cos - (y-origin.y)*t.sin;
             auto yp = (x-origin.x)*t.sin + (y-origin.y)*t.cos;
 
@@ -280,7 +580,7 @@ namespace Auxil {
 
         template<Arithmetic Theta = big_float>
         v2& rotate(radians_t<Theta> theta, v2 origin = {0, 0}) {
-            auto t = AngleComponents<Theta>(theta);
+            auto t = LazyAngleComponents<Theta>(theta);
             const auto xp = ((x-origin.x)*t.cos - (y-origin.y)*t.sin) + origin.x;
             const auto yp = ((x-origin.x)*t.sin + (y-origin.y)*t.cos) + origin.y;
 
@@ -291,7 +591,7 @@ namespace Auxil {
 
         template<Arithmetic Theta = big_float>
         v2 rotated_deg(arcdegrees_t<Theta> theta, v2 origin = {0, 0}) const {
-            auto t = AngleComponents<Theta>(theta*TO_RADIANS<Theta>);
+            auto t = LazyAngleComponents<Theta>(theta*TO_RADIANS<Theta>);
             auto xp = (x-origin.x)*t.cos - (y-origin.y)*t.sin;
             auto yp = (x-origin.x)*t.sin + (y-origin.y)*t.cos;
 
@@ -300,7 +600,7 @@ namespace Auxil {
 
         template<Arithmetic Theta = big_float>
         v2& rotate_deg(arcdegrees_t<Theta> theta, v2 origin = {0, 0}) {
-            auto t = AngleComponents<Theta>(theta*TO_RADIANS<Theta>);
+            auto t = LazyAngleComponents<Theta>(theta*TO_RADIANS<Theta>);
             const auto xp = (x-origin.x)*t.cos - (y-origin.y)*t.sin;
             const auto yp = (x-origin.x)*t.sin + (y-origin.y)*t.cos;
 
@@ -1062,9 +1362,7 @@ namespace Auxil {
         template<std::floating_point Theta>
         static Quaternion make_rotator(const v3<T>& rotation_axis, radians_t<Theta> angle) {
 
-            AngleComponents<Theta> components{};
-            components.sin = std::sin(angle * (Theta)0.5);
-            components.cos = std::cos(angle * (Theta)0.5);
+            const auto components = Auxil::sincos<Theta>(angle * (Theta)0.5);
             auto res = Quaternion{
                 components.cos,
                 components.sin * rotation_axis.x,
@@ -1213,7 +1511,7 @@ namespace Auxil {
         Quaternion operator-(const Quaternion& other) const {
             Quaternion res = *this;
             res -= other;
-            return *this;
+            return res;
         }
 
         template<Arithmetic Other>
@@ -1230,7 +1528,7 @@ namespace Auxil {
         Quaternion operator-(const v3<Other>& other) const {
             Quaternion q = *this;
 
-            q += other;
+            q -= other;
 
             return q;
         }
@@ -1246,7 +1544,7 @@ namespace Auxil {
         Quaternion operator-(const Other other) const {
             Quaternion q = *this;
 
-            q += other;
+            q -= other;
 
             return q;
         }
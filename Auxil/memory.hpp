@@ -0,0 +1,218 @@
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+#include <cstring>
+#include <memory_resource>
+
+#include "exception.hpp"
+#include "misc.hpp"
+
+namespace Auxil {
+    using namespace Primitives;
+
+    /*
+     * a bump allocator for scratch data that only lives until the next reset(), allocating is a pointer bump,
+     * deallocate does nothing, and reset() makes all of the memory available again in O(1) without giving it
+     * back to the upstream resource, so once the arena has grown to fit a frame it stops allocating entirely
+     *
+     * Array, Grid, LinkedList, CompactLinkedList and BasicStr all take a std::pmr::memory_resource*, so they can
+     * live in an arena, anything left in it must not be used after reset(), and the arena isn't thread safe
+     */
+    class FrameArena : public std::pmr::memory_resource {
+        //every block starts with this header, the blocks are kept in the order they were first used
+        struct Block {
+            Block* next;
+            usize size;
+
+            [[nodiscard]] std::byte* begin() {
+                return reinterpret_cast<std::byte*>(this + 1);
+            }
+
+            [[nodiscard]] std::byte* end() {
+                return begin() + size;
+            }
+        };
+
+        std::pmr::memory_resource* _upstream;
+        usize _block_size;
+        Block* _first{nullptr};
+        Block* _current{nullptr};
+        std::byte* _cursor{nullptr};
+        std::byte* _end{nullptr};
+        //bytes handed out in the blocks before the current one
+        usize _used_before{0};
+
+        void use(Block* block) {
+            if (_current) _used_before += static_cast<usize>(_cursor - _current->begin());
+            _current = block;
+            _cursor = block->begin();
+            _end = block->end();
+        }
+
+        //moves on to the next block that fits bytes, allocating one if there isn't one left
+        void next_block(const usize bytes, const usize alignment) {
+            const usize needed = bytes + alignment;
+            Block* prev = _current;
+            while (prev && prev->next) {
+                //blocks too small for this allocation are skipped until the next reset
+                if (prev->next->size >= needed) {
+                    use(prev->next);
+                    return;
+                }
+                prev = prev->next;
+            }
+
+            const usize size = std::max(_block_size, needed);
+            auto* block = static_cast<Block*>(_upstream->allocate(sizeof(Block) + size, alignof(std::max_align_t)));
+            block->next = nullptr;
+            block->size = size;
+
+            if (prev) prev->next = block;
+            else _first = block;
+            use(block);
+        }
+
+        void* do_allocate(const usize bytes, const usize alignment) override {
+            auto aligned = [&] {
+                const auto p = reinterpret_cast<uintptr_t>(_cursor);
+                return reinterpret_cast<std::byte*>((p + alignment - 1) & ~(alignment - 1));
+            };
+
+            std::byte* p = _cursor ? aligned() : nullptr;
+            if (!p || p + bytes > _end) {
+                next_block(bytes, alignment);
+                p = aligned();
+            }
+
+            _cursor = p + bytes;
+            return p;
+        }
+
+        void do_deallocate(void*, usize, usize) override {}
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        explicit FrameArena(const usize block_size = 64*1024,
+                            std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : _upstream(upstream), _block_size(std::max<usize>(block_size, 64)) {}
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        ~FrameArena() override {
+            release();
+        }
+
+        //makes every block available again, everything allocated from the arena is invalidated
+        void reset() noexcept {
+            _used_before = 0;
+            _current = nullptr;
+            if (_first) use(_first);
+        }
+
+        //gives every block back to the upstream resource
+        void release() noexcept {
+            Block* block = _first;
+            while (block) {
+                Block* next = block->next;
+                _upstream->deallocate(block, sizeof(Block) + block->size, alignof(std::max_align_t));
+                block = next;
+            }
+            _first = _current = nullptr;
+            _cursor = _end = nullptr;
+            _used_before = 0;
+        }
+
+        //how many bytes have been handed out since the last reset, including alignment padding
+        [[nodiscard]] usize bytes_used() const {
+            return _used_before + (_current ? static_cast<usize>(_cursor - _current->begin()) : 0);
+        }
+
+        //how many bytes the arena holds across all of its blocks
+        [[nodiscard]] usize capacity() const {
+            usize total = 0;
+            for (const Block* b = _first; b; b = b->next) total += b->size;
+            return total;
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* upstream() const {
+            return _upstream;
+        }
+    };
+
+    //resets an arena when it goes out of scope, for a frame's worth of scratch allocations
+    class ArenaScope {
+        FrameArena& _arena;
+
+    public:
+        explicit ArenaScope(FrameArena& arena) : _arena(arena) {}
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+        ~ArenaScope() {
+            _arena.reset();
+        }
+
+        [[nodiscard]] FrameArena* resource() const {
+            return &_arena;
+        }
+    };
+
+    //types that can be moved to a new address by copying their bytes, containers relocate these with memcpy or
+    //realloc instead of moving and destroying each element, specialize it for types that are trivially relocatable
+    //without being trivially copyable (most types that don't point into themselves)
+    template<typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template<typename T>
+    constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    namespace MemoryDetail {
+        //the capacity a container grows to when it needs room for required elements, 1.5x rather than 2x so that
+        //the blocks freed by earlier growth can be reused, this is the growth path every Auxil container shares
+        FORCE_INLINE usize grow_capacity(const usize capacity, const usize required) {
+            return std::max(required, capacity + capacity / 2 + 1);
+        }
+
+        //moves n elements from src to uninitialized dst and destroys the originals
+        template<typename T>
+        void relocate(T* src, const usize n, T* dst) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (n) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            } else {
+                std::uninitialized_move_n(src, n, dst);
+                std::destroy_n(src, n);
+            }
+        }
+
+        //containers store a null resource for the default one, so constructing them doesn't have to look it up
+        FORCE_INLINE std::pmr::memory_resource* resolve(std::pmr::memory_resource* resource) {
+            return resource ? resource : std::pmr::get_default_resource();
+        }
+
+        //the storage behind Array, Grid and friends, elements are constructed and destroyed separately, a null resource
+        //is resolved here and kept, so the storage goes back to the same resource even if the default changes
+        template<typename T>
+        T* allocate(std::pmr::memory_resource*& resource, const usize n) {
+            if (n == 0) return nullptr;
+            resource = resolve(resource);
+            return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        template<typename T>
+        void deallocate(std::pmr::memory_resource* resource, T* ptr, const usize n) {
+            if (ptr) resolve(resource)->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        //destroys n elements, free for trivially destructible types
+        template<typename T>
+        FORCE_INLINE void destroy(T* ptr, const usize n) {
+            if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_n(ptr, n);
+        }
+    }
+}
+
+#endif //MEMORY_HPP
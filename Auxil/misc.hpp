@@ -46,6 +46,9 @@ namespace Auxil {
         return condition ? _true:_false;
     }
 
+    //copies every piece and keeps the empty ones, a string shorter than del gives no pieces at all, note that
+    //strview(s).split(del) in str.hpp is not a drop-in replacement, it skips empty pieces and gives s itself when
+    //del is longer than s
     inline std::vector<std::string> split(const std::string& s, const std::string& del = " ") {
         if (s.size() < del.size()) return {};
         if (del.empty()) return {s};
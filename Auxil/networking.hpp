@@ -1,12 +1,17 @@
 #ifndef NETWORKING_HPP
 #define NETWORKING_HPP
+#include <condition_variable>
+#include <deque>
 #include <iosfwd>
 #include <iostream>
 #include <streambuf>
 #include "misc.hpp"
+//boost's awaitable.hpp uses std::exchange without including <utility> itself
+#include <utility>
 #include <boost/asio.hpp>
 #include <concepts>
 #include "containers.hpp"
+#include "math.hpp"
 #include "str.hpp"
 
 
@@ -21,6 +26,15 @@ namespace Auxil {
      *
      * template<typename F, typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<F>, u8>>>
      * static T deserialize(F&& func)
+     *
+     * it can also have a serialize_into, which appends the bytes to a buffer the writer reuses instead of
+     * allocating an Array for every value
+     * static void serialize_into(const T& data, std::vector<u8>& out)
+     *
+     * it can also have a span based deserialize, which the readers use instead of the callback when it exists
+     * static usize deserialize(std::span<const u8> bytes, T& out)
+     * bytes is everything that has been received but not read yet, it returns how many bytes the value
+     * took up, or 0 if bytes doesn't hold the whole value yet (out may be left half written in that case)
      */
     template<typename T>
     struct ByteSerializer {};
@@ -37,6 +51,12 @@ namespace Auxil {
             return result;
         }
 
+        static void serialize_into(const T& data, std::vector<u8>& out) {
+            const usize at = out.size();
+            out.resize(at + sizeof(T));
+            std::memcpy(out.data() + at, &data, sizeof(T));
+        }
+
 
         template<typename F, typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<F>, u8>>>
         static T deserialize(F&& get_callback) {
@@ -50,8 +70,23 @@ namespace Auxil {
 
             return res;
         }
+
+        static usize deserialize(const std::span<const u8> bytes, T& out) {
+            if (bytes.size() < sizeof(T)) return 0;
+            std::memcpy(&out, bytes.data(), sizeof(T));
+
+            return sizeof(T);
+        }
     };
 
+    //finds the '\0' ending a serialized string, returns the string's length or npos if it hasn't arrived yet
+    inline usize terminated_length(const std::span<const u8> bytes) {
+        const void* end = std::memchr(bytes.data(), '\0', bytes.size());
+        if (!end) return std::numeric_limits<usize>::max();
+
+        return static_cast<const u8*>(end) - bytes.data();
+    }
+
     template<>
     struct ByteSerializer<std::string> {
 
@@ -64,6 +99,12 @@ namespace Auxil {
             return res;
         }
 
+        static void serialize_into(const std::string& data, std::vector<u8>& out) {
+            const auto* bytes = reinterpret_cast<const u8*>(data.data());
+            out.insert(out.end(), bytes, bytes + data.size());
+            out.push_back(0);
+        }
+
 
         template<typename F, typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<F>, u8>>>
         static std::string deserialize(F&& get_callback) {
@@ -75,6 +116,14 @@ namespace Auxil {
 
             return result;
         }
+
+        static usize deserialize(const std::span<const u8> bytes, std::string& out) {
+            const usize len = terminated_length(bytes);
+            if (len == std::numeric_limits<usize>::max()) return 0;
+            out.assign(reinterpret_cast<const char*>(bytes.data()), len);
+
+            return len+1;
+        }
     };
 
 
@@ -90,6 +139,12 @@ namespace Auxil {
             return res;
         }
 
+        static void serialize_into(const str& data, std::vector<u8>& out) {
+            const auto* bytes = reinterpret_cast<const u8*>(data.c_str());
+            out.insert(out.end(), bytes, bytes + data.size());
+            out.push_back(0);
+        }
+
 
         template<typename F, typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<F>, u8>>>
         static str deserialize(F&& get_callback) {
@@ -100,6 +155,14 @@ namespace Auxil {
 
             return result;
         }
+
+        static usize deserialize(const std::span<const u8> bytes, str& out) {
+            const usize len = terminated_length(bytes);
+            if (len == std::numeric_limits<usize>::max()) return 0;
+            out = str(reinterpret_cast<const char*>(bytes.data()), len);
+
+            return len+1;
+        }
     };
 
 
@@ -111,6 +174,470 @@ namespace Auxil {
         { ByteSerializer<T>::deserialize(bytes) } -> std::convertible_to<T>;
     };
 
+    template<typename T>
+    concept AppendSerializable = Serializable<T> && requires(const T data, std::vector<u8>& out)
+    {
+        ByteSerializer<T>::serialize_into(data, out);
+    };
+
+    template<typename T>
+    concept SpanDeserializable = Serializable<T> && std::default_initializable<T> &&
+    requires(const std::span<const u8> bytes, T& out)
+    {
+        { ByteSerializer<T>::deserialize(bytes, out) } -> std::same_as<usize>;
+    };
+
+    //deserializes a T from bytes that are already all in memory, like the payload of a frame
+    template<Serializable T>
+    T deserialize_from(const std::span<const u8> bytes) {
+        if constexpr (SpanDeserializable<T>) {
+            T res;
+            if (ByteSerializer<T>::deserialize(bytes, res) == 0) {
+                throw Exception("{} bytes is too short to deserialize the value from", bytes.size());
+            }
+            return res;
+        } else {
+            usize i = 0;
+            return ByteSerializer<T>::deserialize([bytes, &i]() -> u8 {
+                if (i == bytes.size()) throw Exception("{} bytes is too short to deserialize the value from", bytes.size());
+                return bytes[i++];
+            });
+        }
+    }
+
+    //frames are a big endian u32 payload length followed by the payload
+    using FrameLength = u32;
+
+    //bytes that have been read from a socket but not consumed yet, grows when a single value doesn't fit
+    struct ReceiveBuffer {
+        std::vector<u8> bytes = std::vector<u8>(1024);
+        usize pos{0};
+        usize size{0};
+        //frames claiming to be longer than this are rejected before anything is allocated for them
+        usize max_frame = 64 * 1024 * 1024;
+
+        //how many of the unread bytes are already known not to hold a '\0' and the read position that was
+        //true at, so a string that arrives over many reads is only scanned once instead of from the start
+        //after every read
+        usize scanned{0};
+        usize scanned_at{0};
+        //how many unread bytes the last callback deserialize ran out after and the read position that was
+        //at, running it again can't get any further until more than that have arrived
+        usize exhausted{0};
+        usize exhausted_at{0};
+
+        //thrown by try_read's byte callback when a value runs past the end of the buffered bytes
+        struct Exhausted {};
+
+        [[nodiscard]] bool empty() const {
+            return pos == size;
+        }
+
+        [[nodiscard]] usize available() const {
+            return size - pos;
+        }
+
+        u8 next() {
+            return bytes[pos++];
+        }
+
+        void clear() {
+            pos = 0;
+            size = 0;
+            scanned = 0;
+            exhausted = 0;
+        }
+
+        //moves the unread bytes to the front and returns the free space after them, doubling the
+        //buffer when there isn't any
+        boost::asio::mutable_buffer prepare() {
+            if (pos > 0) {
+                std::memmove(bytes.data(), bytes.data() + pos, size - pos);
+                size -= pos;
+                //pos only ever grows otherwise, so this is the one place a stale mark could look current
+                if (scanned_at != pos) scanned = 0;
+                if (exhausted_at != pos) exhausted = 0;
+                scanned_at = 0;
+                exhausted_at = 0;
+                pos = 0;
+            }
+            if (size == bytes.size()) bytes.resize(std::max<usize>(bytes.size()*2, 1024));
+
+            return boost::asio::buffer(bytes.data() + size, bytes.size() - size);
+        }
+
+        //copies up to n buffered bytes into out, returns how many were copied
+        usize take(u8* out, const usize n) {
+            const usize count = std::min(n, available());
+            std::memcpy(out, bytes.data() + pos, count);
+            pos += count;
+            return count;
+        }
+
+        //makes the buffer hold at least n bytes, so a single read_some can take in up to n bytes at once
+        void reserve(const usize n) {
+            prepare();
+            if (n > bytes.size()) bytes.resize(n);
+        }
+
+        //consumes the length prefix of the next frame, or returns nothing if it hasn't fully arrived
+        std::optional<usize> try_take_frame_length() {
+            if (available() < sizeof(FrameLength)) return std::nullopt;
+
+            FrameLength len;
+            std::memcpy(&len, bytes.data() + pos, sizeof(FrameLength));
+            len = ntoh(len);
+            if (len > max_frame) {
+                throw Exception("Received a frame of {} bytes, the limit is {} bytes", len, max_frame);
+            }
+
+            pos += sizeof(FrameLength);
+            return len;
+        }
+
+        //marks n bytes written into the space from prepare as readable
+        void commit(const usize n) {
+            size += n;
+        }
+
+        [[nodiscard]] std::span<const u8> unread() const {
+            return {bytes.data() + pos, available()};
+        }
+
+        //the length of the '\0' terminated string at the read position, or npos if the '\0' hasn't
+        //arrived yet, picks up the search where the last call left off
+        usize find_terminator() {
+            if (scanned_at != pos) scanned = 0;
+
+            const usize len = terminated_length(unread().subspan(scanned));
+            if (len == std::numeric_limits<usize>::max()) {
+                scanned = available();
+                scanned_at = pos;
+                return len;
+            }
+
+            return scanned + len;
+        }
+
+        //deserializes a T from the buffered bytes, or returns nothing (and consumes nothing) if the value
+        //isn't completely buffered yet
+        template<Serializable T>
+        std::optional<T> try_read() {
+            if constexpr (std::same_as<T, std::string> || std::same_as<T, str>) {
+                const usize len = find_terminator();
+                if (len == std::numeric_limits<usize>::max()) return std::nullopt;
+
+                std::optional<T> res{std::in_place, reinterpret_cast<const char*>(bytes.data() + pos), len};
+                pos += len+1;
+                return res;
+            } else if constexpr (SpanDeserializable<T>) {
+                std::optional<T> res{std::in_place};
+                const usize n = ByteSerializer<T>::deserialize(unread(), *res);
+                if (n == 0) return std::nullopt;
+
+                pos += n;
+                return res;
+            }
+
+            if (exhausted != 0 && exhausted_at == pos && available() <= exhausted) return std::nullopt;
+
+            usize cursor = pos;
+            try {
+                std::optional<T> res{ByteSerializer<T>::deserialize([this, &cursor]() -> u8 {
+                    if (cursor == size) throw Exhausted{};
+                    return bytes[cursor++];
+                })};
+                pos = cursor;
+                return res;
+            } catch (const Exhausted&) {
+                exhausted = available();
+                exhausted_at = pos;
+                return std::nullopt;
+            }
+        }
+
+        //a view of the next '\0' terminated string straight out of the buffer, valid until the buffer is
+        //read into again
+        std::optional<std::string_view> try_borrow_string() {
+            const usize len = find_terminator();
+            if (len == std::numeric_limits<usize>::max()) return std::nullopt;
+
+            std::string_view res{reinterpret_cast<const char*>(bytes.data() + pos), len};
+            pos += len+1;
+            return res;
+        }
+    };
+
+    //when to send queued writes without waiting for a flush, 0 turns it off
+    //like Nagle's algorithm this trades a little latency for fewer, larger writes, nothing is sent on a
+    //timer so call flush once a burst of messages is done
+    struct AutoFlush {
+        usize max_bytes{0};
+    };
+
+    //serialized values waiting to go out in a single write, reused between writes so it only ever
+    //allocates when it has to grow
+    struct WriteBuffer {
+        std::vector<u8> bytes;
+
+        template<Serializable... Ts>
+        void append(const Ts&... values) {
+            (append_one(values), ...);
+        }
+
+        //appends the values as a single frame
+        template<Serializable... Ts>
+        void append_frame(const Ts&... values) {
+            const usize at = bytes.size();
+            bytes.resize(at + sizeof(FrameLength));
+            (append_one(values), ...);
+
+            const usize len = bytes.size() - at - sizeof(FrameLength);
+            if (len > std::numeric_limits<FrameLength>::max()) {
+                bytes.resize(at);
+                throw Exception("A frame can hold at most {} bytes, got {}", std::numeric_limits<FrameLength>::max(), len);
+            }
+            const FrameLength prefix = hton(static_cast<FrameLength>(len));
+            std::memcpy(bytes.data() + at, &prefix, sizeof(FrameLength));
+        }
+
+        template<Serializable T>
+        void append_one(const T& value) {
+            if constexpr (AppendSerializable<T>) {
+                ByteSerializer<T>::serialize_into(value, bytes);
+            } else {
+                auto serialized = ByteSerializer<T>::serialize(value);
+                bytes.insert(bytes.end(), serialized.begin(), serialized.end());
+            }
+        }
+
+        //whether the queued bytes should be sent under the given policy
+        [[nodiscard]] bool due(const AutoFlush& policy) const {
+            return !bytes.empty() && policy.max_bytes != 0 && bytes.size() >= policy.max_bytes;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return bytes.empty();
+        }
+
+        [[nodiscard]] usize size() const {
+            return bytes.size();
+        }
+
+        void clear() {
+            bytes.clear();
+        }
+
+        [[nodiscard]] boost::asio::const_buffer buffer() const {
+            return boost::asio::buffer(bytes.data(), bytes.size());
+        }
+    };
+
+    //a fixed set of threads running a shared io_context, every Client and Server constructed with the pool
+    //has its coroutine reads/writes (and the *_async functions) driven by these threads instead of
+    //spawning one thread per call, the pool must outlive everything constructed with it
+    class IOContextPool {
+        boost::asio::io_context io;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> guard;
+        std::vector<std::thread> threads;
+
+    public:
+        explicit IOContextPool(const u32 n_threads = 1) :
+            io(static_cast<int>(std::max<u32>(1, n_threads))),
+            guard(boost::asio::make_work_guard(io)) {
+            threads.reserve(std::max<u32>(1, n_threads));
+            for (u32 i = 0; i < std::max<u32>(1, n_threads); i++) {
+                threads.emplace_back([this] { io.run(); });
+            }
+        }
+
+        ~IOContextPool() {
+            stop();
+        }
+
+        IOContextPool(const IOContextPool&) = delete;
+        IOContextPool& operator=(const IOContextPool&) = delete;
+
+        //stops the threads, pending operations are abandoned
+        void stop() {
+            guard.reset();
+            io.stop();
+            for (auto& t: threads) {
+                if (t.joinable()) t.join();
+            }
+        }
+
+        boost::asio::io_context& context() {
+            return io;
+        }
+
+        [[nodiscard]] u32 size() const {
+            return threads.size();
+        }
+
+        //runs a coroutine on the pool, the future gets its result (or exception)
+        template<typename T>
+        std::future<T> spawn(boost::asio::awaitable<T> task) {
+            return boost::asio::co_spawn(io, std::move(task), boost::asio::use_future);
+        }
+
+        //runs a coroutine on the pool without a way to get its result, exceptions are dropped
+        void detach(boost::asio::awaitable<void> task) {
+            boost::asio::co_spawn(io, std::move(task), boost::asio::detached);
+        }
+    };
+
+    //runs coroutines on a strand of an IOContextPool one after another, each one starts after the one
+    //before it has finished, so operations that suspend halfway through using a connection's buffers
+    //never overlap, pool-bound clients send their *_async functions through one
+    class OperationQueue : public std::enable_shared_from_this<OperationQueue> {
+        boost::asio::strand<boost::asio::io_context::executor_type> strand;
+        //only touched on the strand
+        std::deque<std::function<boost::asio::awaitable<void>()>> jobs;
+        bool draining{false};
+        //a parked job waits on this until wake() cancels it
+        boost::asio::steady_timer wakeup;
+
+        static boost::asio::awaitable<void> drain(std::shared_ptr<OperationQueue> self) {
+            while (!self->jobs.empty()) {
+                auto job = std::move(self->jobs.front());
+                self->jobs.pop_front();
+                co_await job();
+            }
+
+            self->draining = false;
+        }
+
+    public:
+        explicit OperationQueue(IOContextPool& pool) : strand(boost::asio::make_strand(pool.context())), wakeup(strand) {}
+
+        //parks the running job until wake(), without holding up the thread it runs on
+        boost::asio::awaitable<void> park() {
+            wakeup.expires_at(boost::asio::steady_timer::time_point::max());
+            boost::system::error_code ec;
+            co_await wakeup.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        }
+
+        //callable from any thread, the jobs run on the strand so a wake posted before the job parks still reaches it
+        void wake() {
+            boost::asio::post(strand, [self = shared_from_this()] { self->wakeup.cancel(); });
+        }
+
+        //queues the coroutine make_op returns, the future gets its result (or exception)
+        template<typename F, typename T = typename std::invoke_result_t<const F&>::value_type>
+        std::future<T> push(F make_op) {
+            auto done = std::make_shared<std::promise<T>>();
+            auto res = done->get_future();
+
+            auto job = [make_op = std::move(make_op), done]() -> boost::asio::awaitable<void> {
+                try {
+                    if constexpr (std::is_void_v<T>) {
+                        co_await make_op();
+                        done->set_value();
+                    } else {
+                        done->set_value(co_await make_op());
+                    }
+                } catch (...) {
+                    done->set_exception(std::current_exception());
+                }
+            };
+
+            boost::asio::post(strand, [self = shared_from_this(), job = std::move(job)]() mutable {
+                self->jobs.emplace_back(std::move(job));
+                if (!std::exchange(self->draining, true)) {
+                    boost::asio::co_spawn(self->strand, drain(self), boost::asio::detached);
+                }
+            });
+
+            return res;
+        }
+    };
+
+    /*
+     * keeps the blocking functions of a client and its *_async operations out of each other's way, a blocking function
+     * waits on a condition variable, an *_async operation that finds the client in use parks on its queue instead
+     * and is woken by the blocking function when it's done, so it never holds up a pool thread
+     */
+    class ClientGate {
+        std::mutex mtx;
+        std::condition_variable idle;
+        //a blocking function is using the client
+        bool blocking{false};
+        //an *_async operation is using the client
+        bool async{false};
+        //set while an *_async operation is parked, it goes before any blocking function that comes after it
+        std::shared_ptr<OperationQueue> parked;
+
+        void release() {
+            std::shared_ptr<OperationQueue> waiter;
+            {
+                std::lock_guard lk(mtx);
+                blocking = false;
+                waiter = parked;
+            }
+            idle.notify_all();
+            if (waiter) waiter->wake();
+        }
+
+    public:
+        //what a blocking function holds for as long as it uses the client
+        class Hold {
+            ClientGate* gate;
+
+        public:
+            explicit Hold(ClientGate* g) : gate(g) {}
+            Hold(const Hold&) = delete;
+            Hold& operator=(const Hold&) = delete;
+            ~Hold() { gate->release(); }
+        };
+
+        //blocks until nothing else uses the client
+        [[nodiscard]] Hold lock() {
+            std::unique_lock lk(mtx);
+            idle.wait(lk, [this] { return !blocking && !async && !parked; });
+            blocking = true;
+            return Hold(this);
+        }
+
+        //waits for the blocking functions only, for close() to cancel a running *_async operation, nothing new can
+        //start using the client while the returned lock is held
+        [[nodiscard]] std::unique_lock<std::mutex> interrupt() {
+            std::unique_lock lk(mtx);
+            idle.wait(lk, [this] { return !blocking; });
+            return lk;
+        }
+
+        //runs op, an *_async operation of queue, once nothing else uses the client
+        template<typename T>
+        boost::asio::awaitable<T> exclusive(std::shared_ptr<OperationQueue> queue, boost::asio::awaitable<T> op) {
+            while (true) {
+                {
+                    std::lock_guard lk(mtx);
+                    if (!blocking) {
+                        async = true;
+                        parked = nullptr;
+                        break;
+                    }
+                    parked = queue;
+                }
+                co_await queue->park();
+            }
+
+            struct Release {
+                ClientGate* gate;
+                ~Release() {
+                    {
+                        std::lock_guard lk(gate->mtx);
+                        gate->async = false;
+                    }
+                    gate->idle.notify_all();
+                }
+            } release{this};
+
+            co_return co_await std::move(op);
+        }
+    };
+
     //a simple skeleton for a server class
     class Server {
 
@@ -121,6 +648,7 @@ namespace Auxil {
 
         boost::asio::io_context context;
         tcp::acceptor acceptor;
+        IOContextPool* pool{nullptr};
 
     public:
         virtual ~Server() = default;
@@ -131,10 +659,17 @@ namespace Auxil {
             port
             )) {}
 
+        //accepted connections live on the pool's io_context
+        Server(IOContextPool& io_pool, const boost::asio::ip::address& ip_addr, const u16 port) :
+        acceptor(io_pool.context(), tcp::endpoint(
+            ip_addr,
+            port
+            )), pool(&io_pool) {}
+
         //copying a server doesnt make sense
         Server(const Server&) = delete;
         Server(Server&& serv) noexcept :
-            acceptor(std::move(serv.acceptor)) {}
+            acceptor(std::move(serv.acceptor)), pool(serv.pool) {}
 
         Server& operator=(Server&) = delete;
         Server& operator=(Server&& serv) noexcept {
@@ -144,6 +679,7 @@ namespace Auxil {
 
             //then move the values
             acceptor = std::move(serv.acceptor);
+            pool = serv.pool;
 
             return *this;
         }
@@ -161,15 +697,28 @@ namespace Auxil {
         boost::asio::io_context io;
         tcp::resolver resolver;
         tcp::socket socket;
-        std::mutex mtx;
+        IOContextPool* pool{nullptr};
+        //the *_async functions of a pool-bound client run through this one at a time
+        std::shared_ptr<OperationQueue> ops;
+        ClientGate gate;
 
-
-        std::array<u8, 1024> buffer{0};
-        usize buf_pos{0};
-        usize data_size{0};
+        ReceiveBuffer buffer;
+        WriteBuffer out;
+        AutoFlush auto_flush;
 
         atomic_bool has_connection = true;
 
+        //holds the client for a blocking function
+        ClientGate::Hold lock() {
+            return gate.lock();
+        }
+
+        //runs op as an *_async operation, keeping the blocking functions out until it's done
+        template<typename T>
+        boost::asio::awaitable<T> exclusive(boost::asio::awaitable<T> op) {
+            return gate.exclusive(ops, std::move(op));
+        }
+
         template<typename ErrorResolver, typename = std::enable_if_t<std::invocable<ErrorResolver, boost::system::error_code>>>
         void connect(const tcp::resolver::results_type& endpoints, ErrorResolver&& resolver) {
             boost::system::error_code ec;
@@ -181,15 +730,14 @@ namespace Auxil {
         }
 
         void get_data() {
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
             get_data_unlocked();
         }
 
         void get_data_unlocked() {
             if (!has_connection) throw Exception("Cannot read data from unconnected server");
             boost::system::error_code ec;
-            data_size = socket.read_some(boost::asio::buffer(buffer), ec);
-            buf_pos = 0;
+            buffer.commit(socket.read_some(buffer.prepare(), ec));
 
             if (ec) {
                 throw Exception("Failed to read data with error: {}", ec.message());
@@ -197,9 +745,49 @@ namespace Auxil {
         }
 
         u8 get_byte_unlocked() {
-            if (buf_pos == data_size) get_data_unlocked();
+            if (buffer.empty()) get_data_unlocked();
+
+            return buffer.next();
+        }
+
+        //reads n bytes into dst, whatever isn't buffered already is read straight into dst
+        void read_exact_unlocked(u8* dst, const usize n) {
+            const usize have = buffer.take(dst, n);
+            if (have == n) return;
+            if (!has_connection) throw Exception("Cannot read data from unconnected server");
+
+            boost::system::error_code ec;
+            boost::asio::read(socket, boost::asio::buffer(dst + have, n - have), ec);
+
+            if (ec) {
+                throw Exception("Failed to read data with error: {}", ec.message());
+            }
+        }
+
+        void flush_unlocked() {
+            if (out.empty()) return;
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            boost::system::error_code ec;
+            boost::asio::write(socket, out.buffer(), ec);
+            out.clear();
+
+            if (ec) {
+                throw Exception("Failed to write data with error: {}", ec.message());
+            }
+        }
+
+        //reads whatever the server has sent so far after the bytes that are already buffered
+        boost::asio::awaitable<void> co_fill() {
+            if (!has_connection) throw Exception("Cannot read data from unconnected server");
+            boost::system::error_code ec;
+            const usize n = co_await socket.async_read_some(buffer.prepare(),
+                boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
-            return buffer[buf_pos++];
+            if (ec) {
+                throw Exception("Failed to read data with error: {}", ec.message());
+            }
+            buffer.commit(n);
         }
 
 
@@ -220,34 +808,50 @@ namespace Auxil {
             });
         }
 
+        //the socket lives on the pool's io_context, so the coroutine functions and the *_async
+        //functions run on the pool's threads
+        Client(IOContextPool& io_pool, boost::asio::ip::address ip_addr, const u16 port) :
+        resolver(io_pool.context()), socket(io_pool.context()), pool(&io_pool),
+        ops(std::make_shared<OperationQueue>(io_pool)) {
+            const tcp::resolver::results_type endpoints = resolver.resolve(ip_addr.to_string(), std::to_string(port));
+
+            connect(endpoints, [ip_addr, port](const boost::system::error_code& ec) {
+                throw Exception("Failed to connect to \"{}:{}\": {}", ip_addr.to_string(), port, ec.message());
+            });
+        }
+
         Client(const Client&) = delete;
         Client(Client&& c)  noexcept :
         resolver(std::move(c.resolver)),
         socket(std::move(c.socket)),
-        buffer(c.buffer),
-        buf_pos(c.buf_pos),
-        data_size(c.data_size),
+        pool(c.pool),
+        ops(std::move(c.ops)),
+        buffer(std::move(c.buffer)),
+        out(std::move(c.out)),
+        auto_flush(c.auto_flush),
         has_connection(c.has_connection.load()) {
             c.has_connection = false;
-            c.data_size = 0;
-            c.buf_pos = 0;
+            c.buffer.clear();
+            c.out.clear();
         }
 
         Client& operator=(const Client&) = delete;
         Client& operator=(Client&& c)  noexcept {
             this->close();
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
 
             resolver = std::move(c.resolver);
             socket = std::move(c.socket);
-            buffer = c.buffer;
-            buf_pos = c.buf_pos;
-            data_size = c.data_size;
+            pool = c.pool;
+            ops = std::move(c.ops);
+            buffer = std::move(c.buffer);
+            out = std::move(c.out);
+            auto_flush = c.auto_flush;
             has_connection = c.has_connection.load();
 
             c.has_connection = false;
-            c.data_size = 0;
-            c.buf_pos = 0;
+            c.buffer.clear();
+            c.out.clear();
 
             return *this;
         }
@@ -257,9 +861,10 @@ namespace Auxil {
         }
 
 
+        //doesn't wait for the *_async functions, closing the socket cancels whatever they are waiting on
         void close() {
             if (!has_connection) return;
-            std::lock_guard lk(mtx);
+            const auto lk = gate.interrupt();
             socket.close();
 
             has_connection = false;
@@ -269,7 +874,7 @@ namespace Auxil {
             //first close the current connection
             if (has_connection) close();
 
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
 
             const tcp::resolver::results_type endpoints = resolver.resolve(ip, std::to_string(port));
 
@@ -282,7 +887,7 @@ namespace Auxil {
             //first close the current connection
             if (has_connection) close();
 
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
 
             tcp::resolver::results_type endpoints = resolver.resolve(ip, service);
 
@@ -291,34 +896,58 @@ namespace Auxil {
             });
         }
 
-        //writes to the server, blocks until the message has been sent
-        template<Serializable T>
-        void write(const T& data) {
-            std::lock_guard lk(mtx);
+        //writes every value (after anything that was queued) to the server with a single write,
+        //blocks until the message has been sent
+        template<Serializable T, Serializable... Ts>
+        void write(const T& data, const Ts&... rest) {
+            const auto lk = lock();
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            out.append(data, rest...);
+            flush_unlocked();
+        }
+
+        //adds the values to the write buffer without sending them, they go out with the next write or flush,
+        //or as soon as the auto flush threshold is reached
+        template<Serializable... Ts>
+        void queue(const Ts&... values) {
+            const auto lk = lock();
             if (!has_connection) throw Exception("Cannot write data to unconnected server");
 
-            auto bytes = ByteSerializer<T>::serialize(data);
+            out.append(values...);
+            if (out.due(auto_flush)) flush_unlocked();
+        }
+
+        //sends everything that has been queued
+        void flush() {
+            const auto lk = lock();
+            flush_unlocked();
+        }
+
+        void set_auto_flush(const AutoFlush& policy) {
+            const auto lk = lock();
+            auto_flush = policy;
+        }
 
-            boost::asio::write(socket, boost::asio::buffer(bytes.data(), bytes.size()));
+        //how many bytes are queued but not sent yet
+        [[nodiscard]] usize queued() {
+            const auto lk = lock();
+            return out.size();
         }
 
         //gets the next byte of data from the server, potentially reads in up to 1024 bytes
         //if the internal buffer runs out, in such a case it would block until it reads something
         u8 get_next_byte() {
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
             return get_byte_unlocked();
         }
 
         Array<u8> get_n_bytes(const usize n) {
-            std::lock_guard lk(mtx);
+            const auto lk = lock();
 
             Array<u8> result(n);
 
-            for (usize i = 0; i < n; i++) {
-                if (buf_pos == data_size) get_data_unlocked();
-
-                result[i] = buffer[buf_pos++];
-            }
+            read_exact_unlocked(result.data(), n);
 
             return result;
         }
@@ -329,66 +958,252 @@ namespace Auxil {
             //this ensures the serializer is not interupted by another reader
             //causing issues where it reads every other byte instead of
             //a continuous stream of bytes
-            std::lock_guard lk(mtx);
-            return ByteSerializer<T>::deserialize([this]() -> u8 {
-                return get_byte_unlocked();
-            });
-        }
+            const auto lk = lock();
+            if constexpr (SpanDeserializable<T>) {
+                while (true) {
+                    if (auto res = buffer.try_read<T>()) return std::move(*res);
 
-        //writes the data asynchronously
-        template<Serializable T>
-        std::future<void> write_async(const T& data) {
-            return std::async(std::launch::async, &Client::write<T>, this, data);
+                    get_data_unlocked();
+                }
+            } else {
+                return ByteSerializer<T>::deserialize([this]() -> u8 {
+                    return get_byte_unlocked();
+                });
+            }
         }
 
-        std::future<u8> async_next_byte() {
-            return std::async(std::launch::async, &Client::get_next_byte, this);
+        //reads a '\0' terminated string without copying it, the view points into the receive buffer
+        //and is only valid until the next read
+        std::string_view read_view() {
+            const auto lk = lock();
+            while (true) {
+                if (auto res = buffer.try_borrow_string()) return *res;
+
+                get_data_unlocked();
+            }
         }
 
-        std::future<Array<u8>> async_n_bytes(const usize n) {
-            return std::async(std::launch::async, &Client::get_n_bytes, this, n);
+        //reads a whole length prefixed frame, once the length is known the rest of the payload is read
+        //into the result in one go instead of through the receive buffer
+        Array<u8> read_frame() {
+            const auto lk = lock();
+            std::optional<usize> len;
+            while (!(len = buffer.try_take_frame_length())) get_data_unlocked();
+
+            Array<u8> result(*len);
+            read_exact_unlocked(result.data(), *len);
+            return result;
         }
 
+        //reads a frame and deserializes a T from its payload
         template<Serializable T>
-        std::future<T> read_async() {
-            return std::async(std::launch::async, &Client::read<T>, this);
+        T read_frame_as() {
+            const auto payload = read_frame();
+            return deserialize_from<T>({payload.data(), payload.size()});
         }
-    };
 
-    //a thread-safe server that only talks to one client at a time,
-    //closes the connection with that client when done or when it wants to accept a new connection
-    //implemented as a sort of 'stream'
-    class SingleServer final : public Server {
-    protected:
-        tcp::socket client;
-        atomic_bool has_connection{false};
-        std::array<u8, 1024> buffer{0};
-        usize buf_pos{0};
-        usize data_size{0};
+        //writes the values (after anything queued) as a single length prefixed frame
+        template<Serializable... Ts>
+        void write_frame(const Ts&... values) {
+            const auto lk = lock();
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
 
-        void get_data() {
+            out.append_frame(values...);
+            flush_unlocked();
+        }
+
+        //adds the values to the write buffer as a frame without sending it
+        template<Serializable... Ts>
+        void queue_frame(const Ts&... values) {
+            const auto lk = lock();
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            out.append_frame(values...);
+            if (out.due(auto_flush)) flush_unlocked();
+        }
+
+        //lets a single read take in up to n bytes, the buffer still grows past this for values that don't fit
+        void set_receive_buffer_size(const usize n) {
+            const auto lk = lock();
+            buffer.reserve(n);
+        }
+
+        void set_max_frame_size(const usize n) {
+            const auto lk = lock();
+            buffer.max_frame = n;
+        }
+
+        //the co_* functions suspend the calling coroutine instead of blocking a thread, they don't take the
+        //client's lock (it can't be held across a suspension) so only one coroutine should read at a time
+        //and they shouldn't be mixed with the blocking reads of another thread, the *_async functions
+        //queue them so they can be
+
+        //sends everything in the write buffer, reusing it like flush does
+        boost::asio::awaitable<void> co_flush() {
+            if (out.empty()) co_return;
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            boost::system::error_code ec;
+            co_await boost::asio::async_write(socket, out.buffer(), boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            out.clear();
+
+            if (ec) {
+                throw Exception("Failed to write data with error: {}", ec.message());
+            }
+        }
+
+        //the values are sent after anything that was queued, all in one write
+        template<Serializable T, Serializable... Ts>
+        boost::asio::awaitable<void> co_write(const T data, const Ts... rest) {
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            out.append(data, rest...);
+            co_await co_flush();
+        }
+
+        boost::asio::awaitable<u8> co_next_byte() {
+            if (buffer.empty()) co_await co_fill();
+
+            co_return buffer.next();
+        }
+
+        boost::asio::awaitable<Array<u8>> co_n_bytes(const usize n) {
+            Array<u8> result(n);
+
+            for (usize i = 0; i < n;) {
+                if (buffer.empty()) co_await co_fill();
+
+                i += buffer.take(result.data() + i, n - i);
+            }
+
+            co_return result;
+        }
+
+        //the deserializer pulls bytes through a callback that can't suspend, so it's run over the bytes
+        //that are already buffered and retried once more have arrived if it runs out
+        template<Serializable T>
+        boost::asio::awaitable<T> co_read() {
+            while (true) {
+                if (auto res = buffer.try_read<T>()) co_return std::move(*res);
+
+                co_await co_fill();
+            }
+        }
+
+        boost::asio::awaitable<Array<u8>> co_read_frame() {
+            std::optional<usize> len;
+            while (!(len = buffer.try_take_frame_length())) co_await co_fill();
+
+            Array<u8> result(*len);
+            const usize have = buffer.take(result.data(), *len);
+            if (have < *len) {
+                if (!has_connection) throw Exception("Cannot read data from unconnected server");
+                co_await boost::asio::async_read(socket, boost::asio::buffer(result.data() + have, *len - have), boost::asio::use_awaitable);
+            }
+
+            co_return result;
+        }
+
+        template<Serializable T>
+        boost::asio::awaitable<T> co_read_frame_as() {
+            const auto payload = co_await co_read_frame();
+            co_return deserialize_from<T>({payload.data(), payload.size()});
+        }
+
+        template<Serializable... Ts>
+        boost::asio::awaitable<void> co_write_frame(const Ts... values) {
+            if (!has_connection) throw Exception("Cannot write data to unconnected server");
+
+            out.append_frame(values...);
+            co_await co_flush();
+        }
+
+        //the *_async functions are safe to call from any thread, on a pool-bound client they run one at a
+        //time in the order they were called and the blocking functions wait for them
+
+        //writes the data asynchronously
+        template<Serializable T>
+        std::future<void> write_async(const T& data) {
+            if (ops) return ops->push([this, data] { return exclusive(co_write<T>(data)); });
+            return std::async(std::launch::async, [this, data] { write(data); });
+        }
+
+        std::future<u8> async_next_byte() {
+            if (ops) return ops->push([this] { return exclusive(co_next_byte()); });
+            return std::async(std::launch::async, &Client::get_next_byte, this);
+        }
+
+        std::future<Array<u8>> async_n_bytes(const usize n) {
+            if (ops) return ops->push([this, n] { return exclusive(co_n_bytes(n)); });
+            return std::async(std::launch::async, &Client::get_n_bytes, this, n);
+        }
+
+        template<Serializable T>
+        std::future<T> read_async() {
+            if (ops) return ops->push([this] { return exclusive(co_read<T>()); });
+            return std::async(std::launch::async, &Client::read<T>, this);
+        }
+    };
+
+    //a thread-safe server that only talks to one client at a time,
+    //closes the connection with that client when done or when it wants to accept a new connection
+    //implemented as a sort of 'stream'
+    class SingleServer final : public Server {
+    protected:
+        tcp::socket client;
+        atomic_bool has_connection{false};
+        ReceiveBuffer buffer;
+        WriteBuffer out;
+        AutoFlush auto_flush;
+
+        void get_data() {
             std::lock_guard lk(mtx);
+            get_data_unlocked();
+        }
+
+        void get_data_unlocked() {
             if (!has_connection) throw Exception("Cannot read data from unconnected client");
             boost::system::error_code ec;
-            data_size = client.read_some(boost::asio::buffer(buffer), ec);
-            buf_pos = 0;
+            buffer.commit(client.read_some(buffer.prepare(), ec));
 
             if (ec) {
                 throw Exception("Failed to read data with error: {}", ec.message());
             }
         }
 
-        void get_data_unlocked() {
+        u8 get_byte_unlocked() {
+            if (buffer.empty()) get_data_unlocked();
+
+            return buffer.next();
+        }
+
+        //reads n bytes into dst, whatever isn't buffered already is read straight into dst
+        void read_exact_unlocked(u8* dst, const usize n) {
+            const usize have = buffer.take(dst, n);
+            if (have == n) return;
             if (!has_connection) throw Exception("Cannot read data from unconnected client");
+
             boost::system::error_code ec;
-            data_size = client.read_some(boost::asio::buffer(buffer), ec);
-            buf_pos = 0;
+            boost::asio::read(client, boost::asio::buffer(dst + have, n - have), ec);
 
             if (ec) {
                 throw Exception("Failed to read data with error: {}", ec.message());
             }
         }
 
+        void flush_unlocked() {
+            if (out.empty()) return;
+            if (!has_connection) throw Exception("Cannot write data to unconnected client");
+
+            boost::system::error_code ec;
+            boost::asio::write(client, out.buffer(), ec);
+            out.clear();
+
+            if (ec) {
+                throw Exception("Failed to write data with error: {}", ec.message());
+            }
+        }
+
     public:
         SingleServer(const boost::asio::ip::address &ip_addr, const u16 port) : Server(ip_addr, port), client(context) {}
 
@@ -419,20 +1234,49 @@ namespace Auxil {
             }
             has_connection = false;
 
-            //accept another connection
+            //accept another connection, nothing left over from the last one should be read
+            buffer.clear();
             acceptor.accept(client);
             has_connection = true;
         }
 
-        //writes to the server, blocks until the message has been sent
-        template<Serializable T>
-        void write(const T& data) {
+        //writes every value (after anything that was queued) to the client with a single write,
+        //blocks until the message has been sent
+        template<Serializable T, Serializable... Ts>
+        void write(const T& data, const Ts&... rest) {
             std::lock_guard lk(mtx);
             if (!has_connection) throw Exception("Cannot write data to unconnected client");
 
-            auto bytes = ByteSerializer<T>::serialize(data);
+            out.append(data, rest...);
+            flush_unlocked();
+        }
+
+        //adds the values to the write buffer without sending them, they go out with the next write or flush,
+        //or as soon as the auto flush threshold is reached
+        template<Serializable... Ts>
+        void queue(const Ts&... values) {
+            std::lock_guard lk(mtx);
+            if (!has_connection) throw Exception("Cannot write data to unconnected client");
 
-            boost::asio::write(client, boost::asio::buffer(bytes.data(), bytes.size()));
+            out.append(values...);
+            if (out.due(auto_flush)) flush_unlocked();
+        }
+
+        //sends everything that has been queued
+        void flush() {
+            std::lock_guard lk(mtx);
+            flush_unlocked();
+        }
+
+        void set_auto_flush(const AutoFlush& policy) {
+            std::lock_guard lk(mtx);
+            auto_flush = policy;
+        }
+
+        //how many bytes are queued but not sent yet
+        [[nodiscard]] usize queued() {
+            std::lock_guard lk(mtx);
+            return out.size();
         }
 
         //gets the next byte of data from the server, potentially reads in up to 1024 bytes
@@ -440,9 +1284,7 @@ namespace Auxil {
         u8 get_next_byte() {
             std::lock_guard lk(mtx);
             //fine to use the unlocked version since we own a lock
-            if (buf_pos == data_size) get_data_unlocked();
-
-            return buffer[buf_pos++];
+            return get_byte_unlocked();
         }
 
         Array<u8> get_n_bytes(const usize n) {
@@ -450,11 +1292,7 @@ namespace Auxil {
 
             Array<u8> result(n);
 
-            for (usize i = 0; i < n; i++) {
-                if (buf_pos == data_size) get_data_unlocked();
-
-                result[i] = buffer[buf_pos++];
-            }
+            read_exact_unlocked(result.data(), n);
 
             return result;
         }
@@ -462,15 +1300,85 @@ namespace Auxil {
         //reads in a T, T must have a defined ByteSerializer
         template<Serializable T>
         T read() {
-            return ByteSerializer<T>::deserialize([this]() -> u8 {
-                return get_next_byte();
-            });
+            std::lock_guard lk(mtx);
+            if constexpr (SpanDeserializable<T>) {
+                while (true) {
+                    if (auto res = buffer.try_read<T>()) return std::move(*res);
+
+                    get_data_unlocked();
+                }
+            } else {
+                return ByteSerializer<T>::deserialize([this]() -> u8 {
+                    return get_byte_unlocked();
+                });
+            }
+        }
+
+        //reads a '\0' terminated string without copying it, the view points into the receive buffer
+        //and is only valid until the next read
+        std::string_view read_view() {
+            std::lock_guard lk(mtx);
+            while (true) {
+                if (auto res = buffer.try_borrow_string()) return *res;
+
+                get_data_unlocked();
+            }
+        }
+
+        //reads a whole length prefixed frame, once the length is known the rest of the payload is read
+        //into the result in one go instead of through the receive buffer
+        Array<u8> read_frame() {
+            std::lock_guard lk(mtx);
+            std::optional<usize> len;
+            while (!(len = buffer.try_take_frame_length())) get_data_unlocked();
+
+            Array<u8> result(*len);
+            read_exact_unlocked(result.data(), *len);
+            return result;
+        }
+
+        //reads a frame and deserializes a T from its payload
+        template<Serializable T>
+        T read_frame_as() {
+            const auto payload = read_frame();
+            return deserialize_from<T>({payload.data(), payload.size()});
+        }
+
+        //writes the values (after anything queued) as a single length prefixed frame
+        template<Serializable... Ts>
+        void write_frame(const Ts&... values) {
+            std::lock_guard lk(mtx);
+            if (!has_connection) throw Exception("Cannot write data to unconnected client");
+
+            out.append_frame(values...);
+            flush_unlocked();
+        }
+
+        //adds the values to the write buffer as a frame without sending it
+        template<Serializable... Ts>
+        void queue_frame(const Ts&... values) {
+            std::lock_guard lk(mtx);
+            if (!has_connection) throw Exception("Cannot write data to unconnected client");
+
+            out.append_frame(values...);
+            if (out.due(auto_flush)) flush_unlocked();
+        }
+
+        //lets a single read take in up to n bytes, the buffer still grows past this for values that don't fit
+        void set_receive_buffer_size(const usize n) {
+            std::lock_guard lk(mtx);
+            buffer.reserve(n);
+        }
+
+        void set_max_frame_size(const usize n) {
+            std::lock_guard lk(mtx);
+            buffer.max_frame = n;
         }
 
         //writes the data asynchronously
         template<Serializable T>
         std::future<void> write_async(const T& data) {
-            return std::async(std::launch::async, &SingleServer::write<T>, this, data);
+            return std::async(std::launch::async, [this, data] { write(data); });
         }
 
         std::future<u8> async_next_byte() {
@@ -497,29 +1405,45 @@ namespace Auxil {
         private:
             atomic_bool connected{false};
             std::unique_ptr<tcp::socket> client_socket{nullptr};
+            IOContextPool* pool{nullptr};
 
-            explicit Client(tcp::socket&& socket) :
+            explicit Client(tcp::socket&& socket, IOContextPool* io_pool = nullptr) :
                 connected(true),
-                client_socket(std::make_unique<tcp::socket>(std::forward<tcp::socket>(socket)))
+                client_socket(std::make_unique<tcp::socket>(std::forward<tcp::socket>(socket))),
+                pool(io_pool),
+                ops(io_pool ? std::make_shared<OperationQueue>(*io_pool) : nullptr)
             { }
 
-            std::mutex mtx;
+            //the *_async functions of a pool-bound client run through this one at a time
+            std::shared_ptr<OperationQueue> ops;
+            ClientGate gate;
+
+            ReceiveBuffer buffer;
+            WriteBuffer out;
+            AutoFlush auto_flush;
 
+            void flush_unlocked() {
+                if (out.empty()) return;
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                boost::system::error_code ec;
+                boost::asio::write(*client_socket, out.buffer(), ec);
+                out.clear();
 
-            std::array<u8, 1024> buffer{0};
-            usize buf_pos{0};
-            usize data_size{0};
+                if (ec) {
+                    throw Exception("Failed to write data with error: {}", ec.message());
+                }
+            }
 
             void get_data() {
-                std::lock_guard lk(mtx);
+                const auto lk = lock();
                 get_data_unlocked();
             }
 
             void get_data_unlocked() {
                 if (!connected || !client_socket) throw Exception("Cannot read data from unconnected server");
                 boost::system::error_code ec;
-                data_size = client_socket->read_some(boost::asio::buffer(buffer), ec);
-                buf_pos = 0;
+                buffer.commit(client_socket->read_some(buffer.prepare(), ec));
 
                 if (ec) {
                     throw Exception("Failed to read data with error: {}", ec.message());
@@ -527,9 +1451,47 @@ namespace Auxil {
             }
 
             u8 get_byte_unlocked() {
-                if (buf_pos == data_size) get_data_unlocked();
+                if (buffer.empty()) get_data_unlocked();
 
-                return buffer[buf_pos++];
+                return buffer.next();
+            }
+
+            //reads n bytes into dst, whatever isn't buffered already is read straight into dst
+            void read_exact_unlocked(u8* dst, const usize n) {
+                const usize have = buffer.take(dst, n);
+                if (have == n) return;
+                if (!connected || !client_socket) throw Exception("Cannot read data from unconnected server");
+
+                boost::system::error_code ec;
+                boost::asio::read(*client_socket, boost::asio::buffer(dst + have, n - have), ec);
+
+                if (ec) {
+                    throw Exception("Failed to read data with error: {}", ec.message());
+                }
+            }
+
+            boost::asio::awaitable<void> co_fill() {
+                if (!connected || !client_socket) throw Exception("Cannot read data from unconnected server");
+
+                boost::system::error_code ec;
+                const usize n = co_await client_socket->async_read_some(buffer.prepare(),
+                    boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+                if (ec) {
+                    throw Exception("Failed to read data with error: {}", ec.message());
+                }
+                buffer.commit(n);
+            }
+
+            //holds the client for a blocking function
+            ClientGate::Hold lock() {
+                return gate.lock();
+            }
+
+            //runs op as an *_async operation, keeping the blocking functions out until it's done
+            template<typename T>
+            boost::asio::awaitable<T> exclusive(boost::asio::awaitable<T> op) {
+                return gate.exclusive(ops, std::move(op));
             }
         public:
             friend MultiServer;
@@ -540,71 +1502,104 @@ namespace Auxil {
             Client(Client&& c) noexcept :
                 connected(c.connected.load()),
                 client_socket(std::move(c.client_socket)),
-                buffer(c.buffer),
-                buf_pos(c.buf_pos),
-                data_size(c.data_size)
+                pool(c.pool),
+                ops(std::move(c.ops)),
+                buffer(std::move(c.buffer)),
+                out(std::move(c.out)),
+                auto_flush(c.auto_flush)
             {
-                c.buf_pos = 0;
-                c.data_size = 0;
+                c.buffer.clear();
+                c.out.clear();
             }
 
             Client& operator=(Client&& c)  noexcept {
                 close();
 
-                std::lock_guard lk(mtx);
+                const auto lk = lock();
                 connected = c.connected.load();
                 client_socket = std::move(c.client_socket);
-                buffer = c.buffer;
-                buf_pos = c.buf_pos;
-                data_size = c.data_size;
-                c.buf_pos = 0;
-                c.data_size = 0;
+                pool = c.pool;
+                ops = std::move(c.ops);
+                buffer = std::move(c.buffer);
+                out = std::move(c.out);
+                auto_flush = c.auto_flush;
+                c.buffer.clear();
+                c.out.clear();
 
                 return *this;
             }
 
 
             [[nodiscard]] bool is_connected() {
-                connected = client_socket->is_open();
+                connected = client_socket && client_socket->is_open();
                 return connected;
             }
 
 
+            //doesn't wait for the *_async functions, closing the socket cancels whatever they are waiting on
             void close() {
-                std::lock_guard lk(mtx);
-                client_socket->close();
+                const auto lk = gate.interrupt();
+                if (client_socket) {
+                    //the peer may have already dropped the connection
+                    boost::system::error_code ec;
+                    client_socket->close(ec);
+                }
 
                 connected = false;
             }
 
-            //writes to the server, blocks until the message has been sent
-            template<Serializable T>
-            void write(const T& data) {
-                std::lock_guard lk(mtx);
+            //writes every value (after anything that was queued) to the server with a single write,
+            //blocks until the message has been sent
+            template<Serializable T, Serializable... Ts>
+            void write(const T& data, const Ts&... rest) {
+                const auto lk = lock();
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                out.append(data, rest...);
+                flush_unlocked();
+            }
+
+            //adds the values to the write buffer without sending them, they go out with the next write or flush,
+            //or as soon as the auto flush threshold is reached
+            template<Serializable... Ts>
+            void queue(const Ts&... values) {
+                const auto lk = lock();
                 if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
 
-                auto bytes = ByteSerializer<T>::serialize(data);
+                out.append(values...);
+                if (out.due(auto_flush)) flush_unlocked();
+            }
+
+            //sends everything that has been queued
+            void flush() {
+                const auto lk = lock();
+                flush_unlocked();
+            }
+
+            void set_auto_flush(const AutoFlush& policy) {
+                const auto lk = lock();
+                auto_flush = policy;
+            }
 
-                boost::asio::write(*client_socket, boost::asio::buffer(bytes.data(), bytes.size()));
+            //how many bytes are queued but not sent yet
+            [[nodiscard]] usize queued() {
+                const auto lk = lock();
+                return out.size();
             }
 
             //gets the next byte of data from the server, potentially reads in up to 1024 bytes
             //if the internal buffer runs out, in such a case it would block until it reads something
             u8 get_next_byte() {
-                std::lock_guard lk(mtx);
+                const auto lk = lock();
                 return get_byte_unlocked();
             }
 
             Array<u8> get_n_bytes(const usize n) {
-                std::lock_guard lk(mtx);
+                const auto lk = lock();
 
                 Array<u8> result(n);
 
-                for (usize i = 0; i < n; i++) {
-                    if (buf_pos == data_size) get_data_unlocked();
-
-                    result[i] = buffer[buf_pos++];
-                }
+                read_exact_unlocked(result.data(), n);
 
                 return result;
             }
@@ -615,41 +1610,368 @@ namespace Auxil {
                 //this ensures the serializer is not interrupted by another reader
                 //causing issues where it reads every other byte instead of
                 //a continuous stream of bytes
-                std::lock_guard lk(mtx);
-                return ByteSerializer<T>::deserialize([this]() -> u8 {
-                    return get_byte_unlocked();
-                });
+                const auto lk = lock();
+                if constexpr (SpanDeserializable<T>) {
+                    while (true) {
+                        if (auto res = buffer.try_read<T>()) return std::move(*res);
+
+                        get_data_unlocked();
+                    }
+                } else {
+                    return ByteSerializer<T>::deserialize([this]() -> u8 {
+                        return get_byte_unlocked();
+                    });
+                }
+            }
+
+            //reads a '\0' terminated string without copying it, the view points into the receive buffer
+            //and is only valid until the next read
+            std::string_view read_view() {
+                const auto lk = lock();
+                while (true) {
+                    if (auto res = buffer.try_borrow_string()) return *res;
+
+                    get_data_unlocked();
+                }
+            }
+
+            //reads a whole length prefixed frame, once the length is known the rest of the payload is read
+            //into the result in one go instead of through the receive buffer
+            Array<u8> read_frame() {
+                const auto lk = lock();
+                std::optional<usize> len;
+                while (!(len = buffer.try_take_frame_length())) get_data_unlocked();
+
+                Array<u8> result(*len);
+                read_exact_unlocked(result.data(), *len);
+                return result;
+            }
+
+            //reads a frame and deserializes a T from its payload
+            template<Serializable T>
+            T read_frame_as() {
+                const auto payload = read_frame();
+                return deserialize_from<T>({payload.data(), payload.size()});
+            }
+
+            //writes the values (after anything queued) as a single length prefixed frame
+            template<Serializable... Ts>
+            void write_frame(const Ts&... values) {
+                const auto lk = lock();
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                out.append_frame(values...);
+                flush_unlocked();
+            }
+
+            //adds the values to the write buffer as a frame without sending it
+            template<Serializable... Ts>
+            void queue_frame(const Ts&... values) {
+                const auto lk = lock();
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                out.append_frame(values...);
+                if (out.due(auto_flush)) flush_unlocked();
+            }
+
+            //lets a single read take in up to n bytes, the buffer still grows past this for values that don't fit
+            void set_receive_buffer_size(const usize n) {
+                const auto lk = lock();
+                buffer.reserve(n);
+            }
+
+            void set_max_frame_size(const usize n) {
+                const auto lk = lock();
+                buffer.max_frame = n;
+            }
+
+            //coroutine versions of the functions above, same rules as the co_* functions of Auxil::Client
+
+            //sends everything in the write buffer, reusing it like flush does
+            boost::asio::awaitable<void> co_flush() {
+                if (out.empty()) co_return;
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                boost::system::error_code ec;
+                co_await boost::asio::async_write(*client_socket, out.buffer(), boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                out.clear();
+
+                if (ec) {
+                    throw Exception("Failed to write data with error: {}", ec.message());
+                }
+            }
+
+            //the values are sent after anything that was queued, all in one write
+            template<Serializable T, Serializable... Ts>
+            boost::asio::awaitable<void> co_write(const T data, const Ts... rest) {
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                out.append(data, rest...);
+                co_await co_flush();
+            }
+
+            boost::asio::awaitable<u8> co_next_byte() {
+                if (buffer.empty()) co_await co_fill();
+
+                co_return buffer.next();
+            }
+
+            boost::asio::awaitable<Array<u8>> co_n_bytes(const usize n) {
+                Array<u8> result(n);
+
+                for (usize i = 0; i < n;) {
+                    if (buffer.empty()) co_await co_fill();
+
+                    i += buffer.take(result.data() + i, n - i);
+                }
+
+                co_return result;
+            }
+
+            template<Serializable T>
+            boost::asio::awaitable<T> co_read() {
+                while (true) {
+                    if (auto res = buffer.try_read<T>()) co_return std::move(*res);
+
+                    co_await co_fill();
+                }
             }
 
+            boost::asio::awaitable<Array<u8>> co_read_frame() {
+                std::optional<usize> len;
+                while (!(len = buffer.try_take_frame_length())) co_await co_fill();
+
+                Array<u8> result(*len);
+                const usize have = buffer.take(result.data(), *len);
+                if (have < *len) {
+                    if (!connected || !client_socket) throw Exception("Cannot read data from unconnected server");
+                    co_await boost::asio::async_read(*client_socket, boost::asio::buffer(result.data() + have, *len - have), boost::asio::use_awaitable);
+                }
+
+                co_return result;
+            }
+
+            template<Serializable T>
+            boost::asio::awaitable<T> co_read_frame_as() {
+                const auto payload = co_await co_read_frame();
+                co_return deserialize_from<T>({payload.data(), payload.size()});
+            }
+
+            template<Serializable... Ts>
+            boost::asio::awaitable<void> co_write_frame(const Ts... values) {
+                if (!connected || !client_socket) throw Exception("Cannot write data to unconnected server");
+
+                out.append_frame(values...);
+                co_await co_flush();
+            }
+
+            //the *_async functions are safe to call from any thread, on a pool-bound client they run one at a
+            //time in the order they were called and the blocking functions wait for them
+
             //writes the data asynchronously
             template<Serializable T>
             std::future<void> write_async(const T& data) {
-                return std::async(std::launch::async, &Client::write<T>, this, data);
+                if (ops) return ops->push([this, data] { return exclusive(co_write<T>(data)); });
+                return std::async(std::launch::async, [this, data] { write(data); });
             }
 
             std::future<u8> async_next_byte() {
+                if (ops) return ops->push([this] { return exclusive(co_next_byte()); });
                 return std::async(std::launch::async, &Client::get_next_byte, this);
             }
 
             std::future<Array<u8>> async_n_bytes(const usize n) {
+                if (ops) return ops->push([this, n] { return exclusive(co_n_bytes(n)); });
                 return std::async(std::launch::async, &Client::get_n_bytes, this, n);
             }
 
             template<Serializable T>
             std::future<T> read_async() {
+                if (ops) return ops->push([this] { return exclusive(co_read<T>()); });
                 return std::async(std::launch::async, &Client::read<T>, this);
             }
         };
+        //a connection accepted by serve, shared between the session's handler and the server
+        using Session = std::shared_ptr<Client>;
+
     private:
+        struct ServeState {
+            std::mutex mtx;
+            std::unordered_map<usize, std::weak_ptr<Client>> sessions;
+            usize next_id{0};
+            std::atomic_bool serving{false};
+            std::promise<void> accept_finished;
+            //the server's acceptor while serve is running, the accept loop only touches the state, so it
+            //can outlive the server when it's stopped from one of the pool's threads
+            std::optional<tcp::acceptor> acceptor;
+        };
+
+        std::shared_ptr<ServeState> serve_state = std::make_shared<ServeState>();
+        //the accept loop runs on its own strand so stop can cancel it from any thread
+        std::optional<boost::asio::strand<boost::asio::io_context::executor_type>> accept_strand;
+
+        template<typename F>
+        static boost::asio::awaitable<void> run_session(std::shared_ptr<ServeState> state, const usize id, Session session, F handler) {
+            //an exception (usually the client disconnecting) only ends its own session
+            try {
+                co_await handler(session);
+            } catch (...) {}
+
+            session->close();
+            std::lock_guard lk(state->mtx);
+            state->sessions.erase(id);
+        }
+
+        template<Serializable T, typename F>
+        static boost::asio::awaitable<void> message_loop(Session session, F callback) {
+            while (session->is_connected()) {
+                callback(session, co_await session->co_read<T>());
+            }
+        }
+
+        static MultiServer& check_movable(MultiServer& serv) {
+            if (serv.serve_state && serv.serve_state->serving) {
+                throw Exception("Cannot move a MultiServer while it is serving, stop it first");
+            }
+
+            return serv;
+        }
+
+        template<typename F>
+        static boost::asio::awaitable<void> accept_loop(std::shared_ptr<ServeState> state, IOContextPool* pool, F handler) {
+            while (state->serving) {
+                //every session gets its own strand, its handler never runs on two threads at once
+                boost::system::error_code ec;
+                tcp::socket sk = co_await state->acceptor->async_accept(boost::asio::make_strand(pool->context()),
+                    boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                if (ec) {
+                    if (!state->serving || !state->acceptor->is_open()) break;
+                    continue;
+                }
+
+                auto session = std::make_shared<Client>(Client{ std::move(sk), pool });
+                usize id;
+                {
+                    std::lock_guard lk(state->mtx);
+                    id = state->next_id++;
+                    state->sessions.emplace(id, session);
+                }
+
+                auto ex = session->client_socket->get_executor();
+                boost::asio::co_spawn(ex, run_session(state, id, std::move(session), handler), boost::asio::detached);
+            }
+
+            state->accept_finished.set_value();
+        }
+
     public:
         using Server::Server;
-        using Server::operator=;
+
+        //a serving server's sessions and accept loop belong to it, so it can only be moved once it's stopped
+        MultiServer(MultiServer&& serv) : Server(std::move(check_movable(serv))),
+            serve_state(std::move(serv.serve_state)),
+            accept_strand(std::move(serv.accept_strand)) {}
+
+        //this server is stopped and closed first, like it would be by its destructor
+        MultiServer& operator=(MultiServer&& serv) {
+            if (this == &serv) return *this;
+            check_movable(serv);
+            stop();
+            close();
+
+            std::lock_guard lk(mtx);
+            acceptor = std::move(serv.acceptor);
+            pool = serv.pool;
+            serve_state = std::move(serv.serve_state);
+            accept_strand = std::move(serv.accept_strand);
+
+            return *this;
+        }
+
+        ~MultiServer() override {
+            stop();
+        }
+
+        //accepts connections asynchronously on the IOContextPool the server was constructed with and runs
+        //handler(session) as a coroutine for each of them, returns immediately
+        //the number of threads handling connections is the size of the pool, accept and co_accept can't
+        //be used until the server is stopped
+        template<typename F>
+        requires std::is_invocable_r_v<boost::asio::awaitable<void>, F, Session>
+        void serve(F handler) {
+            if (!pool) throw Exception("MultiServer::serve requires a server constructed with an IOContextPool");
+            if (!serve_state) throw Exception("Cannot serve from a moved from MultiServer");
+            if (!acceptor.is_open()) throw Exception("MultiServer has no open acceptor to serve with");
+            if (serve_state->serving.exchange(true)) throw Exception("MultiServer is already serving");
+
+            serve_state->accept_finished = std::promise<void>();
+            serve_state->acceptor.emplace(std::move(acceptor));
+            accept_strand.emplace(boost::asio::make_strand(pool->context()));
+            boost::asio::co_spawn(*accept_strand, accept_loop(serve_state, pool, std::move(handler)), boost::asio::detached);
+        }
+
+        //serves every connection with a loop that reads a T and calls callback(session, value) until
+        //the client disconnects
+        template<Serializable T, typename F>
+        requires Invocable<F, const Session&, T>
+        void serve_messages(F callback) {
+            serve([callback = std::move(callback)](Session session) {
+                return message_loop<T>(std::move(session), callback);
+            });
+        }
+
+        //how many sessions started by serve are still running
+        [[nodiscard]] usize connections() const {
+            if (!serve_state) return 0;
+            std::lock_guard lk(serve_state->mtx);
+            return serve_state->sessions.size();
+        }
+
+        //stops accepting connections and closes every session started by serve, waits for the accept
+        //loop to finish and takes the acceptor back unless it's called from one of the pool's threads,
+        //in that case the acceptor stays with the finished loop and the server can't serve again
+        void stop() {
+            //moved from servers don't have any state
+            if (!serve_state || !serve_state->serving.exchange(false)) return;
+
+            boost::asio::post(*accept_strand, [state = serve_state] {
+                boost::system::error_code ec;
+                state->acceptor->cancel(ec);
+            });
+
+            {
+                std::lock_guard lk(serve_state->mtx);
+                for (auto& [id, weak]: serve_state->sessions) {
+                    if (auto session = weak.lock()) {
+                        boost::asio::post(session->client_socket->get_executor(), [session] {
+                            session->close();
+                        });
+                    }
+                }
+            }
+
+            if (!pool->context().get_executor().running_in_this_thread()) {
+                serve_state->accept_finished.get_future().wait();
+                //the loop can finish before the cancel above runs, wait for the strand to get past it too
+                boost::asio::post(*accept_strand, boost::asio::use_future).wait();
+
+                acceptor = std::move(*serve_state->acceptor);
+                serve_state->acceptor.reset();
+            }
+        }
 
         //accepts a new client connection
         Client accept() {
             tcp::socket sk = acceptor.accept();
 
-            return Client{ std::move(sk) };
+            return Client{ std::move(sk), pool };
+        }
+
+        //accepts a new client connection without blocking the pool thread it runs on
+        boost::asio::awaitable<Client> co_accept() {
+            tcp::socket sk = co_await acceptor.async_accept(boost::asio::use_awaitable);
+
+            co_return Client{ std::move(sk), pool };
         }
     };
 }
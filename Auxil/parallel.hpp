@@ -0,0 +1,333 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+#include <algorithm>
+#include <optional>
+
+#include "containers.hpp"
+#include "random.hpp"
+#include "threading.hpp"
+
+namespace Auxil {
+    using namespace Primitives;
+
+    //a container that stores all of its elements in a single block of memory
+    template<typename C>
+    concept ContiguousContainer = requires(C& c)
+    {
+        { c.data() } -> std::convertible_to<const volatile void*>;
+        { c.size() } -> std::convertible_to<usize>;
+    };
+
+    template<ContiguousContainer C>
+    using contiguous_value_t = std::remove_pointer_t<decltype(std::declval<C&>().data())>;
+
+    //picks a grain size when the caller passes 0, aims for a few chunks per worker so that
+    //uneven chunks still balance out without paying per-element task overhead
+    inline usize resolve_grain(const Executor& ex, const usize n, const usize grain) {
+        if (grain != 0) return grain;
+        const usize workers = std::max<usize>(1, ex.size());
+        return std::max<usize>(1, n / (workers * 8));
+    }
+
+    //splits [0, n) into chunks of grain elements and calls body(chunk, begin, end) for each of them,
+    //the calling thread works on chunks too, so this is safe to call from inside an Executor task
+    //the first exception thrown by body is rethrown here once the other chunks are finished
+    template<typename F>
+    void parallel_for_chunks(Executor& ex, const usize n, const usize grain, F&& body) {
+        if (n == 0) return;
+        const usize chunks = (n + grain - 1) / grain;
+
+        if (chunks == 1 || ex.size() == 0) {
+            for (usize c = 0; c < chunks; c++) {
+                body(c, c*grain, std::min(n, (c+1)*grain));
+            }
+            return;
+        }
+
+        struct State {
+            usize n, grain, chunks;
+            std::atomic<usize> next{0};
+            std::atomic<usize> done{0};
+            std::atomic_flag failed;
+            std::exception_ptr error{nullptr};
+        };
+
+        //helpers that start after everything is already done only touch the shared state, never body
+        auto state = std::make_shared<State>(n, grain, chunks);
+        auto work = [state, &body] {
+            usize c;
+            while ((c = state->next.fetch_add(1, std::memory_order_relaxed)) < state->chunks) {
+                if (!state->failed.test(std::memory_order_relaxed)) {
+                    try {
+                        body(c, c*state->grain, std::min(state->n, (c+1)*state->grain));
+                    } catch (...) {
+                        if (!state->failed.test_and_set()) state->error = std::current_exception();
+                    }
+                }
+
+                if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == state->chunks) {
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        const usize helpers = std::min<usize>(ex.size(), chunks - 1);
+        for (usize i = 0; i < helpers; i++) {
+            ex.post(work);
+        }
+        work();
+
+        usize d;
+        while ((d = state->done.load(std::memory_order_acquire)) != chunks) {
+            state->done.wait(d, std::memory_order_acquire);
+        }
+
+        if (state->error) std::rethrow_exception(state->error);
+    }
+
+    //calls body(begin, end) on sub-ranges of [first, last)
+    template<std::integral I, typename F>
+    requires Invocable<F, I, I>
+    void parallel_for_range(Executor& ex, I first, I last, F&& body, usize grain = 0) {
+        if (last <= first) return;
+        const auto n = static_cast<usize>(last - first);
+
+        parallel_for_chunks(ex, n, resolve_grain(ex, n, grain), [&](usize, usize b, usize e) {
+            body(static_cast<I>(first + b), static_cast<I>(first + e));
+        });
+    }
+
+    //holds the start of each chunk of a container that can only be walked forwards
+    template<Iterable C>
+    auto chunk_iterators(C& container, const usize grain) {
+        using It = decltype(container.begin());
+        std::vector<It> starts;
+        const usize n = container.size();
+        starts.reserve((n + grain - 1) / grain + 1);
+
+        auto it = container.begin();
+        for (usize i = 0; i < n; i++, ++it) {
+            if (i % grain == 0) starts.push_back(it);
+        }
+        starts.push_back(container.end());
+
+        return starts;
+    }
+
+    //calls body(chunk, begin, end) with iterators (or pointers for contiguous containers) for each chunk
+    template<typename C, typename F>
+    void parallel_for_each_chunk(Executor& ex, C& container, const usize grain, F&& body) {
+        const auto n = static_cast<usize>(container.size());
+
+        if constexpr (ContiguousContainer<C>) {
+            auto* data = container.data();
+            parallel_for_chunks(ex, n, grain, [&](usize c, usize b, usize e) {
+                body(c, data + b, data + e);
+            });
+        } else {
+            auto starts = chunk_iterators(container, grain);
+            parallel_for_chunks(ex, n, grain, [&](usize c, usize, usize) {
+                body(c, starts[c], starts[c+1]);
+            });
+        }
+    }
+
+    //calls func(i) for every index in [first, last)
+    template<std::integral I, typename F>
+    requires Invocable<F, I>
+    void parallel_for(Executor& ex, I first, I last, F&& func, usize grain = 0) {
+        parallel_for_range(ex, first, last, [&](I b, I e) {
+            for (I i = b; i < e; ++i) func(i);
+        }, grain);
+    }
+
+    //calls func(i, rng) for every index in [first, last), rng is streams.stream(i), so what func draws for an index
+    //doesn't depend on the grain, the number of workers or which of them runs it
+    template<std::integral I, typename F>
+    requires Invocable<F, I, StreamRandom&>
+    void parallel_for(Executor& ex, I first, I last, const RandomStreams& streams, F&& func, usize grain = 0) {
+        parallel_for_range(ex, first, last, [&](I b, I e) {
+            for (I i = b; i < e; ++i) {
+                StreamRandom rng = streams.stream(static_cast<u64>(i));
+                func(i, rng);
+            }
+        }, grain);
+    }
+
+    //calls func(element) for every element of an Array, Grid or any other Iterable
+    template<Iterable C, typename F>
+    void parallel_for(Executor& ex, C& container, F&& func, usize grain = 0) {
+        grain = resolve_grain(ex, container.size(), grain);
+
+        parallel_for_each_chunk(ex, container, grain, [&](usize, auto b, auto e) {
+            for (; b != e; ++b) func(*b);
+        });
+    }
+
+    //the stream the redraws of element i come from is redraw_streams | i, which stays clear of stream 0
+    inline constexpr u64 redraw_streams = u64{1} << 63;
+
+    /*
+     * fills a contiguous container with numbers in [min, max] ([min, max) for floats) from stream 0 of streams, every
+     * chunk seeks to its own position in the stream, and the rare redraws lemire's method needs for element i come
+     * from stream redraw_streams | i, so no element depends on its neighbours and the result is the same for any
+     * grain or number of workers
+     */
+    template<ContiguousContainer C, Arithmetic T>
+    requires std::is_same_v<std::remove_const_t<contiguous_value_t<C>>, T>
+    void parallel_fill(Executor& ex, C& container, const RandomStreams& streams, const T min, const T max,
+                       usize grain = 0) {
+        const auto n = static_cast<usize>(container.size());
+        //a value of 4 bytes or less is half of a u64 and anything bigger is a whole one, so an even chunk start
+        //always begins on a whole u64
+        constexpr u64 outputs = sizeof(T) <= 4 ? 1 : 2;
+        grain = resolve_grain(ex, n, grain);
+        grain += grain & 1;
+
+        T* data = container.data();
+        parallel_for_chunks(ex, n, grain, [&](usize, usize b, usize e) {
+            StreamRandom rng = streams.stream(0, b * outputs);
+            if constexpr (std::integral<T>) {
+                std::optional<StreamRandom> redraw;
+                usize redraw_of = 0;
+                rng.fill(std::span<T>(data + b, e - b), min, max, [&](const usize j) -> StreamRandom& {
+                    if (!redraw || redraw_of != j) {
+                        redraw.emplace(streams.stream(redraw_streams | (b + j)));
+                        redraw_of = j;
+                    }
+                    return *redraw;
+                });
+            } else {
+                rng.fill(std::span<T>(data + b, e - b), min, max);
+            }
+        });
+    }
+
+    //out[i] = func(in[i]), out must have at least as many elements as in
+    template<Iterable In, Iterable Out, typename F>
+    void parallel_transform(Executor& ex, In& in, Out& out, F&& func, usize grain = 0) {
+        const auto n = static_cast<usize>(in.size());
+        if (static_cast<usize>(out.size()) < n) {
+            throw Exception("Cannot transform {} elements into a container with {} elements", n, out.size());
+        }
+        grain = resolve_grain(ex, n, grain);
+
+        if constexpr (ContiguousContainer<In> && ContiguousContainer<Out>) {
+            const auto* src = in.data();
+            auto* dst = out.data();
+            parallel_for_chunks(ex, n, grain, [&](usize, usize b, usize e) {
+                for (usize i = b; i < e; i++) dst[i] = func(src[i]);
+            });
+        } else {
+            auto out_starts = chunk_iterators(out, grain);
+            parallel_for_each_chunk(ex, in, grain, [&](usize c, auto b, auto e) {
+                auto o = out_starts[c];
+                for (; b != e; ++b, ++o) *o = func(*b);
+            });
+        }
+    }
+
+    //folds every element into init with op, op must be associative, chunks are combined in order so the
+    //result is the same every run even for operations that are only approximately associative (floats)
+    template<Iterable C, typename T, typename Op>
+    T parallel_reduce(Executor& ex, C& container, T init, Op&& op, usize grain = 0) {
+        const auto n = static_cast<usize>(container.size());
+        if (n == 0) return init;
+        grain = resolve_grain(ex, n, grain);
+
+        std::vector<std::optional<T>> partials((n + grain - 1) / grain);
+        parallel_for_each_chunk(ex, container, grain, [&](usize c, auto b, auto e) {
+            T acc = static_cast<T>(*b);
+            for (++b; b != e; ++b) acc = op(std::move(acc), *b);
+            partials[c].emplace(std::move(acc));
+        });
+
+        for (auto& p: partials) {
+            init = op(std::move(init), std::move(*p));
+        }
+        return init;
+    }
+
+    //the same product as left.dot(right), with blocks of rows of the result computed in parallel
+    template<typename T>
+    Grid<T> parallel_dot(Executor& ex, const Grid<T>& left, const Grid<T>& right, usize grain = 0) {
+        if (left.columns() != right.rows()) {
+            throw Exception("Cannot compute the dot product of grids where the columns of the left"
+                            " does not equal the number of rows of the right\n"
+                            "Left: {}x{}, Right: {}x{}", left.rows(), left.columns(), right.rows(), right.columns());
+        }
+        const usize m = left.rows(), k = left.columns(), n = right.columns();
+        auto result = Grid<T>::make(m, n);
+
+        //keep chunks a whole number of the kernel's register tiles tall
+        grain = resolve_grain(ex, m, grain);
+        grain = (grain + MatmulDetail::mr - 1) / MatmulDetail::mr * MatmulDetail::mr;
+
+        parallel_for_chunks(ex, m, grain, [&](usize, usize b, usize e) {
+            matmul(left.data() + b*k, right.data(), result.data() + b*n, e - b, k, n);
+        });
+
+        return result;
+    }
+
+    //sorts [first, last) by sorting chunks in parallel and then merging neighbouring runs in parallel
+    template<typename T, typename Compare = std::less<>>
+    void parallel_sort(Executor& ex, T* first, T* last, Compare comp = {}, usize grain = 0) {
+        if (last - first < 2) return;
+        const auto n = static_cast<usize>(last - first);
+        //sorting tiny chunks isn't worth the merge passes
+        grain = std::max<usize>(resolve_grain(ex, n, grain), 1024);
+
+        parallel_for_chunks(ex, n, grain, [&](usize, usize b, usize e) {
+            std::sort(first + b, first + e, comp);
+        });
+        if (grain >= n) return;
+
+        std::vector<T> buffer(n);
+        T* src = first;
+        T* dst = buffer.data();
+
+        for (usize width = grain; width < n; width *= 2) {
+            const usize pairs = (n + 2*width - 1) / (2*width);
+            parallel_for_chunks(ex, pairs, 1, [&](usize p, usize, usize) {
+                const usize lo = p * 2 * width;
+                const usize mid = std::min(n, lo + width);
+                const usize hi = std::min(n, lo + 2 * width);
+                std::merge(std::make_move_iterator(src + lo), std::make_move_iterator(src + mid),
+                           std::make_move_iterator(src + mid), std::make_move_iterator(src + hi),
+                           dst + lo, comp);
+            });
+            std::swap(src, dst);
+        }
+
+        if (src != first) {
+            parallel_for_chunks(ex, n, grain, [&](usize, usize b, usize e) {
+                std::move(src + b, src + e, first + b);
+            });
+        }
+    }
+
+    //sorts an Array, Grid (in row-major element order) or any other Iterable, containers that aren't contiguous
+    //are copied out, sorted and written back
+    template<Iterable C, typename Compare = std::less<>>
+    void parallel_sort(Executor& ex, C& container, Compare comp = {}, usize grain = 0) {
+        if constexpr (ContiguousContainer<C>) {
+            auto* data = container.data();
+            parallel_sort(ex, data, data + container.size(), std::move(comp), grain);
+        } else {
+            std::vector<iterable_value_t<C>> values;
+            values.reserve(container.size());
+            for (auto& v: container) values.push_back(std::move(v));
+
+            parallel_sort(ex, values.data(), values.data() + values.size(), std::move(comp), grain);
+
+            auto it = container.begin();
+            for (auto& v: values) {
+                *it = std::move(v);
+                ++it;
+            }
+        }
+    }
+}
+
+#endif //PARALLEL_HPP
@@ -1,36 +1,696 @@
 #ifndef RANDOM_HPP
 #define RANDOM_HPP
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <span>
+
+#include "containers.hpp"
 #include "math.hpp"
 
 namespace Auxil {
-    class Random {
-        std::mt19937_64 engine;
+    /*
+     * the engines below are std uniform random bit generators, so they work with the std distributions as well as
+     * BasicRandom, they are seeded from a single u64 through SplitMix64, and split() hands out an engine whose
+     * stream doesn't overlap the one it was split from, for giving every thread or task its own
+     */
+
+    //a 64 bit state that is stepped by a constant and mixed, used to expand a seed into the other engines' states
+    class SplitMix64 {
+        u64 _state;
+
+    public:
+        using result_type = u64;
+
+        explicit SplitMix64(const u64 seed = 0) noexcept : _state(seed) {}
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<u64>::max();
+        }
+
+        FORCE_INLINE result_type operator()() noexcept {
+            u64 z = (_state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        void seed(const u64 seed) noexcept {
+            _state = seed;
+        }
+
+        //an engine seeded from this one's next output
+        SplitMix64 split() noexcept {
+            return SplitMix64((*this)());
+        }
+    };
+
+    //xoshiro256**, 32 bytes of state, a period of 2^256 - 1, and jumps of 2^128 and 2^192 steps
+    class Xoshiro256 {
+        std::array<u64, 4> _s;
+
+        static FORCE_INLINE u64 rotl(const u64 x, const int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        void jump(const std::array<u64, 4>& polynomial) noexcept {
+            std::array<u64, 4> s{};
+            for (const u64 word: polynomial) {
+                for (int b = 0; b < 64; b++) {
+                    if (word & (u64{1} << b)) {
+                        for (usize i = 0; i < 4; i++) s[i] ^= _s[i];
+                    }
+                    (*this)();
+                }
+            }
+            _s = s;
+        }
+
+    public:
+        using result_type = u64;
+
+        explicit Xoshiro256(const u64 seed = 0) noexcept {
+            this->seed(seed);
+        }
+
+        //the state must not be all zeros
+        explicit Xoshiro256(const std::array<u64, 4>& state) noexcept : _s(state) {}
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<u64>::max();
+        }
+
+        FORCE_INLINE result_type operator()() noexcept {
+            const u64 result = rotl(_s[1] * 5, 7) * 9;
+            const u64 t = _s[1] << 17;
+            _s[2] ^= _s[0];
+            _s[3] ^= _s[1];
+            _s[1] ^= _s[2];
+            _s[0] ^= _s[3];
+            _s[2] ^= t;
+            _s[3] = rotl(_s[3], 45);
+            return result;
+        }
+
+        void seed(const u64 seed) noexcept {
+            SplitMix64 sm(seed);
+            for (auto& word: _s) word = sm();
+        }
+
+        //advances the engine 2^128 steps
+        void jump() noexcept {
+            jump({0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL});
+        }
+
+        //advances the engine 2^192 steps
+        void long_jump() noexcept {
+            jump({0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL});
+        }
+
+        //an engine that continues this stream, this one jumps 2^128 steps ahead of it
+        Xoshiro256 split() noexcept {
+            Xoshiro256 res = *this;
+            jump();
+            return res;
+        }
+
+        [[nodiscard]] const std::array<u64, 4>& state() const noexcept {
+            return _s;
+        }
+    };
+
+    //pcg32 (XSH RR), 16 bytes of state and 32 bit outputs, every odd increment is a separate stream
+    class Pcg32 {
+        u64 _state{0};
+        u64 _inc;
+
+    public:
+        using result_type = u32;
+
+        explicit Pcg32(const u64 seed = 0, const u64 stream = 0xDA3E39CB94B95BDBULL) noexcept : _inc((stream << 1) | 1) {
+            (*this)();
+            _state += seed;
+            (*this)();
+        }
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<u32>::max();
+        }
+
+        FORCE_INLINE result_type operator()() noexcept {
+            const u64 old = _state;
+            _state = old * 6364136223846793005ULL + _inc;
+            const auto xorshifted = static_cast<u32>(((old >> 18) ^ old) >> 27);
+            const auto rot = static_cast<u32>(old >> 59);
+            return std::rotr(xorshifted, static_cast<int>(rot));
+        }
+
+        void seed(const u64 seed) noexcept {
+            *this = Pcg32(seed, _inc >> 1);
+        }
+
+        //an engine on a stream chosen by this one's next outputs
+        Pcg32 split() noexcept {
+            const u64 seed = (static_cast<u64>((*this)()) << 32) | (*this)();
+            const u64 stream = (static_cast<u64>((*this)()) << 32) | (*this)();
+            return Pcg32(seed, stream);
+        }
+    };
+
+    /*
+     * four xoshiro256** streams, each 2^128 steps past the one before it, stepped together with AVX2 or SSE2, so
+     * fill_bits() makes four values a step, operator() hands the values out one at a time, the streams are
+     * interleaved, so the output isn't the same sequence as a single Xoshiro256
+     */
+    class Xoshiro256x4 {
+        static constexpr usize lanes = 4;
+
+        //_s[word][lane]
+        alignas(32) u64 _s[4][lanes];
+        alignas(32) u64 _buffer[lanes];
+        usize _next{lanes};
+
+#if defined(__AVX2__)
+        static FORCE_INLINE __m256i rotl(const __m256i x, const int k) {
+            return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+        }
+#elif defined(__SSE2__)
+        static FORCE_INLINE __m128i rotl(const __m128i x, const int k) {
+            return _mm_or_si128(_mm_slli_epi64(x, k), _mm_srli_epi64(x, 64 - k));
+        }
+#endif
+
+        //steps every stream count times, writing their outputs to out, the state stays in registers until the end
+        void run(u64* out, const usize count) noexcept {
+#if defined(__AVX2__)
+            __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(_s[0]));
+            __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(_s[1]));
+            __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(_s[2]));
+            __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(_s[3]));
+            for (usize i = 0; i < count; i++) {
+                //there is no 64 bit multiply before avx512, x*5 and x*9 are shifts and adds
+                const __m256i r = rotl(_mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2)), 7);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * lanes), _mm256_add_epi64(r, _mm256_slli_epi64(r, 3)));
+                const __m256i t = _mm256_slli_epi64(s1, 17);
+                s2 = _mm256_xor_si256(s2, s0);
+                s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2);
+                s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = rotl(s3, 45);
+            }
+            _mm256_store_si256(reinterpret_cast<__m256i*>(_s[0]), s0);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(_s[1]), s1);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(_s[2]), s2);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(_s[3]), s3);
+#elif defined(__SSE2__)
+            //two registers of two streams each, a and b
+            __m128i a0 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[0]));
+            __m128i a1 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[1]));
+            __m128i a2 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[2]));
+            __m128i a3 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[3]));
+            __m128i b0 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[0] + 2));
+            __m128i b1 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[1] + 2));
+            __m128i b2 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[2] + 2));
+            __m128i b3 = _mm_load_si128(reinterpret_cast<const __m128i*>(_s[3] + 2));
+            auto advance = [](__m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3, u64* dst) {
+                const __m128i r = rotl(_mm_add_epi64(s1, _mm_slli_epi64(s1, 2)), 7);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_add_epi64(r, _mm_slli_epi64(r, 3)));
+                const __m128i t = _mm_slli_epi64(s1, 17);
+                s2 = _mm_xor_si128(s2, s0);
+                s3 = _mm_xor_si128(s3, s1);
+                s1 = _mm_xor_si128(s1, s2);
+                s0 = _mm_xor_si128(s0, s3);
+                s2 = _mm_xor_si128(s2, t);
+                s3 = rotl(s3, 45);
+            };
+            for (usize i = 0; i < count; i++) {
+                advance(a0, a1, a2, a3, out + i * lanes);
+                advance(b0, b1, b2, b3, out + i * lanes + 2);
+            }
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[0]), a0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[1]), a1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[2]), a2);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[3]), a3);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[0] + 2), b0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[1] + 2), b1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[2] + 2), b2);
+            _mm_store_si128(reinterpret_cast<__m128i*>(_s[3] + 2), b3);
+#else
+            for (usize i = 0; i < count; i++) {
+                for (usize l = 0; l < lanes; l++) {
+                    const u64 s1 = _s[1][l];
+                    const u64 r = ((s1 * 5) << 7) | ((s1 * 5) >> 57);
+                    out[i * lanes + l] = r * 9;
+                    const u64 t = s1 << 17;
+                    _s[2][l] ^= _s[0][l];
+                    _s[3][l] ^= _s[1][l];
+                    _s[1][l] ^= _s[2][l];
+                    _s[0][l] ^= _s[3][l];
+                    _s[2][l] ^= t;
+                    _s[3][l] = (_s[3][l] << 45) | (_s[3][l] >> 19);
+                }
+            }
+#endif
+        }
+
+    public:
+        using result_type = u64;
+
+        explicit Xoshiro256x4(const u64 seed = 0) noexcept {
+            this->seed(seed);
+        }
+
+        //the streams start at engine's position, so engine should have been split off for them
+        explicit Xoshiro256x4(Xoshiro256 engine) noexcept {
+            for (usize l = 0; l < lanes; l++) {
+                for (usize w = 0; w < 4; w++) _s[w][l] = engine.state()[w];
+                engine.jump();
+            }
+        }
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<u64>::max();
+        }
+
+        FORCE_INLINE result_type operator()() noexcept {
+            if (_next == lanes) {
+                run(_buffer, 1);
+                _next = 0;
+            }
+            return _buffer[_next++];
+        }
+
+        void seed(const u64 seed) noexcept {
+            *this = Xoshiro256x4(Xoshiro256(seed));
+        }
+
+        //writes n random u64s to out, four a step
+        void fill_bits(u64* out, const usize n) noexcept {
+            usize i = 0;
+            while (i < n && _next != lanes) out[i++] = _buffer[_next++];
+            const usize steps = (n - i) / lanes;
+            run(out + i, steps);
+            i += steps * lanes;
+            while (i < n) out[i++] = (*this)();
+        }
+
+        //an engine whose streams are 2^192 steps past this one's
+        Xoshiro256x4 split() noexcept {
+            Xoshiro256x4 res = *this;
+            for (usize l = 0; l < lanes; l++) {
+                Xoshiro256 lane(std::array{_s[0][l], _s[1][l], _s[2][l], _s[3][l]});
+                lane.long_jump();
+                for (usize w = 0; w < 4; w++) res._s[w][l] = lane.state()[w];
+            }
+            res._next = lanes;
+            return res;
+        }
+    };
+
+    /*
+     * philox 4x32-10, a counter based engine, the outputs at any position are a function of (seed, stream, counter)
+     * alone, so any stream can be started at any position in O(1) without stepping to it, that makes streams for
+     * tasks or indices free to create and the results the same however the work is split between threads
+     *
+     * every 128 bit counter value makes a block of four outputs, the counter is the block's 64 bit position in its
+     * stream followed by the 64 bit stream, and the seed is the key
+     */
+    class Philox4x32 {
+        u64 _seed;
+        u64 _stream;
+        //the block after the one in _buffer
+        u64 _counter{0};
+        std::array<u32, 4> _buffer{};
+        u32 _next{4};
+
+        static FORCE_INLINE void mulhilo(const u32 a, const u32 b, u32& hi, u32& lo) {
+            const u64 product = static_cast<u64>(a) * b;
+            hi = static_cast<u32>(product >> 32);
+            lo = static_cast<u32>(product);
+        }
+
+#if defined(__SSE2__)
+        //mulhilo of each of the four lanes of x with m
+        static FORCE_INLINE void mulhilo(const __m128i m, const __m128i x, __m128i& hi, __m128i& lo) {
+            const __m128i even = _mm_mul_epu32(x, m);
+            const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), m);
+            const __m128i low_half = _mm_set1_epi64x(0xFFFFFFFFLL);
+            lo = _mm_or_si128(_mm_and_si128(even, low_half), _mm_slli_epi64(odd, 32));
+            hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low_half, odd));
+        }
+
+        //blocks _counter to _counter + 3 at once, a block to a lane, written to out as 8 u64s in stream order
+        void blocks4(u64* out) noexcept {
+            auto lane_words = [&](const int shift) {
+                return _mm_set_epi32(static_cast<int>((_counter + 3) >> shift), static_cast<int>((_counter + 2) >> shift),
+                                     static_cast<int>((_counter + 1) >> shift), static_cast<int>(_counter >> shift));
+            };
+            __m128i c0 = lane_words(0), c1 = lane_words(32);
+            __m128i c2 = _mm_set1_epi32(static_cast<int>(_stream)), c3 = _mm_set1_epi32(static_cast<int>(_stream >> 32));
+            u32 k0 = static_cast<u32>(_seed), k1 = static_cast<u32>(_seed >> 32);
+            const __m128i m0 = _mm_set1_epi32(static_cast<int>(0xD2511F53u));
+            const __m128i m1 = _mm_set1_epi32(static_cast<int>(0xCD9E8D57u));
+            for (int round = 0; round < 10; round++) {
+                __m128i hi0, lo0, hi1, lo1;
+                mulhilo(m0, c0, hi0, lo0);
+                mulhilo(m1, c2, hi1, lo1);
+                c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+                c1 = lo1;
+                c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+                c3 = lo0;
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            _counter += 4;
+
+            //the first output of a pair is the high half of its u64, as in BasicRandom
+            const __m128i a01 = _mm_unpacklo_epi32(c1, c0), a23 = _mm_unpackhi_epi32(c1, c0);
+            const __m128i b01 = _mm_unpacklo_epi32(c3, c2), b23 = _mm_unpackhi_epi32(c3, c2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi64(a01, b01));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), _mm_unpackhi_epi64(a01, b01));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpacklo_epi64(a23, b23));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 6), _mm_unpackhi_epi64(a23, b23));
+        }
+#endif
+
     public:
+        using result_type = u32;
+
+        explicit Philox4x32(const u64 seed = 0, const u64 stream = 0) noexcept : _seed(seed), _stream(stream) {}
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<u32>::max();
+        }
+
+        //the four outputs of block counter of stream
+        static std::array<u32, 4> block(const u64 seed, const u64 stream, const u64 counter) noexcept {
+            u32 c0 = static_cast<u32>(counter), c1 = static_cast<u32>(counter >> 32);
+            u32 c2 = static_cast<u32>(stream), c3 = static_cast<u32>(stream >> 32);
+            u32 k0 = static_cast<u32>(seed), k1 = static_cast<u32>(seed >> 32);
+            for (int round = 0; round < 10; round++) {
+                u32 hi0, lo0, hi1, lo1;
+                mulhilo(0xD2511F53u, c0, hi0, lo0);
+                mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+                c0 = hi1 ^ c1 ^ k0;
+                c1 = lo1;
+                c2 = hi0 ^ c3 ^ k1;
+                c3 = lo0;
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            return {c0, c1, c2, c3};
+        }
+
+        FORCE_INLINE result_type operator()() noexcept {
+            if (_next == 4) {
+                _buffer = block(_seed, _stream, _counter++);
+                _next = 0;
+            }
+            return _buffer[_next++];
+        }
+
+        //starts the stream again from its first output
+        void seed(const u64 seed) noexcept {
+            *this = Philox4x32(seed, _stream);
+        }
+
+        //moves to the output at position in the stream, in O(1)
+        void seek(const u64 position) noexcept {
+            _counter = position / 4;
+            _next = 4;
+            if (position % 4) {
+                (*this)();
+                _next = static_cast<u32>(position % 4);
+            }
+        }
+
+        void discard(const u64 n) noexcept {
+            seek(position() + n);
+        }
+
+        //how many outputs have been taken from the stream
+        [[nodiscard]] u64 position() const noexcept {
+            return _counter * 4 - (4 - _next);
+        }
+
+        [[nodiscard]] u64 stream() const noexcept {
+            return _stream;
+        }
+
+        //writes n u64s to out, each made of the next two outputs with the first in the high half, four blocks at a
+        //time with sse2
+        void fill_bits(u64* out, const usize n) noexcept {
+            auto pair = [&] {
+                const u64 high = (*this)();
+                return (high << 32) | (*this)();
+            };
+            usize i = 0;
+#if defined(__SSE2__)
+            //whole blocks only line up with the pairs from an even position
+            if (_next % 2 == 0) {
+                while (i < n && _next != 4) out[i++] = pair();
+                for (; i + 8 <= n; i += 8) blocks4(out + i);
+            }
+#endif
+            for (; i < n; i++) out[i] = pair();
+        }
+
+        //the same seed on a stream picked by hashing this one's stream and position
+        Philox4x32 split() noexcept {
+            SplitMix64 mix(_stream ^ (position() * 0x9E3779B97F4A7C15ULL));
+            mix();
+            return Philox4x32(_seed, mix());
+        }
+    };
+
+    //engines that can write many outputs at once, BasicRandom::fill uses fill_bits when the engine has it
+    template<typename E>
+    concept BulkEngine = requires(E& engine, u64* out, usize n) {
+        engine.fill_bits(out, n);
+    };
 
-        Random() : engine(std::random_device{}()) {}
+    namespace RandomDetail {
+        //a random value in [0, range) from x, lemire's multiply and shift, which only needs a division when the
+        //low half of the product lands in the biased zone, x is redrawn with next() until it doesn't
+        template<typename Next>
+        FORCE_INLINE u64 bounded(u64 x, const u64 range, Next&& next) {
+            auto m = static_cast<unsigned __int128>(x) * range;
+            if (static_cast<u64>(m) < range) [[unlikely]] {
+                const u64 threshold = (0 - range) % range;
+                while (static_cast<u64>(m) < threshold) {
+                    x = next();
+                    m = static_cast<unsigned __int128>(x) * range;
+                }
+            }
+            return static_cast<u64>(m >> 64);
+        }
+
+        template<typename Next>
+        FORCE_INLINE u32 bounded32(u32 x, const u32 range, Next&& next) {
+            u64 m = static_cast<u64>(x) * range;
+            if (static_cast<u32>(m) < range) [[unlikely]] {
+                const u32 threshold = (0u - range) % range;
+                while (static_cast<u32>(m) < threshold) {
+                    x = next();
+                    m = static_cast<u64>(x) * range;
+                }
+            }
+            return static_cast<u32>(m >> 32);
+        }
+
+        //the bits a value of T is made from, types of 4 bytes or less only need 32, so one u64 makes two of them
+        template<typename T>
+        using bits_t = std::conditional_t<sizeof(T) <= 4, u32, u64>;
+
+        //a float in [0, 1) from the top bits of x, f32 and f64 put them in the mantissa of a number in [1, 2) and
+        //subtract 1, which is only bit operations, so loops of them vectorize
+        template<std::floating_point T>
+        FORCE_INLINE T unit(const u32 x) {
+            if constexpr (std::is_same_v<T, f32>) return std::bit_cast<f32>((x >> 9) | 0x3F800000u) - 1.0f;
+            else return static_cast<T>(x) * static_cast<T>(0x1.0p-32);
+        }
+
+        template<std::floating_point T>
+        FORCE_INLINE T unit(const u64 x) {
+            if constexpr (std::is_same_v<T, f64>) {
+                return std::bit_cast<f64>((x >> 12) | 0x3FF0000000000000ULL) - 1.0;
+            } else if constexpr (sizeof(T) <= 4) {
+                return unit<T>(static_cast<u32>(x >> 32));
+            } else {
+                return static_cast<T>(x >> 11) * static_cast<T>(0x1.0p-53);
+            }
+        }
+
+        //std::random_device is only read once, for the first seed, every seed after it is the next output of a
+        //SplitMix64 whose state is an atomic, so seeding is a fetch_add instead of a read from the OS
+        inline u64 fresh_seed() {
+            static std::atomic<u64> state = [] {
+                std::random_device rd;
+                return (static_cast<u64>(rd()) << 32) | rd();
+            }();
+            u64 z = state.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        //splitting a root engine under a lock is how every thread gets a stream of its own
+        inline Xoshiro256 split_root() {
+            static std::mutex mtx;
+            static Xoshiro256 root(fresh_seed());
+            std::lock_guard lock(mtx);
+            return root.split();
+        }
+    }
+
+    /*
+     * random numbers from Engine, ranges are reduced with lemire's method, so there are no distributions to
+     * construct and no bias, floats are the top bits of a draw scaled into [0, 1), Random uses Xoshiro256, any std
+     * engine such as std::mt19937_64 works as well
+     */
+    template<typename Engine>
+    class BasicRandom {
+        Engine _engine;
+
+        FORCE_INLINE u64 next64() {
+            static_assert(Engine::min() == 0, "BasicRandom needs an engine whose outputs start at 0");
+            if constexpr (Engine::max() == std::numeric_limits<u64>::max()) {
+                return static_cast<u64>(_engine());
+            } else {
+                static_assert(Engine::max() == std::numeric_limits<u32>::max(),
+                              "BasicRandom needs an engine with 32 or 64 bit outputs");
+                const u64 high = static_cast<u32>(_engine());
+                return (high << 32) | static_cast<u32>(_engine());
+            }
+        }
+
+        FORCE_INLINE u32 next32() {
+            if constexpr (Engine::max() == std::numeric_limits<u32>::max()) return static_cast<u32>(_engine());
+            else return static_cast<u32>(next64() >> 32);
+        }
+
+        template<typename T>
+        FORCE_INLINE RandomDetail::bits_t<T> draw() {
+            if constexpr (sizeof(T) <= 4) return next32();
+            else return next64();
+        }
+
+        //a value of T in [min, max] from the bits in x, redraw() gives the bits for another try when x lands in the
+        //biased zone
+        template<std::integral T, typename Redraw>
+        static FORCE_INLINE T reduce(const RandomDetail::bits_t<T> x, const T min, const T max, Redraw&& redraw) {
+            using U = std::make_unsigned_t<T>;
+            const auto span = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+            if constexpr (sizeof(T) <= 4) {
+                if (span == std::numeric_limits<U>::max()) return static_cast<T>(static_cast<U>(x));
+                const u32 r = RandomDetail::bounded32(x, static_cast<u32>(span) + 1, redraw);
+                return static_cast<T>(static_cast<U>(min) + static_cast<U>(r));
+            } else {
+                if (span == std::numeric_limits<U>::max()) return static_cast<T>(x);
+                const u64 r = RandomDetail::bounded(x, static_cast<u64>(span) + 1, redraw);
+                return static_cast<T>(static_cast<U>(min) + static_cast<U>(r));
+            }
+        }
+
+        template<std::integral T>
+        FORCE_INLINE T reduce(const RandomDetail::bits_t<T> x, const T min, const T max) {
+            return reduce(x, min, max, [&] { return draw<T>(); });
+        }
+
+        //fills out with make(bits, index), the bits are drawn a block at a time, all at once for a BulkEngine, and
+        //each u64 makes two values of a type that only needs 32 bits
+        template<Arithmetic T, typename Make>
+        void fill_from_bits(const std::span<T> out, Make&& make) {
+            constexpr usize per_word = sizeof(RandomDetail::bits_t<T>) == 4 ? 2 : 1;
+            constexpr usize block = 512;
+            u64 bits[block / per_word];
+
+            for (usize i = 0; i < out.size(); i += block) {
+                const usize n = std::min(block, out.size() - i);
+                const usize words = (n + per_word - 1) / per_word;
+                if constexpr (BulkEngine<Engine>) {
+                    _engine.fill_bits(bits, words);
+                } else {
+                    for (usize j = 0; j < words; j++) bits[j] = next64();
+                }
+
+                T* dst = out.data() + i;
+                if constexpr (per_word == 2) {
+                    usize j = 0;
+                    for (; j + 2 <= n; j += 2) {
+                        dst[j] = make(static_cast<u32>(bits[j / 2]), i + j);
+                        dst[j + 1] = make(static_cast<u32>(bits[j / 2] >> 32), i + j + 1);
+                    }
+                    if (j < n) dst[j] = make(static_cast<u32>(bits[j / 2]), i + j);
+                } else {
+                    for (usize j = 0; j < n; j++) dst[j] = make(bits[j], i + j);
+                }
+            }
+        }
+
+    public:
+        using engine_type = Engine;
+
+        //seeded from std::random_device, see RandomDetail::fresh_seed
+        BasicRandom() : _engine(RandomDetail::fresh_seed()) {}
+
+        explicit BasicRandom(const u64 seed) : _engine(seed) {}
+
+        explicit BasicRandom(Engine engine) : _engine(std::move(engine)) {}
+
+        void seed(const u64 seed) {
+            _engine.seed(seed);
+        }
+
+        [[nodiscard]] Engine& engine() noexcept {
+            return _engine;
+        }
+
+        //a generator with a stream independent of this one's, for another thread or task
+        BasicRandom split() requires requires(Engine& e) { e.split(); } {
+            return BasicRandom(_engine.split());
+        }
 
         // returns a random number in [min, max]
         template<std::integral T>
         T random(T min, T max) {
-            std::uniform_int_distribution<T> dist(min, max);
-            return dist(engine);
+            if (min > max) std::swap(min, max);
+            return reduce(draw<T>(), min, max);
         }
 
+        // returns a random number in [min, max)
         template<std::floating_point T>
         T random(T min, T max) {
-            std::uniform_real_distribution<T> dist(min, max);
-            return dist(engine);
+            return min + (max - min) * RandomDetail::unit<T>(draw<T>());
         }
 
         // returns a random number across the entire range of T
         template<std::integral T>
         T random() {
-            std::uniform_int_distribution<T> dist(
-                std::numeric_limits<T>::lowest(),
-                std::numeric_limits<T>::max()
-            );
-            return dist(engine);
+            return static_cast<T>(next64());
         }
 
         template<std::floating_point T>
@@ -39,17 +699,88 @@ namespace Auxil {
                 std::numeric_limits<T>::lowest(),
                 std::numeric_limits<T>::max()
             );
-            return dist(engine);
+            return dist(_engine);
         }
 
         // returns a float in [0,1)
         template<std::floating_point T>
         T random_percent() {
-            std::uniform_real_distribution<T> dist(0.0, 1.0);
-            return dist(engine);
+            return RandomDetail::unit<T>(draw<T>());
+        }
+
+        //fills out with numbers in [min, max] ([min, max) for floats), the bits are drawn a block at a time, all
+        //at once for a BulkEngine, and each u64 makes two values of a type that only needs 32 bits
+        template<Arithmetic T>
+        requires (!std::is_same_v<T, bool>)
+        void fill(const std::span<T> out, T min, T max) {
+            if constexpr (std::integral<T>) {
+                if (min > max) std::swap(min, max);
+                fill_from_bits(out, [&](const RandomDetail::bits_t<T> x, usize) { return reduce(x, min, max); });
+            } else {
+                const T width = max - min;
+                fill_from_bits(out, [&](const RandomDetail::bits_t<T> x, usize) {
+                    return static_cast<T>(min + width * RandomDetail::unit<T>(x));
+                });
+            }
+        }
+
+        //the same as fill, but when the bits for out[j] have to be redrawn they come from redraws(j) instead of this
+        //generator, so this generator's position only depends on out.size() and each value only on its own bits
+        //and its own redraws, redraws(j) is only called on the rare redraw
+        template<std::integral T, typename Redraws>
+        requires (!std::is_same_v<T, bool>) && std::is_same_v<std::invoke_result_t<Redraws&, usize>, BasicRandom&>
+        void fill(const std::span<T> out, T min, T max, Redraws&& redraws) {
+            if (min > max) std::swap(min, max);
+            fill_from_bits(out, [&](const RandomDetail::bits_t<T> x, const usize j) {
+                return reduce(x, min, max, [&] { return redraws(j).template draw<T>(); });
+            });
+        }
+
+        template<Arithmetic T>
+        requires (!std::is_same_v<T, bool>)
+        void fill(Array<T>& out, const T min, const T max) {
+            fill(std::span<T>(out.data(), out.size()), min, max);
+        }
+    };
+
+    using Random = BasicRandom<Xoshiro256>;
+    using StreamRandom = BasicRandom<Philox4x32>;
+
+    /*
+     * numbered, independent StreamRandoms from one seed, stream(i) is the same generator every time it's asked for,
+     * so giving each task, chunk or element the stream of its index makes parallel work reproducible, see the
+     * parallel_for and parallel_fill overloads that take one
+     */
+    class RandomStreams {
+        u64 _seed;
+
+    public:
+        explicit RandomStreams(const u64 seed) noexcept : _seed(seed) {}
+
+        //a seed from std::random_device, for when reproducing a run doesn't matter
+        RandomStreams() : _seed(RandomDetail::fresh_seed()) {}
+
+        [[nodiscard]] StreamRandom stream(const u64 index) const {
+            return StreamRandom(Philox4x32(_seed, index));
+        }
+
+        //stream(index) starting from its output at position
+        [[nodiscard]] StreamRandom stream(const u64 index, const u64 position) const {
+            Philox4x32 engine(_seed, index);
+            engine.seek(position);
+            return StreamRandom(engine);
         }
 
+        [[nodiscard]] u64 seed() const noexcept {
+            return _seed;
+        }
     };
+
+    //a Random for the calling thread, every thread's is split from one root, so their streams never overlap
+    inline Random& thread_random() {
+        thread_local Random rng(RandomDetail::split_root());
+        return rng;
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
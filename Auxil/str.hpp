@@ -1,14 +1,40 @@
 #ifndef STRING_HPP
 #define STRING_HPP
 
+#include <array>
+#include <bit>
+#include <cctype>
 #include <concepts>
+#include <cstring>
+#include <cwctype>
+#include <locale>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <span>
 
 #include "containers.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 namespace Auxil {
 
     template<std::integral CharT>
     class BasicStr;
 
+    template<std::integral CharT>
+    class BasicStrSearcher;
+
+    template<std::integral CharT>
+    class BasicStrView;
+
+    template<std::integral CharT>
+    class BasicSplitRange;
+
+    template<std::integral CharT>
+    class BasicTokenRange;
+
 
 
 
@@ -52,59 +78,932 @@ namespace Auxil {
     template<std::integral CharT>
     BasicStr<CharT> to_str(const BasicStr<char>& wstr);
 
-    template<std::integral CharT>
-    BasicStr<CharT> to_str(const std::string& str);
+    template<std::integral CharT>
+    BasicStr<CharT> to_str(const std::string& str);
+
+    template<std::integral CharT>
+    BasicStr<CharT> to_str(const std::wstring& str);
+
+
+    template<typename T, typename CharT>
+    concept MemberTemplateStringifieable = requires (const T& object)
+    {
+      { object.template to_str<CharT>() } -> std::convertible_to<BasicStr<CharT>>;
+    };
+
+    template<typename T, typename CharT>
+    concept MemberStringifieable =
+    requires(const T& object)
+    {
+        { object.to_str() } -> std::convertible_to<BasicStr<CharT>>;
+    };
+
+    template<typename T, typename CharT>
+    concept Stringifieable =
+    requires(const T& object)
+    {
+        { to_str<CharT>(object) } -> std::convertible_to<BasicStr<CharT>>;
+    };
+
+    template<typename T, typename CharT>
+    concept TemplateStringifieable =
+    requires(const T& object)
+    {
+        { to_str<T, CharT>(object) } -> std::convertible_to<BasicStr<CharT>>;
+    };
+
+    //to_str must be callable either by passing in the char type to_str<CharT> or by the type and char type to_str<T, CharT>
+
+
+    //the character storage of BasicStr, strings that fit in the object itself never allocate, longer ones come from
+    //a std::pmr::memory_resource, works like the Array it replaced, size() is how many characters fit including the
+    //null terminator
+    template<std::integral CharT>
+    class StrBuffer {
+    public:
+        //how many characters fit inline, including the null terminator
+        static constexpr usize local_capacity = std::max<usize>(16 / sizeof(CharT), 2);
+        using iterator = PointerIterator<CharT>;
+
+    private:
+        CharT* _ptr;
+        //the capacity is only needed once the characters are on the heap, so it shares space with them
+        union {
+            usize _capacity;
+            CharT _local[local_capacity];
+        };
+        //null means the default resource, which is only looked up once there is something to allocate
+        std::pmr::memory_resource* _resource;
+
+        void release() {
+            if (!is_local()) MemoryDetail::deallocate(_resource, _ptr, _capacity);
+            _ptr = _local;
+            _local[0] = CharT{};
+        }
+
+    public:
+        explicit StrBuffer(std::pmr::memory_resource* resource = nullptr) noexcept
+            : _ptr(_local), _local{}, _resource(resource) {}
+
+        explicit StrBuffer(const usize size, std::pmr::memory_resource* resource = nullptr)
+            : StrBuffer(resource) {
+            if (size > local_capacity) {
+                _ptr = MemoryDetail::allocate<CharT>(_resource, size);
+                _capacity = size;
+            }
+        }
+
+        //BasicStr only copies the characters it uses, not the whole buffer
+        StrBuffer(const StrBuffer&) = delete;
+        StrBuffer& operator=(const StrBuffer&) = delete;
+
+        StrBuffer(StrBuffer&& other) noexcept : StrBuffer(other._resource) {
+            *this = std::move(other);
+        }
+
+        //takes the other buffer's resource along with its characters
+        StrBuffer& operator=(StrBuffer&& other) noexcept {
+            if (&other == this) return *this;
+            release();
+            _resource = other._resource;
+
+            if (other.is_local()) {
+                std::copy_n(other._local, local_capacity, _local);
+                //the moved from string is empty, its c_str() shouldn't still show the characters
+                other._local[0] = CharT{};
+            } else {
+                _ptr = other._ptr;
+                _capacity = other._capacity;
+                other._ptr = other._local;
+                other._local[0] = CharT{};
+            }
+
+            return *this;
+        }
+
+        ~StrBuffer() {
+            if (!is_local()) MemoryDetail::deallocate(_resource, _ptr, _capacity);
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return MemoryDetail::resolve(_resource);
+        }
+
+        [[nodiscard]] FORCE_INLINE bool is_local() const {
+            return _ptr == _local;
+        }
+
+        [[nodiscard]] FORCE_INLINE usize size() const {
+            return is_local() ? local_capacity : _capacity;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]] FORCE_INLINE CharT* data() const {
+            return _ptr;
+        }
+
+        FORCE_INLINE CharT& operator[](const usize ind) const {
+            return _ptr[ind];
+        }
+
+        [[nodiscard]] CharT& back() const {
+            return _ptr[size()-1];
+        }
+
+        [[nodiscard]] iterator begin() const {
+            return _ptr;
+        }
+
+        [[nodiscard]] iterator end() const {
+            return _ptr + size();
+        }
+    };
+
+    namespace StrDetail {
+        constexpr usize no_match = std::numeric_limits<usize>::max();
+
+        //what tokenize splits on by default
+        template<std::integral CharT>
+        constexpr CharT whitespace[] = {' ', '\t', '\n', '\r', '\v', '\f', CharT{}};
+
+        //horspool shifts, indexed by the low byte of a character, a shift is capped at 255 so one byte is enough,
+        //characters that share a low byte share the smallest of their shifts, so wide strings can use it too
+        using SkipTable = std::array<u8, 256>;
+
+        //needles this long are searched with the skip table once there is one, shorter ones are faster to find by
+        //filtering for their first and last characters
+        constexpr usize skip_min = 32;
+
+        //if filter checks sixteen windows at once, which beats horspool at every needle length, so there is no
+        //point building the tables
+#if defined(__SSE2__)
+        template<std::integral CharT>
+        constexpr bool vector_filter = sizeof(CharT) == 1;
+#else
+        template<std::integral CharT>
+        constexpr bool vector_filter = false;
+#endif
+
+        template<std::integral CharT>
+        FORCE_INLINE usize bucket(const CharT c) {
+            return static_cast<usize>(c) & 0xFF;
+        }
+
+        template<std::integral CharT>
+        FORCE_INLINE bool equal(const CharT* a, const CharT* b, const usize n) {
+            return n == 0 || std::memcmp(a, b, n * sizeof(CharT)) == 0;
+        }
+
+        //how far a window can move forward when its last character is c
+        template<std::integral CharT>
+        void build_skip(SkipTable& skip, const CharT* needle, const usize m) {
+            skip.fill(static_cast<u8>(std::min<usize>(m, 255)));
+            for (usize i = 0; i + 1 < m; i++) skip[bucket(needle[i])] = static_cast<u8>(std::min<usize>(m - 1 - i, 255));
+        }
+
+        //how far a window can move back when its first character is c
+        template<std::integral CharT>
+        void build_rskip(SkipTable& skip, const CharT* needle, const usize m) {
+            skip.fill(static_cast<u8>(std::min<usize>(m, 255)));
+            for (usize i = m - 1; i > 0; i--) skip[bucket(needle[i])] = static_cast<u8>(std::min<usize>(i, 255));
+        }
+
+        template<std::integral CharT>
+        FORCE_INLINE const CharT* find_char(const CharT* s, const usize n, const CharT c) {
+            if constexpr (sizeof(CharT) == 1) {
+                return static_cast<const CharT*>(std::memchr(s, static_cast<unsigned char>(c), n));
+            } else {
+                const CharT* p = std::find(s, s + n, c);
+                return p == s + n ? nullptr : p;
+            }
+        }
+
+        template<std::integral CharT>
+        usize horspool(const CharT* s, const usize n, const CharT* needle, const usize m, const SkipTable& skip) {
+            const CharT last = needle[m - 1];
+            for (usize i = 0; i <= n - m;) {
+                const CharT c = s[i + m - 1];
+                if (c == last && equal(s + i, needle, m - 1)) return i;
+                i += skip[bucket(c)];
+            }
+            return no_match;
+        }
+
+        template<std::integral CharT>
+        usize rhorspool(const CharT* s, const usize n, const CharT* needle, const usize m, const SkipTable& skip) {
+            const CharT first = needle[0];
+            for (usize i = n - m;;) {
+                const CharT c = s[i];
+                if (c == first && equal(s + i + 1, needle + 1, m - 1)) return i;
+                const usize shift = skip[bucket(c)];
+                if (shift > i) return no_match;
+                i -= shift;
+            }
+        }
+
+        //checks every window whose first and last characters match the needle's, sixteen windows at a time with sse2,
+        //only the windows that pass both get compared in full, so ordinary text rarely compares at all
+        template<std::integral CharT>
+        usize filter(const CharT* s, const usize n, const CharT* needle, const usize m) {
+            const usize windows = n - m + 1, rest = m - 2;
+            usize i = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+                const __m128i last = _mm_set1_epi8(static_cast<char>(needle[m - 1]));
+                for (; i + 16 <= windows; i += 16) {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+                    auto mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                                                _mm_cmpeq_epi8(b, last))));
+                    while (mask) {
+                        const usize j = i + static_cast<usize>(std::countr_zero(mask));
+                        if (equal(s + j + 1, needle + 1, rest)) return j;
+                        mask &= mask - 1;
+                    }
+                }
+            }
+#endif
+            const CharT first = needle[0], last = needle[m - 1];
+            while (i < windows) {
+                const CharT* p = find_char(s + i, windows - i, first);
+                if (!p) return no_match;
+                i = static_cast<usize>(p - s);
+                if (s[i + m - 1] == last && equal(s + i + 1, needle + 1, rest)) return i;
+                i++;
+            }
+            return no_match;
+        }
+
+        template<std::integral CharT>
+        usize rfilter(const CharT* s, const usize n, const CharT* needle, const usize m) {
+            usize windows = n - m + 1;
+            //a single character has nothing past its first and last to compare
+            const usize rest = m < 2 ? 0 : m - 2;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+                const __m128i last = _mm_set1_epi8(static_cast<char>(needle[m - 1]));
+                for (; windows >= 16; windows -= 16) {
+                    const usize i = windows - 16;
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+                    auto mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                                                _mm_cmpeq_epi8(b, last))));
+                    while (mask) {
+                        const usize bit = 31 - static_cast<usize>(std::countl_zero(mask));
+                        if (equal(s + i + bit + 1, needle + 1, rest)) return i + bit;
+                        mask &= ~(1u << bit);
+                    }
+                }
+            }
+#endif
+            const CharT first = needle[0], last = needle[m - 1];
+            while (windows > 0) {
+                const usize i = --windows;
+                if (s[i] == first && s[i + m - 1] == last && equal(s + i + 1, needle + 1, rest)) return i;
+            }
+            return no_match;
+        }
+
+        //the offset of the first match of the m character needle in the n characters at s, skip is the needle's
+        //table when it has been precompiled
+        template<std::integral CharT>
+        usize search(const CharT* s, const usize n, const CharT* needle, const usize m, const SkipTable* skip) {
+            if (m == 0) return 0;
+            if (m > n) return no_match;
+            if (m == 1) {
+                const CharT* p = find_char(s, n, needle[0]);
+                return p ? static_cast<usize>(p - s) : no_match;
+            }
+            if (skip && m >= skip_min) return horspool(s, n, needle, m, *skip);
+            return filter(s, n, needle, m);
+        }
+
+        //the offset of the last match, an empty needle matches at the end
+        template<std::integral CharT>
+        usize rsearch(const CharT* s, const usize n, const CharT* needle, const usize m, const SkipTable* skip) {
+            if (m == 0) return n;
+            if (m > n) return no_match;
+            if (skip && m >= skip_min) return rhorspool(s, n, needle, m, *skip);
+            return rfilter(s, n, needle, m);
+        }
+
+        //ascii characters are handled with arithmetic (and sixteen at a time with sse2), anything else goes through
+        //the same locale calls as before, so the fast paths only change how fast ascii text is processed
+        template<std::integral CharT>
+        FORCE_INLINE bool is_ascii(const CharT c) {
+            return static_cast<std::make_unsigned_t<CharT>>(c) < 128;
+        }
+
+        //what compare_ignore_case and hash_ignore_case compare a character as
+        template<std::integral CharT>
+        FORCE_INLINE int fold(const CharT c) {
+            if (is_ascii(c)) return static_cast<int>(c) + (static_cast<unsigned>(c - 'A') < 26 ? 32 : 0);
+            //std::tolower only takes unsigned char values (and EOF), so bytes are folded as unsigned
+            if constexpr (sizeof(CharT) == 1) return std::tolower(static_cast<unsigned char>(c));
+            else return static_cast<int>(std::towlower(static_cast<wint_t>(static_cast<std::make_unsigned_t<CharT>>(c))));
+        }
+
+        template<std::integral CharT>
+        FORCE_INLINE bool is_space(const CharT c) {
+            if (is_ascii(c)) return c == ' ' || static_cast<unsigned>(c - '\t') < 5;
+            if constexpr (sizeof(CharT) == 1) return std::iswspace(static_cast<unsigned char>(c));
+            else return std::iswspace(static_cast<wint_t>(static_cast<std::make_unsigned_t<CharT>>(c)));
+        }
+
+#if defined(__SSE2__)
+        //the bytes of v that are between lo and hi, bytes at or above 128 are negative, so they never are
+        FORCE_INLINE __m128i in_range(const __m128i v, const char lo, const char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                                 _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+        }
+
+        FORCE_INLINE __m128i ascii_lower(const __m128i v) {
+            return _mm_or_si128(v, _mm_and_si128(in_range(v, 'A', 'Z'), _mm_set1_epi8(0x20)));
+        }
+
+        FORCE_INLINE u32 space_mask(const __m128i v) {
+            const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), in_range(v, '\t', '\r'));
+            return static_cast<u32>(_mm_movemask_epi8(space));
+        }
+#endif
+
+        template<bool Upper, std::integral CharT>
+        void change_case_scalar(CharT* s, const usize n) {
+            //only looked up once there is a character that needs it
+            std::optional<std::locale> loc;
+            for (usize i = 0; i < n; i++) {
+                CharT& c = s[i];
+                if (is_ascii(c)) {
+                    if (static_cast<unsigned>(c - (Upper ? 'a' : 'A')) < 26) c ^= 0x20;
+                    continue;
+                }
+                if (!loc) loc.emplace();
+                if constexpr (Upper) {
+                    if (std::isalpha(c, *loc) && std::islower(c, *loc)) c = std::toupper(c, *loc);
+                } else {
+                    if (std::isalpha(c, *loc) && std::isupper(c, *loc)) c = std::tolower(c, *loc);
+                }
+            }
+        }
+
+        //lower() and upper(), once a block of sixteen has a non-ascii byte the rest of the string is done one
+        //character at a time
+        template<bool Upper, std::integral CharT>
+        void change_case(CharT* s, const usize n) {
+            usize i = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                for (; i + 16 <= n; i += 16) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                    if (_mm_movemask_epi8(v)) break;
+                    const __m128i letters = Upper ? in_range(v, 'a', 'z') : in_range(v, 'A', 'Z');
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(s + i), _mm_xor_si128(v, _mm_and_si128(letters, _mm_set1_epi8(0x20))));
+                }
+            }
+#endif
+            change_case_scalar<Upper>(s + i, n - i);
+        }
+
+        //how many whitespace characters the n characters at s start with
+        template<std::integral CharT>
+        usize leading_space(const CharT* s, const usize n) {
+            usize i = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                for (; i + 16 <= n; i += 16) {
+                    const u32 mask = space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+                    if (mask != 0xFFFF) {
+                        i += static_cast<usize>(std::countr_one(mask));
+                        break;
+                    }
+                }
+            }
+#endif
+            while (i < n && is_space(s[i])) ++i;
+            return i;
+        }
+
+        //how many whitespace characters the n characters at s end with
+        template<std::integral CharT>
+        usize trailing_space(const CharT* s, const usize n) {
+            usize i = n;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                for (; i >= 16; i -= 16) {
+                    const u32 mask = space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i - 16)));
+                    if (mask != 0xFFFF) {
+                        i -= static_cast<usize>(std::countl_one(mask << 16));
+                        break;
+                    }
+                }
+            }
+#endif
+            while (i > 0 && is_space(s[i-1])) --i;
+            return n - i;
+        }
+
+        template<std::integral CharT>
+        std::strong_ordering compare_ignore_case(const CharT* a, const usize an, const CharT* b, const usize bn) {
+            const usize n = std::min(an, bn);
+            usize i = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(CharT) == 1) {
+                while (i + 16 <= n) {
+                    const __m128i va = ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+                    const __m128i vb = ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+                    const u32 diff = ~static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) & 0xFFFF;
+                    if (!diff) {
+                        i += 16;
+                        continue;
+                    }
+                    //bytes that differ as ascii can still be the same letter to the locale
+                    i += static_cast<usize>(std::countr_zero(diff));
+                    if (fold(a[i]) != fold(b[i])) return fold(a[i]) <=> fold(b[i]);
+                    i++;
+                }
+            }
+#endif
+            for (; i < n; i++) {
+                if (fold(a[i]) != fold(b[i])) return fold(a[i]) <=> fold(b[i]);
+            }
+            return an <=> bn;
+        }
+
+        //std::hash<BasicStr>, h = h*31 + c, four characters a step so that each step doesn't wait on the last, with
+        //IgnoreCase every character is folded first, which is the hash of the lowered string for ascii text
+        template<bool IgnoreCase, std::integral CharT>
+        usize hash(const CharT* s, const usize n) {
+            auto value = [](const CharT c) {
+                if constexpr (IgnoreCase) return static_cast<usize>(fold(c));
+                else return static_cast<usize>(c);
+            };
+            usize h = 0, i = 0;
+            for (; i + 4 <= n; i += 4) {
+                h = h*923521 + value(s[i])*29791 + value(s[i+1])*961 + value(s[i+2])*31 + value(s[i+3]);
+            }
+            for (; i < n; i++) h = h*31 + value(s[i]);
+
+            return h;
+        }
+    }
+
+    /*
+     * a non-owning, read-only view of characters, usually a piece of a BasicStr, making one never allocates, so
+     * views are what parsing code should pass around and split into, the characters must outlive the view and it is
+     * not null terminated, to_str() copies it into a BasicStr when one is needed
+     */
+    template<std::integral CharT>
+    class BasicStrView {
+        const CharT* _data{nullptr};
+        usize _length{0};
+
+    public:
+        constexpr static usize npos = std::numeric_limits<usize>::max();
+
+        using value_type = CharT;
+        using traits_type = std::char_traits<CharT>;
+        using const_reference = const CharT&;
+        using const_pointer = const CharT*;
+        using iterator = PointerIterator<const CharT>;
+        using difference_type = ptrdiff_t;
+        using size_type = usize;
+        using searcher = BasicStrSearcher<CharT>;
+
+        constexpr BasicStrView() noexcept = default;
+
+        constexpr BasicStrView(const CharT* s, const usize n) noexcept : _data(s), _length(n) {}
+
+        constexpr BasicStrView(const CharT* s) : _data(s), _length(s ? traits_type::length(s) : 0) {}
+
+        constexpr BasicStrView(const std::basic_string_view<CharT> s) noexcept : _data(s.data()), _length(s.size()) {}
+
+        BasicStrView(const std::basic_string<CharT>& s) noexcept : _data(s.data()), _length(s.size()) {}
+
+        constexpr operator std::basic_string_view<CharT>() const noexcept {
+            return {_data, _length};
+        }
+
+        [[nodiscard]] BasicStr<CharT> to_str() const {
+            return BasicStr<CharT>(_data, _length);
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicStrView& s) {
+            return os.write(s._data, static_cast<std::streamsize>(s._length));
+        }
+
+        //--------- Access -----------
+
+        [[nodiscard]] constexpr usize size() const noexcept {
+            return _length;
+        }
+
+        [[nodiscard]] constexpr usize length() const noexcept {
+            return _length;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return _length == 0;
+        }
+
+        [[nodiscard]] constexpr const CharT* data() const noexcept {
+            return _data;
+        }
+
+        [[nodiscard]] iterator begin() const {
+            return _data;
+        }
+
+        [[nodiscard]] iterator end() const {
+            return _data + _length;
+        }
+
+        FORCE_INLINE const CharT& operator[](const usize ind) const {
+            return _data[ind];
+        }
+
+        [[nodiscard]] const CharT& at(const usize ind) const {
+            if (ind >= _length) throw Exception("Cannot access index {} of a view of length {}", ind, _length);
+            return _data[ind];
+        }
+
+        [[nodiscard]] const CharT& front() const {
+            if (_length == 0) throw Exception("Cannot access front of empty view!");
+            return _data[0];
+        }
+
+        [[nodiscard]] const CharT& back() const {
+            if (_length == 0) throw Exception("Cannot access back of empty view!");
+            return _data[_length-1];
+        }
+
+        //--------- Slicing -----------
+
+        //unlike BasicStr::substr, pos may be the end of the view, which gives an empty view
+        [[nodiscard]] BasicStrView substr(const usize pos, const usize n = npos) const {
+            if (pos > _length) throw Exception("Cannot create subview from slice {}..{} of a view of length {}", pos,
+                pos+n, _length);
+            return {_data+pos, std::min(n, _length-pos)};
+        }
+
+        BasicStrView& remove_prefix(const usize n) {
+            const usize k = std::min(n, _length);
+            _data += k;
+            _length -= k;
+            return *this;
+        }
+
+        BasicStrView& remove_suffix(const usize n) {
+            _length -= std::min(n, _length);
+            return *this;
+        }
+
+        [[nodiscard]] BasicStrView trimmed() const {
+            const usize front = StrDetail::leading_space(_data, _length);
+            const usize back = front == _length ? 0 : StrDetail::trailing_space(_data, _length);
+            return {_data+front, _length-front-back};
+        }
+
+        //--------- Searching -----------
+
+        //index and rindex only match inside [pos, pos+n), like BasicStr
+        [[nodiscard]] usize index(const BasicStrView s, const usize pos = 0, const usize n = npos) const {
+            return _index(s._data, s._length, pos, n, nullptr, false);
+        }
+
+        [[nodiscard]] usize index(const searcher& s, const usize pos = 0, const usize n = npos) const {
+            return _index(s.needle().c_str(), s.size(), pos, n, s.skip_table(), false);
+        }
+
+        [[nodiscard]] usize rindex(const BasicStrView s, const usize pos = 0, const usize n = npos) const {
+            return _index(s._data, s._length, pos, n, nullptr, true);
+        }
+
+        [[nodiscard]] usize rindex(const searcher& s, const usize pos = 0, const usize n = npos) const {
+            return _index(s.needle().c_str(), s.size(), pos, n, s.rskip_table(), true);
+        }
+
+        [[nodiscard]] iterator find(const BasicStrView s, const usize pos = 0, const usize n = npos) const {
+            const usize i = index(s, pos, n);
+            return i == npos ? end() : begin()+i;
+        }
+
+        [[nodiscard]] iterator find(const searcher& s, const usize pos = 0, const usize n = npos) const {
+            const usize i = index(s, pos, n);
+            return i == npos ? end() : begin()+i;
+        }
+
+        [[nodiscard]] iterator rfind(const BasicStrView s, const usize pos = 0, const usize n = npos) const {
+            const usize i = rindex(s, pos, n);
+            return i == npos ? end() : begin()+i;
+        }
+
+        [[nodiscard]] iterator rfind(const searcher& s, const usize pos = 0, const usize n = npos) const {
+            const usize i = rindex(s, pos, n);
+            return i == npos ? end() : begin()+i;
+        }
+
+        //overlapping matches, like BasicStr::count
+        [[nodiscard]] usize count(const BasicStrView s) const {
+            if (s.empty() || s._length > _length) return 0;
+            usize c = 0;
+            for (usize i = index(s); i != npos; i = index(s, i+1)) c++;
+
+            return c;
+        }
+
+        [[nodiscard]] bool contains(const BasicStrView s) const {
+            return index(s) != npos;
+        }
+
+        [[nodiscard]] bool starts_with(const BasicStrView s) const {
+            return s._length <= _length && StrDetail::equal(_data, s._data, s._length);
+        }
+
+        [[nodiscard]] bool ends_with(const BasicStrView s) const {
+            return s._length <= _length && StrDetail::equal(_data+_length-s._length, s._data, s._length);
+        }
+
+        //the pieces between each delimiter without copying them, see BasicSplitRange
+        [[nodiscard]] BasicSplitRange<CharT> split(const BasicStrView delimiter) const {
+            return {*this, delimiter, nullptr};
+        }
+
+        [[nodiscard]] BasicSplitRange<CharT> split(const searcher& delimiter) const {
+            return {*this, BasicStrView(delimiter.needle().c_str(), delimiter.size()), delimiter.skip_table()};
+        }
+
+        //the runs of characters that aren't any of the delimiters, whitespace by default, see BasicTokenRange
+        [[nodiscard]] BasicTokenRange<CharT> tokenize(const BasicStrView delimiters = StrDetail::whitespace<CharT>) const {
+            return {*this, delimiters};
+        }
+
+        //--------- Comparison -----------
+
+        //compares with the other view's subview from pos to pos+n
+        [[nodiscard]] std::strong_ordering compare(const BasicStrView other, const usize pos = 0, usize n = npos) const {
+            if (pos > other._length) return std::strong_ordering::less;
+            n = std::min(n, other._length-pos);
+            return std::lexicographical_compare_three_way(_data, _data+_length, other._data+pos, other._data+pos+n);
+        }
+
+        //ascii letters compare equal to their other case, other characters go through std::tolower
+        [[nodiscard]] std::strong_ordering compare_ignore_case(const BasicStrView other, const usize pos = 0, usize n = npos) const {
+            if (pos > other._length) return std::strong_ordering::less;
+            n = std::min(n, other._length-pos);
+            return StrDetail::compare_ignore_case(_data, _length, other._data+pos, n);
+        }
+
+        [[nodiscard]] bool equals_ignore_case(const BasicStrView other) const {
+            return _length == other._length && compare_ignore_case(other) == std::strong_ordering::equal;
+        }
+
+        //the std::hash of the lowered view, without lowering a copy of it
+        [[nodiscard]] usize hash_ignore_case() const {
+            return StrDetail::hash<true>(_data, _length);
+        }
+
+        [[nodiscard]] bool operator==(const BasicStrView other) const {
+            return _length == other._length && StrDetail::equal(_data, other._data, _length);
+        }
+
+        [[nodiscard]] std::strong_ordering operator<=>(const BasicStrView other) const {
+            return compare(other);
+        }
+
+    private:
+        [[nodiscard]] usize _index(const CharT* s, const usize m, const usize pos, usize n,
+                                   const StrDetail::SkipTable* skip, const bool reverse) const {
+            if (m > _length || pos >= _length) return npos;
+            n = std::min(n, _length-pos);
+            const usize i = reverse ? StrDetail::rsearch(_data+pos, n, s, m, skip) : StrDetail::search(_data+pos, n, s, m, skip);
+            return i == StrDetail::no_match ? npos : pos+i;
+        }
+    };
+
+    /*
+     * the pieces of a view between each delimiter, found one at a time as the range is iterated, each piece is a
+     * view into the source, empty pieces are skipped and an empty or too long delimiter gives the whole source,
+     * which are the same pieces BasicStr::split returns
+     */
+    template<std::integral CharT>
+    class BasicSplitRange {
+        BasicStrView<CharT> _source;
+        BasicStrView<CharT> _delimiter;
+        //a searcher's table, the searcher must outlive the range
+        const StrDetail::SkipTable* _skip;
+
+    public:
+        class iterator {
+            const BasicSplitRange* _range{nullptr};
+            BasicStrView<CharT> _part{};
+            //where the search for the next delimiter starts, npos once the last piece has been reached
+            usize _next{0};
+
+            void advance() {
+                const auto& src = _range->_source;
+                const usize m = _range->_delimiter.size();
+                while (_next != npos && _next < src.size()) {
+                    const usize i = StrDetail::search(src.data()+_next, src.size()-_next, _range->_delimiter.data(), m,
+                                                      _range->_skip);
+                    if (i == StrDetail::no_match) {
+                        _part = src.substr(_next);
+                        _next = npos;
+                        return;
+                    }
+                    const usize start = _next;
+                    _next += i + m;
+                    if (i != 0) {
+                        _part = src.substr(start, i);
+                        return;
+                    }
+                }
+                _range = nullptr;
+            }
+
+        public:
+            constexpr static usize npos = std::numeric_limits<usize>::max();
+
+            using value_type = BasicStrView<CharT>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            explicit iterator(const BasicSplitRange* range) : _range(range) {
+                const auto& src = range->_source;
+                if (range->_delimiter.empty() || range->_delimiter.size() > src.size() || src.empty()) {
+                    _part = src;
+                    _next = npos;
+                } else {
+                    advance();
+                }
+            }
+
+            const BasicStrView<CharT>& operator*() const {
+                return _part;
+            }
+
+            const BasicStrView<CharT>* operator->() const {
+                return &_part;
+            }
+
+            iterator& operator++() {
+                if (_next == npos) _range = nullptr;
+                else advance();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator& other) const {
+                return _range == other._range && (!_range || _part.data() == other._part.data());
+            }
+
+            bool operator==(std::default_sentinel_t) const {
+                return _range == nullptr;
+            }
+        };
+
+        BasicSplitRange(const BasicStrView<CharT> source, const BasicStrView<CharT> delimiter,
+                        const StrDetail::SkipTable* skip) : _source(source), _delimiter(delimiter), _skip(skip) {}
+
+        [[nodiscard]] iterator begin() const {
+            return iterator(this);
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const {
+            return {};
+        }
+    };
+
+    /*
+     * the runs of a view that contain none of the delimiter characters, found one at a time as the range is
+     * iterated, for words and fields split on any of several characters, delimiters that fit in a byte are looked
+     * up in a bitmap, wider ones are searched for
+     */
+    template<std::integral CharT>
+    class BasicTokenRange {
+        BasicStrView<CharT> _source;
+        BasicStrView<CharT> _delimiters;
+        std::array<u64, 4> _bytes{};
+        bool _wide_delimiters{false};
+
+        [[nodiscard]] bool is_delimiter(const CharT c) const {
+            const auto u = static_cast<std::make_unsigned_t<CharT>>(c);
+            if (u < 256 && (_bytes[u >> 6] >> (u & 63) & 1)) return true;
+            return _wide_delimiters && std::find(_delimiters.begin(), _delimiters.end(), c) != _delimiters.end();
+        }
+
+    public:
+        class iterator {
+            const BasicTokenRange* _range{nullptr};
+            BasicStrView<CharT> _part{};
+            usize _next{0};
+
+            void advance() {
+                const auto& src = _range->_source;
+                usize i = _next;
+                while (i < src.size() && _range->is_delimiter(src[i])) ++i;
+                if (i == src.size()) {
+                    _range = nullptr;
+                    return;
+                }
+                usize j = i + 1;
+                while (j < src.size() && !_range->is_delimiter(src[j])) ++j;
+                _part = src.substr(i, j-i);
+                _next = j;
+            }
+
+        public:
+            using value_type = BasicStrView<CharT>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            explicit iterator(const BasicTokenRange* range) : _range(range) {
+                advance();
+            }
+
+            const BasicStrView<CharT>& operator*() const {
+                return _part;
+            }
+
+            const BasicStrView<CharT>* operator->() const {
+                return &_part;
+            }
 
-    template<std::integral CharT>
-    BasicStr<CharT> to_str(const std::wstring& str);
+            iterator& operator++() {
+                advance();
+                return *this;
+            }
 
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
 
-    template<typename T, typename CharT>
-    concept MemberTemplateStringifieable = requires (const T& object)
-    {
-      { object.template to_str<CharT>() } -> std::convertible_to<BasicStr<CharT>>;
-    };
+            bool operator==(const iterator& other) const {
+                return _range == other._range && (!_range || _part.data() == other._part.data());
+            }
 
-    template<typename T, typename CharT>
-    concept MemberStringifieable =
-    requires(const T& object)
-    {
-        { object.to_str() } -> std::convertible_to<BasicStr<CharT>>;
-    };
+            bool operator==(std::default_sentinel_t) const {
+                return _range == nullptr;
+            }
+        };
+
+        BasicTokenRange(const BasicStrView<CharT> source, const BasicStrView<CharT> delimiters)
+            : _source(source), _delimiters(delimiters) {
+            for (const CharT c: delimiters) {
+                const auto u = static_cast<std::make_unsigned_t<CharT>>(c);
+                if (u < 256) _bytes[u >> 6] |= u64(1) << (u & 63);
+                else _wide_delimiters = true;
+            }
+        }
 
-    template<typename T, typename CharT>
-    concept Stringifieable =
-    requires(const T& object)
-    {
-        { to_str<CharT>(object) } -> std::convertible_to<BasicStr<CharT>>;
-    };
+        [[nodiscard]] iterator begin() const {
+            return iterator(this);
+        }
 
-    template<typename T, typename CharT>
-    concept TemplateStringifieable =
-    requires(const T& object)
-    {
-        { to_str<T, CharT>(object) } -> std::convertible_to<BasicStr<CharT>>;
+        [[nodiscard]] std::default_sentinel_t end() const {
+            return {};
+        }
     };
 
-    //to_str must be callable either by passing in the char type to_str<CharT> or by the type and char type to_str<T, CharT>
-
 
     template<std::integral CharT>
     class BasicStr {
     public:
         constexpr static usize npos = std::numeric_limits<usize>::max();
     private:
-        Array<CharT> _cstr{};
+        StrBuffer<CharT> _cstr{};
         usize _length{0};
 
+        //the constructors that copy n characters all end up here, a null resource means the default resource
+        struct WithResource {};
+        constexpr BasicStr(WithResource, const CharT* s, const usize n, std::pmr::memory_resource* resource)
+            : _cstr(n+1, resource), _length(n) {
+            std::copy_n(s, n, _cstr.data());
+            _cstr[_length] = CharT{};
+        }
+
 
 
         void _reserve(usize size) {
-            Array<CharT> alloc(size+1);//1 to make sure we have room for the null character
+            StrBuffer<CharT> alloc(size+1, _cstr.resource());//1 to make sure we have room for the null character
 
             _length = std::min(size, _length);
-            auto rng = _cstr | std::ranges::views::take(_length);
-            std::ranges::move(rng, alloc.begin());
+            std::copy_n(_cstr.data(), _length, alloc.data());
             alloc[_length] = CharT{};
             _cstr = std::move(alloc);
         }
@@ -124,6 +1023,41 @@ namespace Auxil {
             return std::strong_ordering::equal;
         }
 
+        //the first and last matches of the m characters at s inside [pos, pos+n), skip is a searcher's table
+        usize _index(const CharT* s, const usize m, const usize pos, usize n, const StrDetail::SkipTable* skip) const {
+            if (m > _length || pos >= _length) return npos;
+            n = std::min(n, _length-pos);
+            const usize i = StrDetail::search(_cstr.data()+pos, n, s, m, skip);
+            return i == StrDetail::no_match ? npos : pos+i;
+        }
+
+        usize _rindex(const CharT* s, const usize m, const usize pos, usize n, const StrDetail::SkipTable* skip) const {
+            if (m > _length || pos >= _length) return npos;
+            n = std::min(n, _length-pos);
+            const usize i = StrDetail::rsearch(_cstr.data()+pos, n, s, m, skip);
+            return i == StrDetail::no_match ? npos : pos+i;
+        }
+
+        //counts overlapping matches, like count always has
+        usize _count(const CharT* s, const usize m, const StrDetail::SkipTable* skip) const {
+            if (m == 0 || m > _length) return 0;
+            usize c = 0;
+            for (usize i = _index(s, m, 0, npos, skip); i != npos; i = _index(s, m, i+1, npos, skip)) c++;
+
+            return c;
+        }
+
+        template<typename Out>
+        void _split(const CharT* s, const usize m, const StrDetail::SkipTable* skip, Out&& out) const {
+            usize start = 0;
+            for (usize i = _index(s, m, 0, npos, skip); i != npos; i = _index(s, m, start, npos, skip)) {
+                if (i != start && !out(substr(start, i-start))) return;
+                start = i + m;
+            }
+
+            if (start < _length) out(substr(start));
+        }
+
     public:
 
         using value_type = CharT;
@@ -135,10 +1069,23 @@ namespace Auxil {
         using iterator = PointerIterator<CharT>;
         using difference_type = ptrdiff_t;
         using size_type = usize;
+        using allocator_type = std::pmr::polymorphic_allocator<CharT>;
+        using searcher = BasicStrSearcher<CharT>;
+        using view_type = BasicStrView<CharT>;
 
 
         BasicStr() = default;
-        BasicStr(const BasicStr&) noexcept = default;
+
+        //characters that don't fit inline are allocated from the allocator's resource, copies of the string use the
+        //default resource unless they are given an allocator, this takes an allocator rather than a resource pointer
+        //so that BasicStr(s, 0) still means a substring
+        explicit BasicStr(const allocator_type& alloc) : _cstr(alloc.resource()) {}
+
+        BasicStr(const BasicStr& s) : BasicStr(WithResource{}, s._cstr.data(), s._length, nullptr) {}
+
+        BasicStr(const BasicStr& s, const allocator_type& alloc)
+            : BasicStr(WithResource{}, s._cstr.data(), s._length, alloc.resource()) {}
+
         BasicStr(BasicStr&& s) noexcept {
             _cstr = std::move(s._cstr);
             _length = s._length;
@@ -147,58 +1094,66 @@ namespace Auxil {
         }
 
 
-        template<typename T, typename = std::enable_if_t<!std::is_same_v<std::initializer_list<CharT>, T> && ! std::is_same_v<T, CharT*>>>
+        template<typename T, typename = std::enable_if_t<!std::is_same_v<std::initializer_list<CharT>, T> && ! std::is_same_v<T, CharT*>
+                                                         && !std::is_convertible_v<T, std::pmr::memory_resource*>>>
         explicit BasicStr(const T& x) {
             append(x);
         }
 
 
-        BasicStr(const BasicStr& str, usize pos, usize len = npos) : _cstr(std::min(len, str._length-pos)+1),
-                                    _length{_cstr.size()-1} {
-            if (pos >= str._length) return;
+        BasicStr(const BasicStr& str, usize pos, usize len = npos) : _cstr(std::min(len, str._length-std::min(pos, str._length))+1),
+                                    _length{std::min(len, str._length-std::min(pos, str._length))} {
             for (usize i = 0; i < _length; i++) {
                 _cstr[i] = str._cstr[i+pos];
             }
-            _cstr.back() = CharT{};
+            _cstr[_length] = CharT{};
         }
 
-        BasicStr(const CharT* s) {
-            if (!s) return;
-            _cstr = Array<CharT>(traits_type::length(s)+1);
-            _length = _cstr.size()-1;
-            for (usize i = 0; i < _length; i++) {
-                _cstr[i] = s[i];
-            }
-            _cstr.back() = CharT{};
-        }
+        BasicStr(const CharT* s) : BasicStr(WithResource{}, s, s ? traits_type::length(s) : 0, nullptr) {}
 
-        constexpr BasicStr(const CharT* s, size_t n) : _cstr(n+1), _length(n) {
-            for (usize i = 0; i < _length; i++) {
-                _cstr[i] = s[i];
-            }
-            _cstr.back() = CharT{};
-        }
+        BasicStr(const CharT* s, const allocator_type& alloc)
+            : BasicStr(WithResource{}, s, s ? traits_type::length(s) : 0, alloc.resource()) {}
+
+        constexpr BasicStr(const CharT* s, size_t n) : BasicStr(WithResource{}, s, n, nullptr) {}
+
+        constexpr BasicStr(const CharT* s, size_t n, const allocator_type& alloc)
+            : BasicStr(WithResource{}, s, n, alloc.resource()) {}
+
+        explicit BasicStr(const view_type s) : BasicStr(WithResource{}, s.data(), s.size(), nullptr) {}
+
+        BasicStr(const view_type s, const allocator_type& alloc)
+            : BasicStr(WithResource{}, s.data(), s.size(), alloc.resource()) {}
 
         BasicStr(const usize n, const CharT c) : _cstr(n+1), _length(n) {
             std::fill(_cstr.begin(), _cstr.begin()+_length, c);
-            _cstr.back() = CharT{};
+            _cstr[_length] = CharT{};
         }
 
         template<typename InputIterator>
         BasicStr(InputIterator first, InputIterator last) : _cstr(std::distance(first, last)+1),
-                                                            _length(_cstr.size()-1) {
+                                                            _length(std::distance(first, last)) {
             std::ranges::copy(first, last, _cstr.begin());
-            _cstr.back() = CharT{};
+            _cstr[_length] = CharT{};
         }
 
         //TODO: input iterator constructor
 
         BasicStr(std::initializer_list<CharT> il) : _cstr(il.size()+1), _length(il.size()) {
             std::ranges::copy(il.begin(), il.end(), _cstr.begin());
-            _cstr.back() = CharT{};
+            _cstr[_length] = CharT{};
         }
 
-        BasicStr& operator=(const BasicStr&) noexcept = default;
+        BasicStr& operator=(const BasicStr& s) {
+            if (&s == this) return *this;
+
+            //keep the current buffer if it's big enough
+            if (s._length >= _cstr.size()) _cstr = StrBuffer<CharT>(s._length+1, _cstr.resource());
+            std::copy_n(s._cstr.data(), s._length, _cstr.data());
+            _length = s._length;
+            _cstr[_length] = CharT{};
+
+            return *this;
+        }
         BasicStr& operator=(BasicStr&& s) noexcept {
             if (&s == this) return *this;
 
@@ -210,20 +1165,19 @@ namespace Auxil {
         }
         BasicStr& operator=(const char* s) {
             if (!s) {
-                _cstr = Array<CharT>(1);
                 _length = 0;
                 _cstr[0] = CharT{};
                 return *this;
             }
 
             _length = traits_type::length(s);
-            _cstr = Array<CharT>(_length+1);
+            if (_length >= _cstr.size()) _cstr = StrBuffer<CharT>(_length+1, _cstr.resource());
 
             for (usize i = 0; i < _length; i++) {
                 _cstr[i] = s[i];
             }
 
-            _cstr.back() = CharT{};
+            _cstr[_length] = CharT{};
             return *this;
         }
 
@@ -233,13 +1187,31 @@ namespace Auxil {
             return os;
         }
 
+        //views of the string, they are invalidated by anything that changes it
+        operator view_type() const noexcept {
+            return {_cstr.data(), _length};
+        }
+
+        [[nodiscard]] view_type view(const usize pos = 0, const usize n = npos) const {
+            return view_type(*this).substr(pos, n);
+        }
+
 
         [[nodiscard]] iterator begin() const {
             return _cstr.begin();
         }
 
         [[nodiscard]] iterator end() const {
-            return _cstr.end();
+            return _cstr.data() + _length;
+        }
+
+        //how many characters fit before the string has to allocate again
+        [[nodiscard]] usize capacity() const {
+            return _cstr.size()-1;
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const {
+            return allocator_type(_cstr.resource());
         }
 
         [[nodiscard]] usize size() const {
@@ -336,10 +1308,8 @@ namespace Auxil {
             auto len = traits_type::length(cstr);
 
             if (_length + len >= _cstr.size()) {
-                //we do a exponential reserve to make frequent allocation faster,
-                //and then tac on the len to make sure we have enough for the string we're about to append
-                //reserve auto-handles reserving the null char
-                reserve(_cstr.size()*2 + len);
+                //grow geometrically through the growth path the containers share, reserve adds the null char
+                reserve(MemoryDetail::grow_capacity(capacity(), _length + len));
             }
 
             std::ranges::copy(cstr, cstr+len, _cstr.begin() + _length);
@@ -353,13 +1323,12 @@ namespace Auxil {
         template<std::integral Char>
         BasicStr& append(const Char& c) {
             if (_length + 1 >= _cstr.size()) {
-                //we do a exponential reserve to make frequent allocation faster,
-                //and then tac on the len to make sure we have enough for the string we're about to append
-                //reserve auto-handles reserving the null char
-                reserve(_cstr.size()*2 + 1);
+                //grow geometrically through the growth path the containers share, reserve adds the null char
+                reserve(MemoryDetail::grow_capacity(capacity(), _length + 1));
             }
 
             _cstr[_length++] = static_cast<CharT>(c);
+            _cstr[_length] = CharT{};
 
             return *this;
         }
@@ -369,10 +1338,8 @@ namespace Auxil {
 
 
             if (_length + len >= _cstr.size()) {
-                //we do a exponential reserve to make frequent allocation faster,
-                //and then tac on the len to make sure we have enough for the string we're about to append
-                //reserve auto-handles reserving the null char
-                reserve(_cstr.size()*2 + len);
+                //grow geometrically through the growth path the containers share, reserve adds the null char
+                reserve(MemoryDetail::grow_capacity(capacity(), _length + len));
             }
 
             std::ranges::copy(cstr, cstr+len, _cstr.begin() + _length);
@@ -383,6 +1350,10 @@ namespace Auxil {
             return *this;
         }
 
+        BasicStr& append(const view_type str) {
+            return append(str.data(), str.size());
+        }
+
         BasicStr& append(const BasicStr& str) {
             return append(str._cstr.data(), str.size());
         }
@@ -390,15 +1361,18 @@ namespace Auxil {
         template<typename T>
         BasicStr& append(const T& value);
 
+        //appends the digits of value, append() itself treats integers as characters
+        template<Arithmetic T>
+        requires (!std::is_same_v<T, bool>)
+        BasicStr& append_number(const T value);
+
 
         //since strings are arrays of characters *COUGH* java
         template<std::integral Char>
         BasicStr& push_back(const Char& c) {
             if (_length + 1 >= _cstr.size()) {
-                //we do a exponential reserve to make frequent allocation faster,
-                //and then tac on the len to make sure we have enough for the string we're about to append
-                //reserve auto-handles reserving the null char
-                _reserve(_cstr.size()*2 + 1);
+                //grow geometrically through the growth path the containers share, reserve adds the null char
+                _reserve(MemoryDetail::grow_capacity(capacity(), _length + 1));
             }
 
             _cstr[_length++] = static_cast<CharT>(c);
@@ -432,7 +1406,7 @@ namespace Auxil {
 
             // Ensure space for new chars + null terminator
             if (_length + n + 1 > _cstr.size()) {
-                _reserve(std::max(_cstr.size() * 2, _length + n + 1));
+                _reserve(MemoryDetail::grow_capacity(capacity(), _length + n));
             }
 
             // Shift tail to the right by n, starting from the last character (not including '\0')
@@ -548,7 +1522,7 @@ namespace Auxil {
 
             // Ensure capacity for potential growth
             if (_length + (rlen > n ? rlen - n : 0) + 1 > _cstr.size()) {
-                _reserve(std::max(_cstr.size() * 2, _length + (rlen > n ? rlen - n : 0) + 1));
+                _reserve(MemoryDetail::grow_capacity(capacity(), _length + (rlen > n ? rlen - n : 0)));
             }
 
             if (rlen > n) {
@@ -624,57 +1598,47 @@ namespace Auxil {
             return true;
         }
 
-        usize count(const BasicStr& str) const {
-            if (str.empty() || str.size() > _length) return 0;
-            if (_length == 0) return 0;
-            usize c = 0;
-
-            for (usize i = 0; i <= _length-str.size(); i++) {
-                if (str.compare(*this, i, str.size()) == std::strong_ordering::equal) c++;
-            }
+        usize count(const view_type str) const {
+            return _count(str.data(), str.size(), nullptr);
+        }
 
-            return c;
+        usize count(const searcher& s) const {
+            return _count(s.needle().c_str(), s.size(), s.skip_table());
         }
 
         BasicStr substr(const usize pos, usize n = npos) const {
             if (pos >= _length) throw Exception("Cannot create substring from slice {}..{} of string \"{}\"", pos, pos+n,
                 BasicStr<char>(_cstr.data()));
             n = std::min(n, _length-pos);
-            BasicStr res;
-            res.reserve(n);
-
-            for (usize i = 0; i < n; i++) {
-                res.push_back(_cstr[i+pos]);
-            }
 
-            return res;
+            return BasicStr(_cstr.data()+pos, n);
         }
 
-        [[nodiscard]] std::vector<BasicStr> split(const BasicStr& delimiter) const {
+        [[nodiscard]] std::vector<BasicStr> split(const view_type delimiter) const {
             if (delimiter.empty() || delimiter.size() > _length || empty()) return {*this};
             std::vector<BasicStr> result;
-            usize start = 0;
+            _split(delimiter.data(), delimiter.size(), nullptr, [&](BasicStr&& part) {
+                result.push_back(std::move(part));
+                return true;
+            });
 
-            for (usize i = 0; i <= _length-delimiter.size(); i++) {
-                if (delimiter.compare(*this, i, delimiter.size()) == std::strong_ordering::equal) {
-                    if (i != start) {
-                        result.push_back(substr(start, i-start));
-                    }
-                    start = i + delimiter.size();
-                    i = start-1;
-                }
-            }
+            return result;
+        }
 
-            if (start < _length) {
-                result.push_back(substr(start));
-            }
+        [[nodiscard]] std::vector<BasicStr> split(const searcher& delimiter) const {
+            if (delimiter.size() == 0 || delimiter.size() > _length || empty()) return {*this};
+            std::vector<BasicStr> result;
+            _split(delimiter.needle().c_str(), delimiter.size(), delimiter.skip_table(), [&](BasicStr&& part) {
+                result.push_back(std::move(part));
+                return true;
+            });
 
             return result;
         }
 
 
         template<class It>
-        It split(const BasicStr& delimiter, It _start, It _end) const {
+        It split(const view_type delimiter, It _start, It _end) const {
             if (_start == _end) return _start;
             if (delimiter.empty() || delimiter.size() > _length || empty()) {
                 *_start = *this;
@@ -682,23 +1646,10 @@ namespace Auxil {
             }
 
             It cur = _start;
-            usize start = 0;
-
-            for (usize i = 0; i <= _length-delimiter.size() && cur != _end; i++) {
-                if (delimiter.compare(*this, i, delimiter.size()) == std::strong_ordering::equal) {
-                    if (i != start) {
-                        *cur = substr(start, i-start);
-                        ++cur;
-                    }
-                    start = i + delimiter.size();
-                    i = start-1;//++ makes it start next iteration
-                }
-            }
-
-            if (start < _length && cur != _end) {
-                *cur = substr(start);
-                ++cur;
-            }
+            _split(delimiter.data(), delimiter.size(), nullptr, [&](BasicStr&& part) {
+                *cur = std::move(part);
+                return ++cur != _end;
+            });
 
             return cur;
         }
@@ -777,15 +1728,12 @@ namespace Auxil {
         }
 
         BasicStr& trim() {
-            usize n = 0;
-            while (n < _length && std::iswspace(static_cast<unsigned char>(_cstr[n]))) ++n;
-            if (n != 0) erase(0, n);
-
-            usize back = _length;
-            while (back > 0 && std::iswspace(static_cast<unsigned char>(_cstr[back-1]))) --back;
-            if (back != _length) {
-                erase(back - (back != 0));
-            }
+            const usize n = StrDetail::leading_space(_cstr.data(), _length);
+            const usize back = n == _length ? _length : _length - StrDetail::trailing_space(_cstr.data(), _length);
+            //one move for both ends
+            if (n != 0) std::copy(_cstr.data()+n, _cstr.data()+back, _cstr.data());
+            _length = back - n;
+            _cstr[_length] = CharT{};
 
             return *this;
         }
@@ -799,12 +1747,7 @@ namespace Auxil {
 
         BasicStr& lower() {
             //converts all alphabetical characters to lowercase if needed
-            auto loc = std::locale();
-            for (CharT& c: _cstr) {
-                if (std::isalpha(c, loc) && std::isupper(c, loc)) {
-                    c = std::tolower(c, loc);
-                }
-            }
+            StrDetail::change_case<false>(_cstr.data(), _length);
 
             return *this;
         }
@@ -817,13 +1760,8 @@ namespace Auxil {
 
 
         BasicStr& upper() {
-            //converts all alphabetical characters to lowercase if needed
-            auto loc = std::locale();
-            for (CharT& c: _cstr) {
-                if (std::isalpha(c, loc) && std::islower(c, loc)) {
-                    c = std::toupper(c, loc);
-                }
-            }
+            //converts all alphabetical characters to uppercase if needed
+            StrDetail::change_case<true>(_cstr.data(), _length);
 
             return *this;
         }
@@ -834,56 +1772,42 @@ namespace Auxil {
             return res;
         }
 
-        [[nodiscard]] iterator find(const BasicStr& s, usize pos = 0, usize n = npos) const {
-            if (s.size() > _length) return end();
-            if (pos >= _length) return end();
-            n = std::min(n, _length-pos);
+        //find, rfind, index and rindex only match inside [pos, pos+n), a searcher is faster for a needle that is
+        //looked for more than once
+        [[nodiscard]] iterator find(const view_type s, usize pos = 0, usize n = npos) const {
+            const usize i = _index(s.data(), s.size(), pos, n, nullptr);
+            return i == npos ? end() : begin()+i;
+        }
 
-            for (usize i = 0; i <= n-s.size(); i++) {
-                if (s.compare(*this, i+pos, s.size()) == std::strong_ordering::equal) {
-                    return begin()+pos+i;
-                }
-            }
-            return end();
+        [[nodiscard]] iterator find(const searcher& s, usize pos = 0, usize n = npos) const {
+            const usize i = _index(s.needle().c_str(), s.size(), pos, n, s.skip_table());
+            return i == npos ? end() : begin()+i;
         }
 
-        [[nodiscard]] iterator rfind(const BasicStr& s, usize pos = 0, usize n = npos) const {
-            if (s.size() > _length) return end();
-            if (pos >= _length) return end();
-            n = std::min(n, _length-pos);
-            //only difference is we check in reverse, and use i-1 to guard against underflow
-            for (usize i = n-s.size()+1; i > 0 ; --i) {
-                if (s.compare(*this, i+pos-1, s.size()) == std::strong_ordering::equal) {
-                    return begin()+pos+i-1;
-                }
-            }
-            return end();
+        [[nodiscard]] iterator rfind(const view_type s, usize pos = 0, usize n = npos) const {
+            const usize i = _rindex(s.data(), s.size(), pos, n, nullptr);
+            return i == npos ? end() : begin()+i;
         }
 
-        [[nodiscard]] usize index(const BasicStr& s, usize pos = 0, usize n = npos) const {
-            if (s.size() > _length) return npos;
-            if (pos >= _length) return npos;
-            n = std::min(n, _length-pos);
+        [[nodiscard]] iterator rfind(const searcher& s, usize pos = 0, usize n = npos) const {
+            const usize i = _rindex(s.needle().c_str(), s.size(), pos, n, s.rskip_table());
+            return i == npos ? end() : begin()+i;
+        }
 
-            for (usize i = 0; i <= n-s.size(); i++) {
-                if (s.compare(*this, i+pos, s.size()) == std::strong_ordering::equal) {
-                    return pos+i;
-                }
-            }
-            return npos;
+        [[nodiscard]] usize index(const view_type s, usize pos = 0, usize n = npos) const {
+            return _index(s.data(), s.size(), pos, n, nullptr);
         }
 
-        [[nodiscard]] usize rindex(const BasicStr& s, usize pos = 0, usize n = npos) const {
-            if (s.size() > _length) return npos;
-            if (pos >= _length) return npos;
-            n = std::min(n, _length-pos);
-            //only difference is we check in reverse, and use i-1 to guard against underflow
-            for (usize i = n-s.size()+1; i > 0 ; --i) {
-                if (s.compare(*this, i+pos-1, s.size()) == std::strong_ordering::equal) {
-                    return pos+i-1;
-                }
-            }
-            return npos;
+        [[nodiscard]] usize index(const searcher& s, usize pos = 0, usize n = npos) const {
+            return _index(s.needle().c_str(), s.size(), pos, n, s.skip_table());
+        }
+
+        [[nodiscard]] usize rindex(const view_type s, usize pos = 0, usize n = npos) const {
+            return _rindex(s.data(), s.size(), pos, n, nullptr);
+        }
+
+        [[nodiscard]] usize rindex(const searcher& s, usize pos = 0, usize n = npos) const {
+            return _rindex(s.needle().c_str(), s.size(), pos, n, s.rskip_table());
         }
 
         template<typename T, std::enable_if_t<!std::same_as<BasicStr, T>>>
@@ -924,6 +1848,32 @@ namespace Auxil {
             return s.compare(*this, _length-s.size(), s.size()) == std::strong_ordering::equal;
         }
 
+        [[nodiscard]] bool starts_with(const view_type s) const {
+            return view_type(*this).starts_with(s);
+        }
+
+        [[nodiscard]] bool ends_with(const view_type s) const {
+            return view_type(*this).ends_with(s);
+        }
+
+        //split and tokenize without copying, the ranges hold views into this string, so they can't be taken from
+        //a temporary, see BasicSplitRange and BasicTokenRange
+        [[nodiscard]] BasicSplitRange<CharT> split_view(const view_type delimiter) const& {
+            return view_type(*this).split(delimiter);
+        }
+
+        [[nodiscard]] BasicSplitRange<CharT> split_view(const searcher& delimiter) const& {
+            return view_type(*this).split(delimiter);
+        }
+
+        [[nodiscard]] BasicTokenRange<CharT> tokenize(const view_type delimiters = StrDetail::whitespace<CharT>) const& {
+            return view_type(*this).tokenize(delimiters);
+        }
+
+        BasicSplitRange<CharT> split_view(view_type) const&& = delete;
+        BasicSplitRange<CharT> split_view(const searcher&) const&& = delete;
+        BasicTokenRange<CharT> tokenize(view_type = {}) const&& = delete;
+
         template<typename... Args>
         [[nodiscard]] BasicStr format(Args&&... args) const {
             auto res = std::format(std::runtime_format(_cstr.data()), std::forward<Args>(args)...);
@@ -977,63 +1927,22 @@ namespace Auxil {
         //Comparators
 
         //compares with the other strings substring from pos to pos+n
-        std::strong_ordering compare(const BasicStr& other, usize pos = 0, usize n = npos) const {
-            if (pos > other.length()) return std::strong_ordering::less;
-            n = std::min(n, other.length()-pos);
-
-            for (usize i = 0; i < n && i < _length; i++) {
-                if (other[i+pos] != _cstr[i])
-                    return _cstr[i] <=> other[i+pos];
-            }
-
-            if (n > _length) return std::strong_ordering::greater;
-            if (n < _length) return std::strong_ordering::less;
-            return std::strong_ordering::equal;
+        std::strong_ordering compare(const view_type other, usize pos = 0, usize n = npos) const {
+            return view_type(*this).compare(other, pos, n);
         }
 
-        std::strong_ordering compare_ignore_case(const BasicStr& other, usize pos = 0, usize n = npos) const {
-            if (pos > other.length()) return std::strong_ordering::less;
-            n = std::min(n, other.length()-pos);
-
-            for (usize i = 0; i < n && i < _length; i++) {
-                if (std::tolower((int)other[i+pos]) != std::tolower((int)_cstr[i]))
-                    return std::tolower(_cstr[i]) <=> std::tolower(other[i+pos]);
-            }
-
-            if (n > _length) return std::strong_ordering::greater;
-            if (n < _length) return std::strong_ordering::less;
-            return std::strong_ordering::equal;
+        //ascii letters compare equal to their other case, other characters go through std::tolower
+        std::strong_ordering compare_ignore_case(const view_type other, usize pos = 0, usize n = npos) const {
+            return view_type(*this).compare_ignore_case(other, pos, n);
         }
 
-
-        std::strong_ordering compare(const CharT* other, usize pos = 0, usize n = npos) const {
-            auto olength = traits_type::length(other);
-            if (pos > olength) return std::strong_ordering::less;
-            n = std::min(n, olength-pos);
-
-            for (usize i = 0; i < n && i < _length; i++) {
-                if (other[i+pos] != _cstr[i])
-                    return other[i+pos] <=> _cstr[i];
-            }
-
-            if (n > _length) return std::strong_ordering::greater;
-            if (n < _length) return std::strong_ordering::less;
-            return std::strong_ordering::equal;
+        [[nodiscard]] bool equals_ignore_case(const view_type other) const {
+            return view_type(*this).equals_ignore_case(other);
         }
 
-        std::strong_ordering compare_ignore_case(const CharT* other, usize pos = 0, usize n = npos) const {
-            auto olength = traits_type::length(other);
-            if (pos > olength) return std::strong_ordering::less;
-            n = std::min(n, olength-pos);
-
-            for (usize i = 0; i < n && i < _length; i++) {
-                if (std::tolower((int)other[i+pos]) != std::tolower((int)_cstr[i]))
-                    return std::tolower(_cstr[i]) <=> std::tolower(other[i+pos]);
-            }
-
-            if (n > _length) return std::strong_ordering::greater;
-            if (n < _length) return std::strong_ordering::less;
-            return std::strong_ordering::equal;
+        //the std::hash of the lowered string, without lowering a copy of it
+        [[nodiscard]] usize hash_ignore_case() const {
+            return StrDetail::hash<true>(_cstr.data(), _length);
         }
 
         //relational operators
@@ -1054,12 +1963,11 @@ namespace Auxil {
         }
 
         bool operator>=(const BasicStr& str) const {
-            auto c = compare(str);
-            return c == std::strong_ordering::greater || c == std::strong_ordering::less;
+            return compare(str) != std::strong_ordering::less;
         }
 
         bool operator<=(const BasicStr& str) const {
-            return compare(str) == std::strong_ordering::less;
+            return compare(str) != std::strong_ordering::greater;
         }
 
         //non member stuff
@@ -1076,40 +1984,177 @@ namespace Auxil {
             auto const& ctype = std::use_facet<std::ctype<CharT>>(is.getloc());
 
 
-            // Skip leading whitespace
-            typename traits_t::int_type c = is.peek();
-            while (!traits_t::eq_int_type(c, traits_t::eof()) &&
-                   ctype.is(std::ctype_base::space, traits_t::to_char_type(c)))
-            {
-                is.get();
-                c = is.peek();
-            }
+            // Skip leading whitespace
+            typename traits_t::int_type c = is.peek();
+            while (!traits_t::eq_int_type(c, traits_t::eof()) &&
+                   ctype.is(std::ctype_base::space, traits_t::to_char_type(c)))
+            {
+                is.get();
+                c = is.peek();
+            }
+
+            if (traits_t::eq_int_type(c, traits_t::eof())) {
+                is.setstate(std::ios_base::failbit);
+                return is;
+            }
+
+            str.clear();
+
+            // Extract characters until next whitespace
+            while (!traits_t::eq_int_type(c, traits_t::eof()) &&
+                   !ctype.is(std::ctype_base::space, traits_t::to_char_type(c)))
+            {
+                str.push_back(traits_t::to_char_type(is.get()));
+                c = is.peek();
+            }
+
+            return is;
+        }
+
+    };
+
+    /*
+     * a needle compiled for searching, for a string that is looked for over and over, find, rfind, index, rindex,
+     * count and split all take one in place of the string, it keeps its own copy of the needle along with the
+     * horspool tables that let long needles skip most of the text, byte strings are scanned sixteen windows at a
+     * time with sse2 instead, which is faster than skipping, so for them the searcher only saves copying the needle
+     */
+    template<std::integral CharT>
+    class BasicStrSearcher {
+        BasicStr<CharT> _needle;
+        StrDetail::SkipTable _skip{};
+        StrDetail::SkipTable _rskip{};
+
+    public:
+        explicit BasicStrSearcher(BasicStr<CharT> needle) : _needle(std::move(needle)) {
+            if (uses_tables()) {
+                StrDetail::build_skip(_skip, _needle.c_str(), _needle.size());
+                StrDetail::build_rskip(_rskip, _needle.c_str(), _needle.size());
+            }
+        }
+
+        explicit BasicStrSearcher(const CharT* needle) : BasicStrSearcher(BasicStr<CharT>(needle)) {}
+
+        //the offset of the first match in the n characters at s, BasicStr<CharT>::npos if there isn't one
+        [[nodiscard]] usize search(const CharT* s, const usize n) const {
+            const usize i = StrDetail::search(s, n, _needle.c_str(), _needle.size(), skip_table());
+            return i == StrDetail::no_match ? BasicStr<CharT>::npos : i;
+        }
+
+        [[nodiscard]] usize rsearch(const CharT* s, const usize n) const {
+            const usize i = StrDetail::rsearch(s, n, _needle.c_str(), _needle.size(), rskip_table());
+            return i == StrDetail::no_match ? BasicStr<CharT>::npos : i;
+        }
+
+        [[nodiscard]] const BasicStr<CharT>& needle() const {
+            return _needle;
+        }
+
+        [[nodiscard]] usize size() const {
+            return _needle.size();
+        }
+
+        //byte strings are faster to search with the sse2 filter, so only long needles of wider characters (or any
+        //characters without sse2) search with the horspool tables
+        [[nodiscard]] bool uses_tables() const {
+            return !StrDetail::vector_filter<CharT> && _needle.size() >= StrDetail::skip_min;
+        }
+
+        //null when the needle doesn't use them
+        [[nodiscard]] const StrDetail::SkipTable* skip_table() const {
+            return uses_tables() ? &_skip : nullptr;
+        }
+
+        [[nodiscard]] const StrDetail::SkipTable* rskip_table() const {
+            return uses_tables() ? &_rskip : nullptr;
+        }
+    };
+
+    //hash and equality for unordered containers keyed case-insensitively, they are transparent, so a view or a
+    //string literal can look up a string key without a lowered copy of either
+    struct IgnoreCaseHash {
+        using is_transparent = void;
+
+        template<std::integral CharT>
+        usize operator()(const BasicStrView<CharT> s) const noexcept {
+            return s.hash_ignore_case();
+        }
 
-            if (traits_t::eq_int_type(c, traits_t::eof())) {
-                is.setstate(std::ios_base::failbit);
-                return is;
-            }
+        template<std::integral CharT>
+        usize operator()(const BasicStr<CharT>& s) const noexcept {
+            return s.hash_ignore_case();
+        }
 
-            str.clear();
+        template<std::integral CharT>
+        usize operator()(const CharT* s) const noexcept {
+            return BasicStrView<CharT>(s).hash_ignore_case();
+        }
+    };
 
-            // Extract characters until next whitespace
-            while (!traits_t::eq_int_type(c, traits_t::eof()) &&
-                   !ctype.is(std::ctype_base::space, traits_t::to_char_type(c)))
-            {
-                str.push_back(traits_t::to_char_type(is.get()));
-                c = is.peek();
-            }
+    struct IgnoreCaseEqual {
+        using is_transparent = void;
 
-            return is;
+        template<typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            return view(a).equals_ignore_case(view(b));
+        }
+
+    private:
+        template<std::integral CharT>
+        static BasicStrView<CharT> view(const BasicStrView<CharT> s) {
+            return s;
         }
 
+        template<std::integral CharT>
+        static BasicStrView<CharT> view(const BasicStr<CharT>& s) {
+            return s;
+        }
+
+        template<std::integral CharT>
+        static BasicStrView<CharT> view(const CharT* s) {
+            return s;
+        }
     };
 
-    //integers
+    namespace StrDetail {
+        /*
+         * std::from_chars for base 10 integers, detecting and parsing the number in one pass over its digits with
+         * ParseDetail::parse_digits, which reads eight at a time, like from_chars a '-' is only accepted for signed
+         * types and the number ends at the first character that isn't a digit
+         */
+        template<std::integral T>
+        std::from_chars_result parse_integer(const char* first, const char* last, T& value) {
+            const char* p = first;
+            const bool negative = std::is_signed_v<T> && p != last && *p == '-';
+            if (negative) ++p;
+
+            u64 magnitude;
+            bool overflow;
+            const char* end = ParseDetail::parse_digits(p, last, 10, magnitude, overflow);
+            if (end == p) return {first, std::errc::invalid_argument};
+
+            using U = std::make_unsigned_t<T>;
+            const u64 limit = static_cast<u64>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+            if (overflow || magnitude > limit) return {end, std::errc::result_out_of_range};
+
+            value = negative ? static_cast<T>(U{0} - static_cast<U>(magnitude)) : static_cast<T>(magnitude);
+            return {end, std::errc{}};
+        }
+
+        //parse_integer for integers, from_chars for floats
+        template<Arithmetic T>
+        FORCE_INLINE std::from_chars_result parse_number(const char* first, const char* last, T& value) {
+            if constexpr (std::integral<T>) return parse_integer(first, last, value);
+            else return std::from_chars(first, last, value, std::chars_format::general);
+        }
+    }
+
+    //integers, ston reads straight out of the view, so parsing a piece of a larger string doesn't copy it
     template<std::integral T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<char>& str, int base) {
+    T ston(const BasicStrView<char> str, int base) {
         T result{};
-        auto [ptr, ec] = std::from_chars(str.c_str(), str.c_str() + str.size(), result, base);
+        auto [ptr, ec] = base == 10 ? StrDetail::parse_integer(str.data(), str.data() + str.size(), result)
+                                    : std::from_chars(str.data(), str.data() + str.size(), result, base);
         if (ec != std::errc{}) {
             throw Exception("Invalid numeric string: {}\n"
                             "Note: with base = {}",str, base);
@@ -1118,15 +2163,15 @@ namespace Auxil {
     }
 
     template<std::integral T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<char>& str) {
+    T ston(const BasicStrView<char> str) {
         return ston<T>(str, 10);
     }
 
     //floats
     template<std::floating_point T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<char>& str, std::chars_format fmt) {
+    T ston(const BasicStrView<char> str, std::chars_format fmt) {
         T result{};
-        auto [ptr, ec] = std::from_chars(str.c_str(), str.c_str() + str.size(), result, fmt);
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result, fmt);
         if (ec != std::errc{}) {
             throw Exception("Invalid numeric string: {}", str);
         }
@@ -1134,7 +2179,7 @@ namespace Auxil {
     }
 
     template<std::floating_point T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<char>& str) {
+    T ston(const BasicStrView<char> str) {
         return ston<T>(str, std::chars_format::general);
     }
 
@@ -1145,26 +2190,39 @@ namespace Auxil {
         return false;
     }
 
+    namespace StrDetail {
+        //numbers are ascii, so a wide number is narrowed a character at a time, anything wider than a byte can't
+        //be part of one and becomes a character from_chars rejects
+        inline Vector<char, 64> narrow_number(const BasicStrView<wchar_t> str) {
+            Vector<char, 64> res;
+            res.reserve(str.size());
+            for (const wchar_t c: str) res.push_back(c >= 0 && c < 128 ? static_cast<char>(c) : '?');
+            return res;
+        }
+    }
+
     //wide integers
     template<std::integral T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<wchar_t>& str, int base) {
-        return ston<T>(BasicStr<char>(str), base);
+    T ston(const BasicStrView<wchar_t> str, int base) {
+        const auto narrow = StrDetail::narrow_number(str);
+        return ston<T>(BasicStrView<char>(narrow.data(), narrow.size()), base);
     }
 
     template<std::integral T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<wchar_t>& str) {
-        return ston<T>(BasicStr<char>(str));
+    T ston(const BasicStrView<wchar_t> str) {
+        return ston<T>(str, 10);
     }
 
     //wide floats
     template<std::floating_point T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<wchar_t>& str, std::chars_format fmt) {
-        return ston<T>(BasicStr<char>(str), fmt);
+    T ston(const BasicStrView<wchar_t> str, std::chars_format fmt) {
+        const auto narrow = StrDetail::narrow_number(str);
+        return ston<T>(BasicStrView<char>(narrow.data(), narrow.size()), fmt);
     }
 
     template<std::floating_point T, typename = std::enable_if_t<!std::is_same_v<bool, T>>>
-    T ston(const BasicStr<wchar_t>& str) {
-        return ston<T>(BasicStr<char>(str), std::chars_format::general);
+    T ston(const BasicStrView<wchar_t> str) {
+        return ston<T>(str, std::chars_format::general);
     }
 
     //wide bool
@@ -1175,6 +2233,107 @@ namespace Auxil {
     }
 
 
+    /*
+     * parses every number in text into out, the numbers are separated by any run of the characters in delimiters,
+     * each one is parsed where it lies, integers in base 10 and floats as std::chars_format::general, so a file of
+     * numbers can be read without splitting it or copying a single token, throws if a token isn't a number of T
+     */
+    template<Arithmetic T, usize N>
+    requires (!std::is_same_v<T, bool>)
+    Vector<T, N>& parse_numbers(const BasicStrView<char> text, Vector<T, N>& out,
+                                const BasicStrView<char> delimiters = ", \t\r\n") {
+        std::array<u64, 4> is_delimiter{};
+        for (const char c: delimiters) {
+            const auto u = static_cast<unsigned char>(c);
+            is_delimiter[u >> 6] |= u64{1} << (u & 63);
+        }
+        auto delimiter = [&](const char c) {
+            const auto u = static_cast<unsigned char>(c);
+            return is_delimiter[u >> 6] >> (u & 63) & 1;
+        };
+
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (true) {
+            while (p != end && delimiter(*p)) ++p;
+            if (p == end) break;
+
+            T value{};
+            auto [stop, ec] = StrDetail::parse_number(p, end, value);
+            if (ec != std::errc{} || (stop != end && !delimiter(*stop))) {
+                const char* token_end = stop;
+                while (token_end != end && !delimiter(*token_end)) ++token_end;
+                throw Exception("Invalid number \"{}\" at offset {}", BasicStrView<char>(p, static_cast<usize>(token_end - p)),
+                                static_cast<usize>(p - text.data()));
+            }
+            out.push_back(value);
+            p = stop;
+        }
+
+        return out;
+    }
+
+    //parse_numbers into an Array of exactly as many numbers as text has
+    template<Arithmetic T>
+    requires (!std::is_same_v<T, bool>)
+    Array<T> parse_numbers(const BasicStrView<char> text, const BasicStrView<char> delimiters = ", \t\r\n",
+                           std::pmr::memory_resource* resource = nullptr) {
+        Vector<T, 64> values;
+        parse_numbers(text, values, delimiters);
+        Array<T> res(values.size(), resource);
+        std::copy_n(values.data(), values.size(), res.data());
+        return res;
+    }
+
+    namespace StrDetail {
+        constexpr usize decimal_digits(usize n) {
+            usize digits = 1;
+            while (n >= 10) {
+                n /= 10;
+                digits++;
+            }
+            return digits;
+        }
+    }
+
+    //enough characters for any value of T in its shortest to_chars form, a float takes a sign, max_digits10 digits,
+    //the point, the e and the sign and digits of an exponent as long as the one of its smallest denormal
+    template<Arithmetic T>
+    inline constexpr usize number_chars = [] {
+        using L = std::numeric_limits<T>;
+        if constexpr (std::floating_point<T>) {
+            const auto exponent = static_cast<usize>(std::max(L::max_exponent10, L::max_digits10 - L::min_exponent10));
+            return static_cast<usize>(4 + L::max_digits10) + StrDetail::decimal_digits(exponent);
+        } else {
+            return static_cast<usize>(L::digits10) + 2;
+        }
+    }();
+
+    /*
+     * writes value into out and returns how many characters it took, nothing is allocated, so numbers can be
+     * formatted straight into a caller's buffer, throws if out is too small, number_chars<T> characters always fit
+     */
+    template<Arithmetic T, std::integral CharT>
+    requires (!std::is_same_v<T, bool>)
+    usize write_number(const std::span<CharT> out, const T value) {
+        auto fail = [&] {
+            throw Exception("A buffer of {} characters is too small for the number {}", out.size(), value);
+        };
+        if constexpr (sizeof(CharT) == 1) {
+            auto* first = reinterpret_cast<char*>(out.data());
+            auto [ptr, ec] = std::to_chars(first, first + out.size(), value);
+            if (ec != std::errc{}) fail();
+            return static_cast<usize>(ptr - first);
+        } else {
+            char buffer[number_chars<T>];
+            auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            const auto n = static_cast<usize>(ptr - buffer);
+            if (ec != std::errc{} || n > out.size()) fail();
+            std::copy(buffer, ptr, out.data());
+            return n;
+        }
+    }
+
     //
     // template<std::integral CharT, std::floating_point T>
     // T ston(const BasicStr<CharT>& str, int base = 10) {
@@ -1205,7 +2364,7 @@ namespace Auxil {
 
     template<Arithmetic T, typename CharT, typename>
     BasicStr<CharT> to_str(const T& value) {
-        char buffer[32];
+        char buffer[number_chars<T>];
         auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
         assert(ec == std::errc());
         return BasicStr<CharT>(buffer, ptr);
@@ -1307,9 +2466,20 @@ namespace Auxil {
         return result;
     }
 
+    template<std::integral CharT>
+    template<Arithmetic T>
+    requires (!std::is_same_v<T, bool>)
+    BasicStr<CharT>& BasicStr<CharT>::append_number(const T value) {
+        CharT buffer[number_chars<T>];
+        return append(buffer, write_number(std::span<CharT>(buffer), value));
+    }
+
     template<std::integral CharT>
     template<typename T>
     BasicStr<CharT> &BasicStr<CharT>::append(const T &value) {
+        //floats are formatted on the stack, not into a temporary string
+        if constexpr (std::floating_point<T>) return append_number(value);
+
         BasicStr appendage;
         if constexpr (Stringifieable<T, CharT>) {
             appendage = to_str<CharT>(value);
@@ -1335,8 +2505,605 @@ namespace Auxil {
 
 
 
+    template<std::integral CharT>
+    class BasicAtomTable;
+
+    /*
+     * a handle to a string interned in a BasicAtomTable, atoms from the same table are equal exactly when their
+     * strings are, so == is a pointer compare, and the hash is computed once when the string is interned, neither
+     * reads the characters, the default atom is the empty string, an atom is only valid as long as its table
+     */
+    template<std::integral CharT>
+    class BasicAtom {
+    public:
+        //an interned string, entries are never moved or freed while their table exists
+        struct Entry {
+            usize hash;
+            usize length;
+            const CharT* chars;
+        };
+
+    private:
+        static constexpr CharT empty_string[1]{};
+
+        const Entry* _entry{nullptr};
+
+        explicit BasicAtom(const Entry* entry) noexcept : _entry(entry) {}
+
+        friend class BasicAtomTable<CharT>;
+
+    public:
+        using view_type = BasicStrView<CharT>;
+
+        BasicAtom() noexcept = default;
+
+        //interns s in BasicAtomTable<CharT>::global()
+        explicit BasicAtom(view_type s);
+
+        [[nodiscard]] FORCE_INLINE view_type view() const noexcept {
+            return _entry ? view_type(_entry->chars, _entry->length) : view_type();
+        }
+
+        FORCE_INLINE operator view_type() const noexcept {
+            return view();
+        }
+
+        [[nodiscard]] BasicStr<CharT> str() const {
+            return BasicStr<CharT>(view());
+        }
+
+        //null terminated
+        [[nodiscard]] FORCE_INLINE const CharT* c_str() const noexcept {
+            return _entry ? _entry->chars : empty_string;
+        }
+
+        [[nodiscard]] FORCE_INLINE usize size() const noexcept {
+            return _entry ? _entry->length : 0;
+        }
+
+        [[nodiscard]] FORCE_INLINE bool empty() const noexcept {
+            return !_entry;
+        }
+
+        //the same value std::hash gives the string
+        [[nodiscard]] FORCE_INLINE usize hash() const noexcept {
+            return _entry ? _entry->hash : 0;
+        }
+
+        FORCE_INLINE bool operator==(const BasicAtom& other) const noexcept {
+            return _entry == other._entry;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicAtom& atom) {
+            return os << atom.view();
+        }
+    };
+
+    /*
+     * interns strings as BasicAtoms, the strings are copied into a FrameArena that is only released with the table,
+     * and found through an open addressing table of atomic slots, so once a string has been interned looking it up
+     * again is lock free, only interning a new string takes the lock
+     *
+     * when the slots fill up they are rehashed into a table twice the size and the old one is left in the arena, so
+     * a reader still probing it is never left with freed memory, it just misses strings interned after the move and
+     * retries under the lock
+     */
+    template<std::integral CharT>
+    class BasicAtomTable {
+        using Entry = typename BasicAtom<CharT>::Entry;
+
+        struct Slots {
+            usize capacity;
+            //64 - log2(capacity), for fibonacci hashing
+            u32 shift;
+            std::atomic<const Entry*>* slots;
+        };
+
+        FrameArena _arena;
+        std::atomic<const Slots*> _slots{nullptr};
+        std::atomic<usize> _size{0};
+        std::mutex _mtx;
+
+        //the low bits of the string hash are too regular to index with alone
+        static FORCE_INLINE usize home(const Slots* t, const usize hash) {
+            return static_cast<usize>((static_cast<u64>(hash) * 0x9E3779B97F4A7C15ULL) >> t->shift);
+        }
+
+        static const Entry* probe(const Slots* t, const BasicStrView<CharT> s, const usize hash) {
+            for (usize i = home(t, hash);; i = (i + 1) & (t->capacity - 1)) {
+                const Entry* e = t->slots[i].load(std::memory_order_acquire);
+                if (!e) return nullptr;
+                if (e->hash == hash && e->length == s.size() && StrDetail::equal(e->chars, s.data(), s.size())) return e;
+            }
+        }
+
+        static void place(const Slots* t, const Entry* e) {
+            usize i = home(t, e->hash);
+            while (t->slots[i].load(std::memory_order_relaxed)) i = (i + 1) & (t->capacity - 1);
+            t->slots[i].store(e, std::memory_order_release);
+        }
+
+        //capacity must be a power of two
+        Slots* make_slots(const usize capacity) {
+            auto* slots = static_cast<std::atomic<const Entry*>*>(
+                _arena.allocate(capacity * sizeof(std::atomic<const Entry*>), alignof(std::atomic<const Entry*>)));
+            for (usize i = 0; i < capacity; i++) std::construct_at(slots + i, nullptr);
+
+            auto* t = static_cast<Slots*>(_arena.allocate(sizeof(Slots), alignof(Slots)));
+            return std::construct_at(t, Slots{capacity, static_cast<u32>(64 - std::countr_zero(capacity)), slots});
+        }
+
+        //called with the lock held
+        const Slots* grow(const Slots* old) {
+            Slots* t = make_slots(old->capacity * 2);
+            for (usize i = 0; i < old->capacity; i++) {
+                if (const Entry* e = old->slots[i].load(std::memory_order_relaxed)) place(t, e);
+            }
+            _slots.store(t, std::memory_order_release);
+            return t;
+        }
+
+    public:
+        using atom_type = BasicAtom<CharT>;
+
+        explicit BasicAtomTable(const usize capacity = 1024,
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : _arena(64*1024, upstream) {
+            _slots.store(make_slots(std::bit_ceil(std::max<usize>(capacity, 16))), std::memory_order_release);
+        }
+
+        BasicAtomTable(const BasicAtomTable&) = delete;
+        BasicAtomTable& operator=(const BasicAtomTable&) = delete;
+
+        //the atom for s, interning it if it hasn't been yet
+        atom_type intern(const BasicStrView<CharT> s) {
+            if (s.empty()) return atom_type();
+            const usize hash = StrDetail::hash<false>(s.data(), s.size());
+            if (const Entry* e = probe(_slots.load(std::memory_order_acquire), s, hash)) return atom_type(e);
+
+            std::lock_guard lock(_mtx);
+            const Slots* t = _slots.load(std::memory_order_relaxed);
+            if (const Entry* e = probe(t, s, hash)) return atom_type(e);
+            //kept at most half full so probes stay short
+            if ((_size.load(std::memory_order_relaxed) + 1) * 2 > t->capacity) t = grow(t);
+
+            auto* chars = static_cast<CharT*>(_arena.allocate((s.size() + 1) * sizeof(CharT), alignof(CharT)));
+            std::copy_n(s.data(), s.size(), chars);
+            chars[s.size()] = CharT{};
+            auto* e = static_cast<Entry*>(_arena.allocate(sizeof(Entry), alignof(Entry)));
+            std::construct_at(e, Entry{hash, s.size(), chars});
+
+            place(t, e);
+            _size.fetch_add(1, std::memory_order_relaxed);
+            return atom_type(e);
+        }
+
+        //the atom for s if it has been interned, never locks
+        [[nodiscard]] std::optional<atom_type> find(const BasicStrView<CharT> s) const {
+            if (s.empty()) return atom_type();
+            const usize hash = StrDetail::hash<false>(s.data(), s.size());
+            if (const Entry* e = probe(_slots.load(std::memory_order_acquire), s, hash)) return atom_type(e);
+            return std::nullopt;
+        }
+
+        [[nodiscard]] bool contains(const BasicStrView<CharT> s) const {
+            return find(s).has_value();
+        }
+
+        //how many strings have been interned
+        [[nodiscard]] usize size() const {
+            return _size.load(std::memory_order_relaxed);
+        }
+
+        //the table BasicAtom(view) interns into
+        static BasicAtomTable& global() {
+            static BasicAtomTable table;
+            return table;
+        }
+    };
+
+    template<std::integral CharT>
+    BasicAtom<CharT>::BasicAtom(const view_type s) : BasicAtom(BasicAtomTable<CharT>::global().intern(s)) {}
+
+
+
+    /*
+     * a string for documents that are edited in the middle, the text is kept in chunks of up to chunk_capacity
+     * characters at the nodes of an implicit treap ordered by position, so insert, erase and replace_exactly are
+     * O(log n) plus the size of the edit instead of shifting the whole tail, appending another rope is a merge, and
+     * to_str() flattens it into a BasicStr when one is needed
+     *
+     * edits that fit in the chunk they land in are done in place, anything else splits the treap around the edit
+     * and merges it back together, a null resource is the default one, chunks are allocated one at a time from it
+     */
+    template<std::integral CharT>
+    class BasicRope {
+    public:
+        static constexpr usize chunk_capacity = 1024 / sizeof(CharT);
+
+    private:
+        struct Node {
+            Node* left{nullptr};
+            Node* right{nullptr};
+            //characters in this subtree
+            usize size{0};
+            u32 priority;
+            u32 length{0};
+            CharT chars[chunk_capacity];
+        };
+
+        //every rope gets its own seed, a splitmix64 step of a shared counter, so ropes don't all build their
+        //treaps from the same priority sequence
+        static u64 new_seed() noexcept {
+            static std::atomic<u64> counter{0};
+            u64 z = counter.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ULL + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            //xorshift never leaves 0
+            return (z ^ (z >> 31)) | 1;
+        }
+
+        Node* _root{nullptr};
+        std::pmr::memory_resource* _resource{nullptr};
+        u64 _seed{new_seed()};
+
+        static FORCE_INLINE usize size_of(const Node* t) {
+            return t ? t->size : 0;
+        }
+
+        static FORCE_INLINE void update(Node* t) {
+            t->size = size_of(t->left) + t->length + size_of(t->right);
+        }
+
+        //xorshift, the priorities only need to be independent of the text
+        u32 next_priority() {
+            _seed ^= _seed << 13;
+            _seed ^= _seed >> 7;
+            _seed ^= _seed << 17;
+            return static_cast<u32>(_seed >> 32);
+        }
+
+        Node* make_node(const CharT* s, const usize n) {
+            Node* t = MemoryDetail::allocate<Node>(_resource, 1);
+            //default initialized, the characters past length are never read so they aren't zeroed
+            ::new (static_cast<void*>(t)) Node;
+            t->priority = next_priority();
+            t->length = static_cast<u32>(n);
+            t->size = n;
+            std::copy_n(s, n, t->chars);
+            return t;
+        }
+
+        void destroy(Node* t) {
+            if (!t) return;
+            destroy(t->left);
+            destroy(t->right);
+            MemoryDetail::deallocate(_resource, t, 1);
+        }
+
+        Node* clone(const Node* t) {
+            if (!t) return nullptr;
+            Node* copy = MemoryDetail::allocate<Node>(_resource, 1);
+            ::new (static_cast<void*>(copy)) Node;
+            copy->size = t->size;
+            copy->priority = t->priority;
+            copy->length = t->length;
+            std::copy_n(t->chars, t->length, copy->chars);
+            try {
+                copy->left = clone(t->left);
+                copy->right = clone(t->right);
+            } catch (...) {
+                destroy(copy);
+                throw;
+            }
+            return copy;
+        }
+
+        static Node* merge(Node* a, Node* b) {
+            if (!a) return b;
+            if (!b) return a;
+            if (a->priority > b->priority) {
+                a->right = merge(a->right, b);
+                update(a);
+                return a;
+            }
+            b->left = merge(a, b->left);
+            update(b);
+            return b;
+        }
+
+        //l gets the first pos characters of t and r the rest, a chunk that pos falls inside is split in two
+        void split(Node* t, const usize pos, Node*& l, Node*& r) {
+            if (!t) {
+                l = r = nullptr;
+                return;
+            }
+            const usize left = size_of(t->left);
+            if (pos <= left) {
+                split(t->left, pos, l, t->left);
+                update(t);
+                r = t;
+            } else if (pos >= left + t->length) {
+                split(t->right, pos - left - t->length, t->right, r);
+                update(t);
+                l = t;
+            } else {
+                const usize k = pos - left;
+                Node* tail = make_node(t->chars + k, t->length - k);
+                t->length = static_cast<u32>(k);
+                Node* right = t->right;
+                t->right = nullptr;
+                update(t);
+                l = t;
+                r = merge(tail, right);
+            }
+        }
+
+        //a treap of the characters in s, the chunks are left a quarter empty so later edits can land in them
+        Node* build(const CharT* s, const usize n) {
+            constexpr usize fill = chunk_capacity - chunk_capacity / 4;
+            Node* t = nullptr;
+            for (usize i = 0; i < n; i += fill) t = merge(t, make_node(s + i, std::min(fill, n - i)));
+            return t;
+        }
+
+        //the node holding the character at pos, with pos made relative to it
+        Node* locate(usize& pos) const {
+            Node* t = _root;
+            while (t) {
+                const usize left = size_of(t->left);
+                if (pos < left) {
+                    t = t->left;
+                } else if (pos < left + t->length) {
+                    pos -= left;
+                    return t;
+                } else {
+                    pos -= left + t->length;
+                    t = t->right;
+                }
+            }
+            return nullptr;
+        }
+
+        //adds delta to the size of every node on the path to the character at pos, shrinking wraps around, so a
+        //delta of 0 - n takes n away
+        void resize_path(usize pos, const usize delta) {
+            Node* t = _root;
+            while (t) {
+                t->size += delta;
+                const usize left = size_of(t->left);
+                if (pos < left) {
+                    t = t->left;
+                } else if (pos < left + t->length) {
+                    return;
+                } else {
+                    pos -= left + t->length;
+                    t = t->right;
+                }
+            }
+        }
+
+        template<typename F>
+        static void visit(const Node* t, F& f) {
+            while (t) {
+                visit(t->left, f);
+                f(BasicStrView<CharT>(t->chars, t->length));
+                t = t->right;
+            }
+        }
+
+    public:
+        using view_type = BasicStrView<CharT>;
+        static constexpr usize npos = BasicStr<CharT>::npos;
+
+        BasicRope() noexcept = default;
+
+        explicit BasicRope(std::pmr::memory_resource* resource) noexcept : _resource(resource) {}
+
+        explicit BasicRope(const view_type s, std::pmr::memory_resource* resource = nullptr) : _resource(resource) {
+            _root = build(s.data(), s.size());
+        }
+
+        BasicRope(const BasicRope& other) : _resource(other._resource) {
+            _root = clone(other._root);
+        }
+
+        BasicRope(BasicRope&& other) noexcept : _root(other._root), _resource(other._resource), _seed(other._seed) {
+            other._root = nullptr;
+        }
+
+        BasicRope& operator=(const BasicRope& other) {
+            if (&other == this) return *this;
+            Node* copy = clone(other._root);
+            destroy(_root);
+            _root = copy;
+            return *this;
+        }
+
+        BasicRope& operator=(BasicRope&& other) noexcept {
+            if (&other == this) return *this;
+            destroy(_root);
+            _root = std::exchange(other._root, nullptr);
+            _resource = other._resource;
+            _seed = other._seed;
+            return *this;
+        }
+
+        ~BasicRope() {
+            destroy(_root);
+        }
+
+        //--------- Modifiers -----------
+
+        //inserts s before pos, a pos past the end appends it like BasicStr::insert
+        BasicRope& insert(usize pos, const view_type s) {
+            if (s.empty()) return *this;
+            pos = std::min(pos, size());
+
+            //the character before pos, so appending to a chunk works too
+            usize in_chunk = pos ? pos - 1 : 0;
+            if (Node* t = locate(in_chunk); t && t->length + s.size() <= chunk_capacity) {
+                const usize k = pos ? in_chunk + 1 : 0;
+                std::copy_backward(t->chars + k, t->chars + t->length, t->chars + t->length + s.size());
+                std::copy_n(s.data(), s.size(), t->chars + k);
+                t->length += static_cast<u32>(s.size());
+                resize_path(pos ? pos - 1 : 0, s.size());
+                return *this;
+            }
+
+            Node *l, *r;
+            split(_root, pos, l, r);
+            _root = merge(merge(l, build(s.data(), s.size())), r);
+            return *this;
+        }
+
+        BasicRope& append(const view_type s) {
+            return insert(size(), s);
+        }
+
+        //moves other's chunks onto the end of this rope without copying them when they share a resource
+        BasicRope& append(BasicRope&& other) {
+            if (&other == this) return append(BasicRope(*this));
+            if (MemoryDetail::resolve(_resource) != MemoryDetail::resolve(other._resource)) {
+                other.for_each_chunk([&](const view_type chunk) { append(chunk); });
+                other.clear();
+                return *this;
+            }
+            _root = merge(_root, std::exchange(other._root, nullptr));
+            return *this;
+        }
+
+        BasicRope& operator+=(const view_type s) {
+            return append(s);
+        }
+
+        BasicRope& operator+=(BasicRope&& other) {
+            return append(std::move(other));
+        }
+
+        //erases n characters from pos, n is clamped to the end like BasicStr::erase
+        BasicRope& erase(const usize pos, usize n = npos) {
+            if (pos >= size()) return *this;
+            n = std::min(n, size() - pos);
+            if (n == 0) return *this;
+
+            usize k = pos;
+            if (Node* t = locate(k); k + n < t->length) {
+                std::copy(t->chars + k + n, t->chars + t->length, t->chars + k);
+                t->length -= static_cast<u32>(n);
+                resize_path(pos, 0 - n);
+                return *this;
+            }
+
+            Node *l, *mid, *r;
+            split(_root, pos, l, r);
+            split(r, n, mid, r);
+            destroy(mid);
+            _root = merge(l, r);
+            return *this;
+        }
+
+        //replaces the n characters from pos with s, like BasicStr::replace_exactly
+        BasicRope& replace_exactly(const usize pos, const usize n, const view_type s) {
+            if (pos >= size()) return *this;
+            erase(pos, n);
+            return insert(pos, s);
+        }
+
+        void clear() noexcept {
+            destroy(_root);
+            _root = nullptr;
+        }
+
+        //--------- Access -----------
+
+        [[nodiscard]] FORCE_INLINE usize size() const noexcept {
+            return size_of(_root);
+        }
+
+        [[nodiscard]] FORCE_INLINE usize length() const noexcept {
+            return size();
+        }
+
+        [[nodiscard]] FORCE_INLINE bool empty() const noexcept {
+            return !_root || _root->size == 0;
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* resource() const {
+            return MemoryDetail::resolve(_resource);
+        }
+
+        [[nodiscard]] CharT at(usize ind) const {
+            if (ind >= size()) throw Exception("Cannot access index {} of a rope of {} characters", ind, size());
+            const Node* t = locate(ind);
+            return t->chars[ind];
+        }
+
+        [[nodiscard]] CharT operator[](const usize ind) const {
+            return at(ind);
+        }
+
+        //calls f with a view of each chunk in order, the views are invalidated by the next edit
+        template<typename F>
+        void for_each_chunk(F&& f) const {
+            visit(_root, f);
+        }
+
+        //the n characters from pos
+        [[nodiscard]] BasicStr<CharT> substr(const usize pos, usize n = npos) const {
+            if (pos > size()) throw Exception("Cannot take a substring at {} of a rope of {} characters", pos, size());
+            n = std::min(n, size() - pos);
+
+            BasicStr<CharT> res;
+            res.reserve(n);
+            usize offset = 0;
+            for_each_chunk([&](const view_type chunk) {
+                const usize begin = std::max(offset, pos), end = std::min(offset + chunk.size(), pos + n);
+                if (begin < end) res.append(chunk.substr(begin - offset, end - begin));
+                offset += chunk.size();
+            });
+            return res;
+        }
+
+        //flattens the rope into one string
+        [[nodiscard]] BasicStr<CharT> to_str() const {
+            BasicStr<CharT> res;
+            res.reserve(size());
+            for_each_chunk([&](const view_type chunk) { res.append(chunk); });
+            return res;
+        }
+
+        bool operator==(const view_type s) const {
+            if (s.size() != size()) return false;
+            usize offset = 0;
+            bool equal = true;
+            for_each_chunk([&](const view_type chunk) {
+                equal = equal && StrDetail::equal(chunk.data(), s.data() + offset, chunk.size());
+                offset += chunk.size();
+            });
+            return equal;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicRope& rope) {
+            rope.for_each_chunk([&](const view_type chunk) { os << chunk; });
+            return os;
+        }
+    };
+
+
+
     using str = BasicStr<char>;
     using wstr = BasicStr<wchar_t>;
+    using StrSearcher = BasicStrSearcher<char>;
+    using WStrSearcher = BasicStrSearcher<wchar_t>;
+    using strview = BasicStrView<char>;
+    using wstrview = BasicStrView<wchar_t>;
+    using Atom = BasicAtom<char>;
+    using WAtom = BasicAtom<wchar_t>;
+    using AtomTable = BasicAtomTable<char>;
+    using WAtomTable = BasicAtomTable<wchar_t>;
+    using rope = BasicRope<char>;
+    using wrope = BasicRope<wchar_t>;
     using strmatch = std::match_results<str::iterator>;
     using wstrmatch = std::match_results<wstr::iterator>;
 }
@@ -1395,14 +3162,47 @@ namespace std {
     };
 
 
+    template<std::integral CharT>
+    struct formatter<Auxil::BasicStrView<CharT>, CharT> : formatter<basic_string_view<CharT>, CharT> {
+
+        template<typename ParseContext>
+        auto parse(ParseContext& ctx) {
+            return formatter<basic_string_view<CharT>, CharT>::parse(ctx);
+        }
+
+        template<typename FormatContext>
+        auto format(const Auxil::BasicStrView<CharT>& s, FormatContext& ctx) const {
+            return formatter<basic_string_view<CharT>, CharT>::format(basic_string_view<CharT>(s), ctx);
+        }
+    };
+
+    template<std::integral CharT>
+    struct formatter<Auxil::BasicAtom<CharT>, CharT> : formatter<Auxil::BasicStrView<CharT>, CharT> {
+        template<typename FormatContext>
+        auto format(const Auxil::BasicAtom<CharT>& atom, FormatContext& ctx) const {
+            return formatter<Auxil::BasicStrView<CharT>, CharT>::format(atom.view(), ctx);
+        }
+    };
+
+    //hashes the same as BasicStr, so a view can look up a string key
+    template<std::integral CharT>
+    struct hash<Auxil::BasicStrView<CharT>> {
+        Auxil::usize operator()(const Auxil::BasicStrView<CharT>& s) const noexcept {
+            return Auxil::StrDetail::hash<false>(s.data(), s.length());
+        }
+    };
+
     template<std::integral CharT>
     struct hash<Auxil::BasicStr<CharT>> {
         Auxil::usize operator()(const Auxil::BasicStr<CharT>& s) const noexcept {
-            Auxil::usize h = 0;
-            for (size_t i = 0; i < s.length(); ++i) {
-                h = h * 31 + static_cast<Auxil::usize>(s[i]);
-            }
-            return h;
+            return Auxil::StrDetail::hash<false>(s.c_str(), s.length());
+        }
+    };
+
+    template<std::integral CharT>
+    struct hash<Auxil::BasicAtom<CharT>> {
+        Auxil::usize operator()(const Auxil::BasicAtom<CharT>& atom) const noexcept {
+            return atom.hash();
         }
     };
 }
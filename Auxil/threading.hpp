@@ -2,90 +2,328 @@
 #define THREADING_HPP "Auxil/threading.hpp"
 #include <condition_variable>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 
+#include "exception.hpp"
 #include "misc.hpp"
 namespace Auxil {
     using namespace Primitives;
 
 
 
+    //a move-only, type-erased void() callable, callables that fit in the inline buffer are stored in place so
+    //submitting them doesn't touch the heap, larger ones fall back to a single allocation
+    class Task {
+        static constexpr usize inline_size = 48;
+
+        struct VTable {
+            void (*invoke)(void*);
+            //move constructs dst from src, then destroys src
+            void (*relocate)(void* dst, void* src) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+
+        template<typename F>
+        static constexpr bool stored_inline = sizeof(F) <= inline_size &&
+            alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        static constexpr VTable inline_vtable{
+            [](void* p) { (*static_cast<F*>(p))(); },
+            [](void* dst, void* src) noexcept {
+                ::new (dst) F(std::move(*static_cast<F*>(src)));
+                static_cast<F*>(src)->~F();
+            },
+            [](void* p) noexcept { static_cast<F*>(p)->~F(); }
+        };
+
+        template<typename F>
+        static constexpr VTable heap_vtable{
+            [](void* p) { (**static_cast<F**>(p))(); },
+            [](void* dst, void* src) noexcept {
+                *static_cast<F**>(dst) = *static_cast<F**>(src);
+            },
+            [](void* p) noexcept { delete *static_cast<F**>(p); }
+        };
+
+        alignas(std::max_align_t) std::byte storage[inline_size]{};
+        const VTable* vtable{nullptr};
+
+        void reset() noexcept {
+            if (vtable) vtable->destroy(storage);
+            vtable = nullptr;
+        }
+
+    public:
+        ~Task() {
+            reset();
+        }
+
+        Task() = default;
+        Task(std::nullptr_t) noexcept {}
+
+        template<typename F, typename D = std::decay_t<F>>
+        requires (!std::is_same_v<D, Task> && std::is_invocable_v<D&>)
+        Task(F&& func) {
+            if constexpr (stored_inline<D>) {
+                ::new (static_cast<void*>(storage)) D(std::forward<F>(func));
+                vtable = &inline_vtable<D>;
+            } else {
+                *reinterpret_cast<D**>(storage) = new D(std::forward<F>(func));
+                vtable = &heap_vtable<D>;
+            }
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept : vtable(other.vtable) {
+            if (vtable) vtable->relocate(storage, other.storage);
+            other.vtable = nullptr;
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (&other == this) return *this;
+            reset();
+            vtable = other.vtable;
+            if (vtable) vtable->relocate(storage, other.storage);
+            other.vtable = nullptr;
+
+            return *this;
+        }
+
+        Task& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        //the task can be invoked any number of times
+        void operator()() {
+            vtable->invoke(storage);
+        }
+
+        explicit operator bool() const noexcept {
+            return vtable != nullptr;
+        }
+    };
+
+    //a growable ring buffer of tasks, the slots are reused so a queue that has warmed up never allocates
+    class TaskRing {
+        std::unique_ptr<Task[]> slots{nullptr};
+        usize capacity{0};
+        usize head{0};
+        usize count{0};
+
+        void grow() {
+            const usize new_capacity = capacity ? capacity*2 : 64;
+            auto new_slots = std::make_unique<Task[]>(new_capacity);
+            for (usize i = 0; i < count; i++) {
+                new_slots[i] = std::move(slots[(head + i) & (capacity - 1)]);
+            }
+            slots = std::move(new_slots);
+            capacity = new_capacity;
+            head = 0;
+        }
+    public:
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        }
+
+        [[nodiscard]] usize size() const {
+            return count;
+        }
+
+        void push_back(Task&& task) {
+            if (count == capacity) grow();
+            slots[(head + count) & (capacity - 1)] = std::move(task);
+            count++;
+        }
+
+        Task pop_back() {
+            count--;
+            return std::move(slots[(head + count) & (capacity - 1)]);
+        }
+
+        Task pop_front() {
+            Task res = std::move(slots[head]);
+            head = (head + 1) & (capacity - 1);
+            count--;
+            return res;
+        }
+    };
+
+    enum class ExecutorMode : u8 {
+        //every worker pulls from one shared queue
+        Shared,
+        //every worker owns a deque, tasks submitted from inside a worker stay on that worker
+        //and idle workers steal from the others
+        WorkStealing
+    };
+
     class Executor {
-        std::mutex qmtx;
+        //a queue owned by a worker (or the shared queue), the owner pops from the back, thieves take from the front
+        struct WorkerQueue {
+            std::mutex mtx;
+            TaskRing tasks;
+        };
+
+        //lets a worker know which executor it belongs to, so tasks submitted from inside a task
+        //go to the local queue instead of the shared one
+        struct WorkerContext {
+            const Executor* owner;
+            u32 index;
+        };
+
+        static inline thread_local WorkerContext current_worker{nullptr, 0};
+
+        ExecutorMode _mode{ExecutorMode::Shared};
+
+        //used by Shared mode and by submissions from threads that aren't workers
+        WorkerQueue shared_queue;
+        std::unique_ptr<WorkerQueue[]> local_queues{nullptr};
+        std::atomic_uint32_t next_queue{0};
+        u32 worker_count{0};
+
+        //parking, workers sleep on cv when there's nothing to do instead of spinning
+        std::mutex park_mtx;
         std::condition_variable cv;
+        std::atomic_uint32_t sleeping{0};
+
+        std::mutex wait_mtx;
         std::condition_variable cv_wait;
-        std::atomic_bool running{true};
-        std::atomic_uint32_t active_tasks;
 
-        std::queue<std::move_only_function<void()>> tasks;
+        std::atomic_bool running{true};
+        std::atomic_uint32_t active_tasks{0};
+        //tasks sitting in a queue
+        std::atomic_uint64_t queued{0};
+        //tasks that have been submitted but haven't finished yet
+        std::atomic_uint64_t unfinished{0};
 
         std::vector<std::thread> threads;
 
-        void thread_runner() {
-            //this ensures we finish all the tasks before exiting, that way when a task is
-            //executed its guaranteed to run
-            while (running.load(std::memory_order_acquire) || !tasks.empty()) {
-                std::move_only_function<void()> task;
-                bool has_task{false};
-
-                auto run_task = [&] {
-                    active_tasks.fetch_add(1, std::memory_order::acquire);
-                    task();
-                    active_tasks.fetch_sub(1, std::memory_order::acquire);
-
-                    //notify waiters
-                    cv.notify_one();
-                    cv_wait.notify_one();
-                };
-
-                {
-                    std::lock_guard lk(qmtx);
-                    if (!tasks.empty()) {
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                        has_task = true;
-                    }
-                }
+        static bool pop_back(WorkerQueue& q, Task& task) {
+            std::lock_guard lk(q.mtx);
+            if (q.tasks.empty()) return false;
+            task = q.tasks.pop_back();
+            return true;
+        }
+
+        static bool pop_front(WorkerQueue& q, Task& task) {
+            std::lock_guard lk(q.mtx);
+            if (q.tasks.empty()) return false;
+            task = q.tasks.pop_front();
+            return true;
+        }
+
+        bool find_task(const u32 index, Task& task) {
+            if (queued.load(std::memory_order_acquire) == 0) return false;
+
+            if (_mode == ExecutorMode::Shared) {
+                return pop_front(shared_queue, task);
+            }
+
+            //newest local work first, it's the most likely to still be in cache
+            if (pop_back(local_queues[index], task)) return true;
+            if (pop_front(shared_queue, task)) return true;
+
+            //steal the oldest task from someone else, starting with our neighbour so thieves spread out
+            const u32 n = worker_count;
+            for (u32 i = 1; i < n; i++) {
+                if (pop_front(local_queues[(index + i) % n], task)) return true;
+            }
 
-                if (has_task) {
-                    run_task();
+            return false;
+        }
+
+        void push_task(Task&& task) {
+            WorkerQueue* q = &shared_queue;
+            if (_mode == ExecutorMode::WorkStealing && worker_count > 0) {
+                if (current_worker.owner == this) {
+                    q = &local_queues[current_worker.index];
                 } else {
-                    // tweak iteration count
-                    for (int i = 0; i < 1000; ++i) {
-                        {
-                            std::lock_guard lk(qmtx);
-                            if (!tasks.empty()) {
-                                task = std::move(tasks.front());
-                                tasks.pop();
-                                has_task = true;
-                                break;
-                            }
-                        }
-                        std::this_thread::yield(); // allow other threads to run
-                    }
-                    if (has_task) {
-                        run_task();
-                    }
+                    //spread outside submissions so the workers don't all fight over one lock
+                    q = &local_queues[next_queue.fetch_add(1, std::memory_order_relaxed) % worker_count];
                 }
+            }
+
+            {
+                std::lock_guard lk(q->mtx);
+                q->tasks.push_back(std::move(task));
+                //counted only once the push can't throw anymore, and before the lock is released so no worker can
+                //take the task before it's counted
+                unfinished.fetch_add(1, std::memory_order_relaxed);
+                queued.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            //only touch the park lock when someone is actually asleep, the lock makes sure a worker
+            //that is about to sleep either sees the new task or gets the notification
+            if (sleeping.load(std::memory_order_seq_cst) > 0) {
+                { std::lock_guard lk(park_mtx); }
+                cv.notify_one();
+            }
+        }
 
-                //if there's more tasks, lets just get the next one
-                if (tasks.empty()) {
-                    std::unique_lock lk(qmtx);
-                    cv.wait(lk, [this]{ return !tasks.empty() || !running; });
+        void run_task(Task& task) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            active_tasks.fetch_add(1, std::memory_order_acquire);
+            task();
+            task = nullptr;
+            active_tasks.fetch_sub(1, std::memory_order_release);
+
+            //notify waiters if that was the last one
+            if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard lk(wait_mtx);
+                cv_wait.notify_all();
+            }
+        }
+
+        void thread_runner(const u32 index) {
+            current_worker = {this, index};
+
+            //this ensures we finish all the tasks before exiting, that way when a task is
+            //executed its guaranteed to run
+            Task task;
+            while (true) {
+                if (find_task(index, task)) {
+                    run_task(task);
+                    continue;
                 }
+
+                std::unique_lock lk(park_mtx);
+                sleeping.fetch_add(1, std::memory_order_seq_cst);
+                cv.wait(lk, [this] {
+                    return queued.load(std::memory_order_seq_cst) > 0 || !running.load(std::memory_order_acquire);
+                });
+                sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+                if (!running.load(std::memory_order_acquire) && queued.load(std::memory_order_acquire) == 0) break;
             }
+
+            current_worker = {nullptr, 0};
         }
 
         void init_threads(const u32 n) {
+            worker_count = n;
+            if (_mode == ExecutorMode::WorkStealing && n > 0) {
+                local_queues = std::make_unique<WorkerQueue[]>(n);
+            }
+
             threads.reserve(n);
             for (u32 i = 0; i < n; i++) {
-                threads.emplace_back(&Executor::thread_runner, this);
+                threads.emplace_back(&Executor::thread_runner, this, i);
             }
         }
     public:
+        static constexpr u32 npos = std::numeric_limits<u32>::max();
+
         ~Executor() {
-            running.store(false, std::memory_order_release);
+            {
+                std::lock_guard lk(park_mtx);
+                running.store(false, std::memory_order_release);
+            }
             cv.notify_all();
 
             for (auto& t: threads) {
@@ -95,6 +333,8 @@ namespace Auxil {
 
         Executor() { init_threads(std::thread::hardware_concurrency()); }
         explicit Executor(const u32 n_threads) { init_threads(n_threads); }
+        explicit Executor(const ExecutorMode mode) : _mode(mode) { init_threads(std::thread::hardware_concurrency()); }
+        Executor(const u32 n_threads, const ExecutorMode mode) : _mode(mode) { init_threads(n_threads); }
 
         template<typename F, typename... Args>
         requires Invocable<F, Args...>
@@ -110,21 +350,32 @@ namespace Auxil {
 
             std::future<result_t> fut = task.get_future();
 
+            push_task([task = std::move(task)]() mutable { task(); });
 
-            {
-                std::lock_guard lk(qmtx);
-                tasks.emplace([task = std::move(task)]() mutable { task(); });
-            }
-
-            cv.notify_one();
             return fut;
         }
 
-        //blocks until all tasks are finished
+        //fire-and-forget submission, no future or shared state is created so small callables never allocate
+        //the task should not throw, an exception escaping a posted task terminates the program
+        template<typename F, typename... Args>
+        requires Invocable<F, Args...>
+        void post(F&& func, Args&&... args) {
+            if constexpr (sizeof...(Args) == 0) {
+                push_task(Task(std::forward<F>(func)));
+            } else {
+                push_task(Task(
+                    [func = std::forward<F>(func), ...args = std::forward<Args>(args)]() mutable {
+                        std::invoke(func, args...);
+                    }
+                ));
+            }
+        }
+
+        //blocks until all tasks are finished, calling this from inside a task will deadlock
         void wait() {
-            if (tasks.empty() && !active_tasks.load(std::memory_order::acquire)) return;
-            std::unique_lock lk(qmtx);
-            cv_wait.wait(lk, [this] { return tasks.empty() && active_tasks.load(std::memory_order::acquire) == 0; });
+            if (unfinished.load(std::memory_order_acquire) == 0) return;
+            std::unique_lock lk(wait_mtx);
+            cv_wait.wait(lk, [this] { return unfinished.load(std::memory_order_acquire) == 0; });
         }
 
         //the number of currently active tasks
@@ -136,6 +387,231 @@ namespace Auxil {
         [[nodiscard]] u32 size() const {
             return threads.size();
         }
+
+        [[nodiscard]] ExecutorMode mode() const {
+            return _mode;
+        }
+
+        //the index of the worker running the calling thread, or npos if called from outside this executor
+        [[nodiscard]] u32 worker_index() const {
+            return current_worker.owner == this ? current_worker.index : npos;
+        }
+    };
+
+    //a reusable DAG of tasks, build it once and run it as many times as needed (every frame for example)
+    //a node is posted to the executor the moment its last predecessor finishes, so workers never block
+    //waiting on each other
+    class TaskGraph {
+    public:
+        using Node = u32;
+        static constexpr Node npos = std::numeric_limits<Node>::max();
+    private:
+        struct NodeData {
+            Task task;
+            std::vector<Node> successors{};
+            u32 predecessors{0};
+        };
+
+        std::vector<NodeData> nodes;
+        std::unique_ptr<std::atomic_uint32_t[]> remaining{nullptr};
+        usize remaining_size{0};
+        bool validated{false};
+
+        Executor* executor{nullptr};
+        std::atomic_uint32_t unfinished{0};
+        Task on_complete{};
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool running{false};
+
+        std::atomic_flag failed;
+        std::exception_ptr error{nullptr};
+
+        void check_node(const Node n) const {
+            if (n >= nodes.size()) throw Exception("Node {} does not exist in a TaskGraph with {} nodes", n, nodes.size());
+        }
+
+        void check_idle() {
+            std::lock_guard lk(mtx);
+            if (running) throw Exception("Cannot modify a TaskGraph while it is running");
+        }
+
+        //Kahn's algorithm, if we can't visit every node there's a cycle
+        void validate() {
+            if (validated) return;
+            std::vector<u32> indegree(nodes.size());
+            std::vector<Node> ready;
+            for (Node i = 0; i < nodes.size(); i++) {
+                indegree[i] = nodes[i].predecessors;
+                if (indegree[i] == 0) ready.push_back(i);
+            }
+
+            usize visited = 0;
+            while (!ready.empty()) {
+                const Node n = ready.back();
+                ready.pop_back();
+                visited++;
+                for (const Node s: nodes[n].successors) {
+                    if (--indegree[s] == 0) ready.push_back(s);
+                }
+            }
+
+            if (visited != nodes.size()) throw Exception("TaskGraph contains a dependency cycle");
+            validated = true;
+        }
+
+        void complete() {
+            //run the callback before we signal, once waiters wake up the graph may be destroyed
+            Task callback = std::move(on_complete);
+            if (callback) callback();
+
+            std::lock_guard lk(mtx);
+            running = false;
+            cv.notify_all();
+        }
+
+        void execute(Node n) {
+            while (true) {
+                NodeData& node = nodes[n];
+                if (!failed.test(std::memory_order_relaxed)) {
+                    try {
+                        node.task();
+                    } catch (...) {
+                        if (!failed.test_and_set()) error = std::current_exception();
+                    }
+                }
+
+                //continue with one of the successors on this thread instead of going through the queue
+                Node next = npos;
+                for (const Node s: node.successors) {
+                    if (remaining[s].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        if (next == npos) next = s;
+                        else executor->post([this, s] { execute(s); });
+                    }
+                }
+
+                if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    complete();
+                    return;
+                }
+                if (next == npos) return;
+                n = next;
+            }
+        }
+
+        //the callback is only installed once the run is sure to start, so a failed start leaves on_complete empty
+        void start(Executor& ex, Task callback = {}) {
+            {
+                std::lock_guard lk(mtx);
+                if (running) throw Exception("Cannot run a TaskGraph that is already running");
+                validate();
+                on_complete = std::move(callback);
+                running = true;
+            }
+
+            if (remaining_size != nodes.size()) {
+                remaining = std::make_unique<std::atomic_uint32_t[]>(nodes.size());
+                remaining_size = nodes.size();
+            }
+            for (usize i = 0; i < nodes.size(); i++) {
+                remaining[i].store(nodes[i].predecessors, std::memory_order_relaxed);
+            }
+
+            executor = &ex;
+            error = nullptr;
+            failed.clear();
+            unfinished.store(static_cast<u32>(nodes.size()), std::memory_order_release);
+
+            if (nodes.empty()) {
+                complete();
+                return;
+            }
+
+            for (Node i = 0; i < nodes.size(); i++) {
+                if (nodes[i].predecessors == 0) ex.post([this, i] { execute(i); });
+            }
+        }
+
+    public:
+        ~TaskGraph() {
+            std::unique_lock lk(mtx);
+            cv.wait(lk, [this] { return !running; });
+        }
+
+        TaskGraph() = default;
+
+        //the graph hands out pointers to itself while running, so it stays put
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph(TaskGraph&&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+        TaskGraph& operator=(TaskGraph&&) = delete;
+
+        //adds a node, the task should be callable repeatedly since it runs once per run of the graph
+        template<typename F>
+        requires Invocable<F>
+        Node emplace(F&& func) {
+            check_idle();
+            nodes.push_back({Task(std::forward<F>(func))});
+            validated = false;
+            return static_cast<Node>(nodes.size() - 1);
+        }
+
+        //before has to finish before after can start
+        TaskGraph& precede(const Node before, const Node after) {
+            check_idle();
+            check_node(before);
+            check_node(after);
+            nodes[before].successors.push_back(after);
+            nodes[after].predecessors++;
+            validated = false;
+
+            return *this;
+        }
+
+        //node waits for every one of dependencies
+        TaskGraph& depends_on(const Node node, const std::initializer_list<Node> dependencies) {
+            for (const Node d: dependencies) precede(d, node);
+            return *this;
+        }
+
+        //runs the graph on the executor and blocks until every node has finished, rethrows the first exception
+        //a node threw, once a node throws the remaining nodes are skipped
+        //calling this from a worker of ex blocks that worker, use run_async there instead
+        void run(Executor& ex) {
+            start(ex);
+            wait();
+        }
+
+        //starts the graph and returns immediately, on_complete runs on the worker that finishes the last node
+        template<typename F = void(*)()>
+        requires Invocable<F>
+        void run_async(Executor& ex, F&& on_complete_callback = [] {}) {
+            start(ex, Task(std::forward<F>(on_complete_callback)));
+        }
+
+        //blocks until the current run finishes, rethrows the first exception a node threw
+        void wait() {
+            std::unique_lock lk(mtx);
+            cv.wait(lk, [this] { return !running; });
+            if (error) std::rethrow_exception(error);
+        }
+
+        [[nodiscard]] bool done() {
+            std::lock_guard lk(mtx);
+            return !running;
+        }
+
+        [[nodiscard]] usize size() const {
+            return nodes.size();
+        }
+
+        TaskGraph& clear() {
+            check_idle();
+            nodes.clear();
+            validated = false;
+            return *this;
+        }
     };
 }
 
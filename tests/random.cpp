@@ -0,0 +1,32 @@
+//checks for random.hpp and parallel_fill, build from the repository root with
+//g++ -std=gnu++23 -I. tests/random.cpp -lbacktrace
+#include <cassert>
+#include <vector>
+
+#include "Auxil/parallel.hpp"
+
+using namespace Auxil;
+
+//an integer range that makes lemire's method redraw about a quarter of the time still fills the same with one
+//worker as with many, whatever the grain
+template<typename T>
+static void fill_independent_of_workers(const T min, const T max) {
+    const RandomStreams streams(42);
+    Executor one(1);
+    Executor many(8);
+
+    std::vector<T> serial(100003), parallel(100003), fine(100003);
+    parallel_fill(one, serial, streams, min, max);
+    parallel_fill(many, parallel, streams, min, max);
+    parallel_fill(many, fine, streams, min, max, 6);
+    assert(serial == parallel);
+    assert(serial == fine);
+    for (const T x : serial) assert(x >= min && x <= max);
+}
+
+int main() {
+    fill_independent_of_workers<u32>(0, 0xC0000000u);
+    fill_independent_of_workers<i32>(-0x60000000, 0x60000000);
+    fill_independent_of_workers<u64>(5, 0xC000000000000000ull);
+    fill_independent_of_workers<u8>(0, 190);
+}
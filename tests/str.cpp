@@ -0,0 +1,55 @@
+//checks for str.hpp, build from the repository root with
+//g++ -std=gnu++23 -I. tests/str.cpp -lbacktrace
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#include "Auxil/str.hpp"
+
+using namespace Auxil;
+
+//a moved from string is empty, including what c_str() shows, whether the characters were inline or not
+static void moved_from() {
+    str small = "short";
+    str taken = std::move(small);
+    assert(taken == "short");
+    assert(small.size() == 0);
+    assert(std::strcmp(small.c_str(), "") == 0);
+
+    str large = "long enough that it doesn't fit inline";
+    str taken_large = std::move(large);
+    assert(large.size() == 0);
+    assert(std::strcmp(large.c_str(), "") == 0);
+
+    str assigned = "other";
+    str source = "short";
+    assigned = std::move(source);
+    assert(assigned == "short");
+    assert(source.size() == 0);
+    assert(std::strcmp(source.c_str(), "") == 0);
+
+    wstr wide = L"ab";
+    wstr taken_wide = std::move(wide);
+    assert(taken_wide == L"ab");
+    assert(wide.c_str()[0] == L'\0');
+}
+
+//bytes at or above 128 are negative chars on most platforms, they have to be folded without going through
+//std::tolower as a negative int
+static void ignore_case_high_bytes() {
+    const str latin1 = "caf\xE9 CAF\xC9";
+    const str same = "CAF\xE9 caf\xC9";
+    assert(latin1.equals_ignore_case(same));
+    assert(latin1.hash_ignore_case() == same.hash_ignore_case());
+    assert(!str("\xE9").equals_ignore_case(str("\xC9")));
+    assert(str("a\xFF").compare_ignore_case(str("A\x80")) == std::strong_ordering::greater);
+
+    //and wide characters above 255 don't fit std::tolower at all
+    assert(wstr(L"\u0416a\u00E9").equals_ignore_case(wstr(L"\u0416A\u00E9")));
+    assert(!wstr(L"\u0416").equals_ignore_case(wstr(L"\u0116")));
+}
+
+int main() {
+    moved_from();
+    ignore_case_high_bytes();
+}